@@ -22,12 +22,13 @@ using namespace liblas;
 using namespace std;
 
 typedef boost::shared_ptr<liblas::Writer> WriterPtr;
-typedef boost::shared_ptr<liblas::CoordinateSummary> SummaryPtr;
 
 
 WriterPtr start_writer(   std::ostream*& ofs, 
                       std::string const& output, 
-                      liblas::Header const& header)
+                      liblas::Header const& header,
+                      std::size_t threads,
+                      bool chunk_summaries)
 {
 ofs = liblas::Create(output, std::ios::out | std::ios::binary);
 if (!ofs)
@@ -37,7 +38,11 @@ if (!ofs)
     throw std::runtime_error(oss.str());
 }
 
-WriterPtr writer( new liblas::Writer(*ofs, header));
+// Points are written behind our back while we go on reading
+liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(*ofs, header, threads, chunk_summaries);
+WriterPtr writer( new liblas::Writer(liblas::WriterFactory::CreateAsync(w)));
+writer->SetHeader(header);
+writer->WriteHeader();
 return writer;
 }
 
@@ -49,11 +54,12 @@ bool process(   std::istream& ifs,
                 boost::uint32_t split_mb,
                 boost::uint32_t split_pts,
                 bool verbose,
-                bool min_offset)
+                bool min_offset,
+                std::size_t threads,
+                bool chunk_summaries)
 {
     liblas::ReaderFactory f;
     liblas::Reader reader = f.CreateWithStream(ifs);
-    SummaryPtr summary(new::liblas::CoordinateSummary);
     
     reader.SetFilters(filters);
     reader.SetTransforms(transforms);    
@@ -67,8 +73,6 @@ bool process(   std::istream& ifs,
             header.SetOffset(tree.get<double>("summary.points.minimum.x"),
                              tree.get<double>("summary.points.minimum.y"),
                              tree.get<double>("summary.points.minimum.z"));
-    
-                              
         }
         catch (liblas::property_tree::ptree_bad_path const& e) 
         {
@@ -109,17 +113,32 @@ bool process(   std::istream& ifs,
     }
 
     std::ostream* ofs = NULL;
-    std::string out = output;
     
     WriterPtr writer;
+    boost::shared_ptr<liblas::SplitWriter> splitter;
 
     if (!split_mb && !split_pts) {
-        writer = start_writer(ofs, output, header);
+        writer = start_writer(ofs, output, header, threads, chunk_summaries);
         
     } else {
         string::size_type dot_pos = output.find_first_of(".");
-        out = output.substr(0, dot_pos);
-        writer = start_writer(ofs, out+"-1"+".las", header);
+        std::string const out = output.substr(0, dot_pos);
+
+        // As many points as fit in split_mb megabytes, but at least one
+        boost::uint32_t part_size = split_pts;
+        if (split_mb)
+        {
+            std::size_t const bytes = static_cast<std::size_t>(1024*1024) * split_mb;
+            part_size = static_cast<boost::uint32_t>(
+                (std::max)(bytes / header.GetSchema().GetByteSize(), static_cast<std::size_t>(1)));
+        }
+
+        // Full parts are finished in the background while the 
+        // next ones fill up.
+        splitter = boost::shared_ptr<liblas::SplitWriter>(
+            new liblas::SplitWriter(out, ".las", header, part_size));
+        splitter->SetEncodeThreads(threads);
+        splitter->SetChunkSummaries(chunk_summaries);
     }
 
     if (verbose)
@@ -133,107 +152,61 @@ bool process(   std::istream& ifs,
     boost::uint32_t i = 0;
     boost::uint32_t const size = header.GetPointRecordsCount();
     
-    boost::int32_t split_bytes_count = 1024*1024*split_mb;
-    boost::uint32_t split_points_count = 0;
-    int fileno = 2;
+    // Points only need converting when the output header changes their 
+    // layout, scale or offset (--point-format, --min-offset, ...).  The 
+    // conversion plan is built once per source header.
+    boost::shared_ptr<liblas::SchemaConverter> converter;
+    liblas::Header const* converter_source = 0;
+
+    // Whole blocks of records go from the reader to the writer, or 
+    // to the splitter, which spreads them over the parts.
+    liblas::PointBuffer block;
+    liblas::PointBuffer block_converted(&header, 0);
     
-    
-    while (reader.ReadNextPoint())
+    while (reader.ReadNextPoints(block, 65536) > 0)
     {
-        if (min_offset)
+        if (block.GetHeader() != converter_source)
         {
-            liblas::Point p = reader.GetPoint();
-            summary->AddPoint(p);
-            p.SetHeader(&header);
-            writer->WritePoint(p);
+            converter_source = block.GetHeader();
+            converter = boost::shared_ptr<liblas::SchemaConverter>(
+                new liblas::SchemaConverter(*converter_source, header));
         }
-        else 
-        {
-            liblas::Point const& p = reader.GetPoint();
-            summary->AddPoint(p);
-            writer->WritePoint(p);            
-        }
-        if (verbose)
-            term_progress(std::cout, (i + 1) / static_cast<double>(size));
-        i++;
-        split_points_count++;
-
-        split_bytes_count = split_bytes_count - header.GetSchema().GetByteSize();        
-        if (split_bytes_count < 0 && split_mb > 0 && ! split_pts) {
-            // The user specifies a split size in mb, and we keep counting 
-            // down until we've written that many points into the file.  
-            // After that point, we make a new file and start writing into 
-            // that.  
-
-            // dereference the writer so it is deleted before the ofs
-            writer = WriterPtr();
-            
-            delete ofs;
-            ofs = NULL;
-
-            ostringstream oss;
-            oss << out << "-"<< fileno <<".las";
-
-            writer = start_writer(ofs, oss.str(), header);
-
-            ostringstream old_filename;
-            old_filename << out << "-" << fileno - 1 << ".las";
-
-            liblas::Header hnew = FetchHeader(old_filename.str());
-            RepairHeader(*summary, hnew);
-            RewriteHeader(hnew, old_filename.str());
 
-            summary =  SummaryPtr(new liblas::CoordinateSummary); 
-            fileno++;
-            split_bytes_count = 1024*1024*split_mb;
+        liblas::PointBuffer const* out_block = &block;
+        if (!converter->IsIdentity())
+        {
+            converter->Convert(block, block_converted);
+            out_block = &block_converted;
         }
 
-        if (split_pts > 0 && ! split_mb && split_points_count == split_pts) {
-            // The user specifies a split size in pts, and we keep counting 
-            // down until we've written that many points into the file.  
-            // After that point, we make a new file and start writing into 
-            // that.  
-
-            // dereference the writer so it is deleted before the ofs
-            writer = WriterPtr();
-            
-            delete ofs;
-            ofs = NULL;
-
-            ostringstream oss;
-            oss << out << "-"<< fileno <<".las";
-
-            writer = start_writer(ofs, oss.str(), header);
-
-            ostringstream old_filename;
-            old_filename << out << "-" << fileno - 1 << ".las";
-            
-            liblas::Header hnew = FetchHeader(old_filename.str());
-            RepairHeader(*summary, hnew);
-            RewriteHeader(hnew, old_filename.str());
-
-            summary =  SummaryPtr(new liblas::CoordinateSummary); 
-            fileno++;
-            split_points_count = 0;
-        }
+        if (splitter)
+            splitter->WritePoints(*out_block);
+        else
+            writer->WritePoints(*out_block);
 
+        i += static_cast<boost::uint32_t>(block.size());
+        if (verbose)
+            term_progress(std::cout, i / static_cast<double>(size));
     }
+    
     if (verbose)
         std::cout << std::endl;
 
+    if (splitter)
+    {
+        // Waits for the parts still being written
+        splitter->Close();
+        return true;
+    }
+
+    // Report any error of the background writer before we let go of it
+    writer->Flush();
+
     // cheap hackery.  We need the Writer to disappear before the stream.  
     // Fix this up to not suck so bad.
     writer = WriterPtr();
     delete ofs;
     ofs = NULL;
-        
-    if (!split_mb && !split_pts) {
-        reader.Reset();
-
-        liblas::Header hnew = FetchHeader(output);
-        RepairHeader(*summary, hnew);
-        RewriteHeader(hnew, output);
-    }
 
     return true;
 }
@@ -258,6 +231,8 @@ int main(int argc, char* argv[])
 
     boost::uint32_t split_mb = 0;
     boost::uint32_t split_pts = 0;
+    std::size_t threads = 1;
+    bool bChunkSummaries = false;
     std::string input;
     std::string output;
     std::string output_format;
@@ -289,6 +264,8 @@ int main(int argc, char* argv[])
             ("input,i", po::value< string >(), "input LAS file")
             ("output,o", po::value< string >(&output)->default_value("output.las"), "output LAS file")
             ("compressed,c", po::value<bool>(&bCompressed)->zero_tokens()->implicit_value(true), "Produce .laz compressed data")
+            ("threads", po::value<std::size_t>(&threads)->default_value(1), "Compress .laz output on this many threads")
+            ("chunk-summaries", po::value<bool>(&bChunkSummaries)->zero_tokens()->implicit_value(true), "Store the extent, time range and classes of every .laz chunk, so filtered reads can skip chunks")
             ("verbose,v", po::value<bool>(&verbose)->zero_tokens(), "Verbose message output")
         ;
 
@@ -312,6 +289,12 @@ int main(int argc, char* argv[])
             return 1;
         }
 
+        if (threads == 0) 
+        {
+            std::cerr << "threads must be at least 1." << std::endl; 
+            return 1;
+        }
+
         if (vm.count("input")) 
         {
             input = vm["input"].as< string >();
@@ -377,7 +360,9 @@ int main(int argc, char* argv[])
                             split_mb,
                             split_pts,
                             verbose,
-                            bMinOffset
+                            bMinOffset,
+                            threads,
+                            bChunkSummaries
                             );
         if (!op) {
             return (1);
@@ -38,7 +38,6 @@ namespace po = boost::program_options;
 #endif
 
 typedef boost::shared_ptr<liblas::Writer> WriterPtr;
-typedef boost::shared_ptr<liblas::CoordinateSummary> SummaryPtr;
 typedef boost::shared_ptr<std::ofstream> OStreamPtr;
 
 
@@ -54,7 +53,12 @@ liblas::Writer* start_writer(   std::ostream*& ofs,
         throw std::runtime_error(oss.str());
     }
 
-    return new liblas::Writer(*ofs, header);
+    // Points are written behind our back while we go on reading
+    liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(*ofs, header);
+    liblas::Writer* writer = new liblas::Writer(liblas::WriterFactory::CreateAsync(w));
+    writer->SetHeader(header);
+    writer->WriteHeader();
+    return writer;
 }
 
 using namespace liblas;
@@ -106,7 +110,6 @@ void write_tiles(std::string& output,
             name << ".laz";
         else
             name << ".las";
-        SummaryPtr summary(new::liblas::CoordinateSummary);        
 
         {
             std::ostream* ofs;
@@ -118,30 +121,22 @@ void write_tiles(std::string& output,
 
             std::vector<boost::uint32_t> ids = b.GetIDs();
         
-        
-            for ( boost::uint32_t pi = 0; pi < ids.size(); ++pi )
-            {
-            
-                bool read = reader.ReadPointAt(ids[pi]);
-                if (read) {
-                    liblas::Point const& p = reader.GetPoint();
-                    summary->AddPoint(p);
-                    writer->WritePoint(p);
-                }
-            }
+            liblas::PointBuffer points;
+            if (reader.ReadPointsAt(ids, points))
+                writer->WritePoints(points);
             
+            // The writer fills in the tile's bounds on its way out
             if (writer != 0)
+            {
+                writer->Flush();
                 delete writer;
+            }
             if (ofs != 0)
             {
                 liblas::Cleanup(ofs);
             }
             
         }
-        
-        liblas::Header hnew = FetchHeader(name.str());
-        RepairHeader(*summary, hnew);
-        RewriteHeader(hnew, name.str());
 
         if (verbose)
             term_progress(std::cout, (prog + 1) / static_cast<double>(c.GetBlockCount()));
@@ -212,6 +207,7 @@ int main(int argc, char* argv[])
     bool tiling = false;
     bool bCompressed = false;
     bool bUseStdout = false;
+    boost::uint32_t cache_size = 10000000;
 
     try
     {
@@ -227,6 +223,7 @@ int main(int argc, char* argv[])
             ("stdout", po::value<bool>(&bUseStdout)->zero_tokens()->implicit_value(true), "Output data to stdout")
             ("write-points", po::value<bool>(&tiling)->zero_tokens()->implicit_value(true), "Write .las files for each block instead of an index file")
             ("compressed", po::value<bool>(&bCompressed)->zero_tokens()->implicit_value(true), "Produce .laz compressed data for --write-points tiles")
+            ("cache-size", po::value<boost::uint32_t>(&cache_size)->default_value(10000000), "Number of points to keep in memory while writing --write-points tiles (0 keeps the whole file)")
 
             ("input,i", po::value< std::string >(), "input LAS file")
             ("output,o", po::value< std::string >(&output)->default_value(""), "The output .kdx file (defaults to input filename + .kdx)")
@@ -284,7 +281,10 @@ int main(int argc, char* argv[])
         
         {
             liblas::ReaderFactory f;
-            liblas::Reader reader = f.CreateWithStream(*ifs);
+            // Writing tiles reads the points of each block with 
+            // ReadPointsAt, which the cached reader serves from memory.
+            liblas::Reader reader = tiling ? f.CreateCached(*ifs, cache_size) 
+                                           : f.CreateWithStream(*ifs);
     
             liblas::chipper::Chipper c(&reader, capacity);
 
@@ -0,0 +1,184 @@
+// lasfilter_benchmark.cpp : Compares the cost of filtering a file with a 
+// chain of single purpose filters against one equivalent ExpressionFilter.
+//
+
+#include <liblas/liblas.hpp>
+#include <liblas/detail/timer.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void usage()
+{
+    std::cerr << "usage: lasfilter_benchmark input.las [intensity [minz maxz [passes]]]\n\n"
+              << "Keeps the points with an intensity above the given value (100 by\n"
+              << "default), class 0, 1 or 2 and a z between minz and maxz (the middle\n"
+              << "half of the z range of the file by default), first with a chain of\n"
+              << "ContinuousValueFilter and ClassificationFilter objects and then with\n"
+              << "the same test written as one ExpressionFilter, and reports how long\n"
+              << "each takes.\n";
+}
+
+std::vector<liblas::FilterPtr> MakeChain(boost::uint16_t intensity, double minz, double maxz)
+{
+    std::vector<liblas::FilterPtr> filters;
+
+    typedef liblas::ContinuousValueFilter<boost::uint16_t> intensity_filter;
+    intensity_filter::filter_func fi = &liblas::Point::GetIntensity;
+    filters.push_back(liblas::FilterPtr(new intensity_filter(fi, intensity, std::greater<boost::uint16_t>())));
+
+    std::vector<liblas::Classification> classes;
+    classes.push_back(liblas::Classification(0, false, false, false));
+    classes.push_back(liblas::Classification(1, false, false, false));
+    classes.push_back(liblas::Classification(2, false, false, false));
+    filters.push_back(liblas::FilterPtr(new liblas::ClassificationFilter(classes)));
+
+    typedef liblas::ContinuousValueFilter<double> z_filter;
+    z_filter::filter_func fz = &liblas::Point::GetZ;
+    filters.push_back(liblas::FilterPtr(new z_filter(fz, minz, std::greater_equal<double>())));
+    filters.push_back(liblas::FilterPtr(new z_filter(fz, maxz, std::less_equal<double>())));
+
+    return filters;
+}
+
+std::vector<liblas::FilterPtr> MakeExpression(boost::uint16_t intensity, double minz, double maxz)
+{
+    std::ostringstream expression;
+    expression.precision(15);
+    expression << "intensity > " << intensity 
+               << " && classification in (0, 1, 2)"
+               << " && z between " << minz << " and " << maxz;
+
+    std::vector<liblas::FilterPtr> filters;
+    filters.push_back(liblas::FilterPtr(new liblas::ExpressionFilter(expression.str())));
+    return filters;
+}
+
+// Reads the whole file through the filters, a block at a time when 
+// blocks is set and a point at a time otherwise.  Returns the number of 
+// points kept and the time spent in milliseconds.
+std::size_t Run(liblas::Reader& reader, 
+                std::vector<liblas::FilterPtr> const& filters, 
+                bool blocks, 
+                double& elapsed)
+{
+    reader.SetFilters(filters);
+    reader.Reset();
+
+    liblas::detail::Timer timer;
+    timer.start();
+
+    std::size_t kept = 0;
+    if (blocks)
+    {
+        liblas::PointBuffer buffer;
+        std::size_t n = 0;
+        while ((n = reader.ReadNextPoints(buffer, 65536)) > 0)
+            kept += n;
+    }
+    else
+    {
+        while (reader.ReadNextPoint())
+            ++kept;
+    }
+
+    elapsed = timer.stop();
+    return kept;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream ifs;
+        if (!liblas::Open(ifs, argv[1]))
+        {
+            std::cerr << "Cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+
+        liblas::ReaderFactory factory;
+        liblas::Reader reader = factory.CreateWithStream(ifs);
+        liblas::Header const& header = reader.GetHeader();
+
+        double const range = header.GetMaxZ() - header.GetMinZ();
+        boost::uint16_t intensity = 100;
+        double minz = header.GetMinZ() + range / 4;
+        double maxz = header.GetMaxZ() - range / 4;
+        int passes = 5;
+
+        if (argc > 2)
+            intensity = boost::lexical_cast<boost::uint16_t>(argv[2]);
+        if (argc > 4)
+        {
+            minz = boost::lexical_cast<double>(argv[3]);
+            maxz = boost::lexical_cast<double>(argv[4]);
+        }
+        if (argc > 5)
+            passes = boost::lexical_cast<int>(argv[5]);
+
+        std::vector<liblas::FilterPtr> chain = MakeChain(intensity, minz, maxz);
+        std::vector<liblas::FilterPtr> expression = MakeExpression(intensity, minz, maxz);
+
+        std::cout << "Filtering " << header.GetPointRecordsCount() << " points, "
+                  << "best of " << passes << " passes" << std::endl;
+
+        struct Case
+        {
+            char const* name;
+            std::vector<liblas::FilterPtr> const* filters;
+            bool blocks;
+        };
+
+        Case const cases[] = {
+            { "filter chain, ReadNextPoint      ", &chain, false },
+            { "filter chain, ReadNextPoints     ", &chain, true },
+            { "ExpressionFilter, ReadNextPoint  ", &expression, false },
+            { "ExpressionFilter, ReadNextPoints ", &expression, true }
+        };
+
+        std::size_t expected = 0;
+        for (std::size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+        {
+            double best = 0;
+            std::size_t kept = 0;
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                double elapsed = 0;
+                kept = Run(reader, *cases[c].filters, cases[c].blocks, elapsed);
+                if (0 == pass || elapsed < best)
+                    best = elapsed;
+            }
+
+            if (0 == c)
+                expected = kept;
+
+            std::cout << cases[c].name << best << " ms, " << kept << " points kept";
+            if (kept != expected)
+                std::cout << " (MISMATCH, expected " << expected << ")";
+            std::cout << std::endl;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -67,6 +67,10 @@ void usage(FILE *debugger)
     fprintf(debugger,"  maximum memory to use for index building, defaults to no limit if omitted\n");
     fprintf(debugger,"\n");
     
+    fprintf(debugger,"-p or --threads (optional):\n");
+    fprintf(debugger,"  number of threads sorting points during index building, 0 for one per processor, defaults to 1\n");
+    fprintf(debugger,"\n");
+    
     fprintf(debugger,"-a or --author (optional):\n");
     fprintf(debugger,"  author field for index file record header, 512 max length\n");
     fprintf(debugger,"\n");
@@ -202,6 +206,7 @@ int main(int argc, char* argv[])
     double zbinheight = 0.0;
     double oLowFilterX = 0.0, oHighFilterX = 0.0, oLowFilterY = 0.0, oHighFilterY = 0.0, oLowFilterZ = 0.0, oHighFilterZ = 0.0;
     boost::uint32_t maxmem = 0;
+    boost::uint32_t buildthreads = 1;
     boost::uint32_t chunkSize = 100;
     int debuglevel = 3;
     bool readonly = 0;
@@ -401,6 +406,13 @@ int main(int argc, char* argv[])
             i++;
             maxmem = atoi((const char *)arggv[i]);
         }
+        else if (   strcmp((const char *)arggv[i],"-p") == 0 ||
+                    strcmp((const char *)arggv[i],"--threads") == 0
+            )
+        {
+            i++;
+            buildthreads = atoi((const char *)arggv[i]);
+        }
         else if (   strcmp((const char *)arggv[i],"-a") == 0 ||
                     strcmp((const char *)arggv[i],"--author") == 0
             )
@@ -503,6 +515,7 @@ int main(int argc, char* argv[])
                         if (ParamSrc.SetInitialValues(0, reader, ostrm, idxreader, tmpfilenme, authorname, commentfield, datefield,
                             zbinheight, maxmem, debuglevel, readonly, writestandaloneindex, forcenewindex, debugger))
                         {
+                            ParamSrc.SetBuildThreads(buildthreads);
                             // Another way to initiate an index would be to
                             // create a simple index with Index() and then initialize it with the Prep command.
                             // It would look like this:
@@ -296,34 +296,44 @@ liblas::FilterPtr MakeBoundsFilter(liblas::Bounds<double> const& bounds,
     return liblas::FilterPtr(bounds_filter);
 }
 
+liblas::FilterPtr MakeExpressionFilter(std::string const& dimension,
+                                       std::string const& values, 
+                                       liblas::FilterI::FilterType ftype) 
+{
+    // Turn the --keep-xxx/--drop-xxx forms (200-400, >=200, <100, ...) 
+    // into a single expression on the dimension
+    std::string expression;
+    if (IsDualRangeFilter(values)) {
+        string::size_type dash = values.find_first_of("-");
+        std::string low = values.substr(0,dash);
+        std::string high = values.substr(dash+1, values.size());
+        expression = dimension + " between " + low + " and " + high;
+    } else {
+        expression = dimension + " " + values;
+    }
+
+    typedef liblas::ExpressionFilter filter;
+    filter* expression_filter = new filter(expression);
+    expression_filter->SetType(ftype);
+    return liblas::FilterPtr(expression_filter);
+}
+
 liblas::FilterPtr MakeIntensityFilter(std::string intensities, 
                                       liblas::FilterI::FilterType ftype) 
 {
-    typedef liblas::ContinuousValueFilter<boost::uint16_t> filter;
-    filter::filter_func f = &liblas::Point::GetIntensity;
-    filter* intensity_filter = new filter(f, intensities);
-    intensity_filter->SetType(ftype);
-    return liblas::FilterPtr(intensity_filter);
+    return MakeExpressionFilter("intensity", intensities, ftype);
 }
 
 liblas::FilterPtr MakeTimeFilter(std::string times, 
                                  liblas::FilterI::FilterType ftype) 
 {
-    typedef liblas::ContinuousValueFilter<double> filter;
-    filter::filter_func f = &liblas::Point::GetTime;
-    filter* time_filter = new filter(f, times);
-    time_filter->SetType(ftype);
-    return liblas::FilterPtr(time_filter);
+    return MakeExpressionFilter("time", times, ftype);
 }
 
 liblas::FilterPtr MakeScanAngleFilter(std::string intensities, 
                                       liblas::FilterI::FilterType ftype) 
 {
-    typedef liblas::ContinuousValueFilter<boost::int8_t> filter;
-    filter::filter_func f = &liblas::Point::GetScanAngleRank;
-    filter* intensity_filter = new filter(f, intensities);
-    intensity_filter->SetType(ftype);
-    return liblas::FilterPtr(intensity_filter);
+    return MakeExpressionFilter("scan_angle", intensities, ftype);
 }
 
 liblas::FilterPtr MakeColorFilter(liblas::Color const& low, 
@@ -364,6 +374,7 @@ filtering_options.add_options()
     ("drop-scan-angle", po::value< string >(), "Range in which to drop scan angle.\nThe following expression types are supported:  \n--drop-scan-angle <30 \n--drop-scan-angle >100 \n--drop-scan-angle >=100")
     ("keep-color", po::value< string >(), "Range in which to keep colors.\nDefine colors as two 3-tuples (R,G,B-R,G,B):  \n--keep-color '0,0,0-125,125,125'")
     ("drop-color", po::value< string >(), "Range in which to drop colors.\nDefine colors as two 3-tuples (R,G,B-R,G,B):  \n--drop-color '255,255,255-65536,65536,65536'")
+    ("filter", po::value< string >(), "An expression points must satisfy to be kept. Dimensions are named as in the schema, with spaces written as underscores:  \n--filter \"intensity > 200 && classification in (2,9) && z between 100 and 300\"")
 ;
 return filtering_options;    
 }
@@ -640,22 +651,8 @@ std::vector<liblas::FilterPtr> GetFilters(po::variables_map vm, bool verbose)
         std::string intensities = vm["keep-intensity"].as< string >();
         if (verbose)
             std::cout << "Keeping intensities with values: " << intensities << std::endl;
-        if (IsDualRangeFilter(intensities)) {
-            // We need to make two filters
-            // Given a range 0-200, split the expression into two filters 
-            string::size_type dash = intensities.find_first_of("-");
-            std::string low = intensities.substr(0,dash);
-            std::string high = intensities.substr(dash+1, intensities.size());
-
-            liblas::FilterPtr lt_filter = MakeIntensityFilter(">="+low, liblas::FilterI::eInclusion);
-            filters.push_back(lt_filter);
-            liblas::FilterPtr gt_filter = MakeIntensityFilter("<="+high, liblas::FilterI::eInclusion);
-            filters.push_back(gt_filter);                
-        } else {
-            liblas::FilterPtr intensity_filter = MakeIntensityFilter(intensities, liblas::FilterI::eInclusion);
-            filters.push_back(intensity_filter);
-            
-        }
+        liblas::FilterPtr intensity_filter = MakeIntensityFilter(intensities, liblas::FilterI::eInclusion);
+        filters.push_back(intensity_filter);
     }
     if (vm.count("drop-intensity")) 
     {
@@ -663,34 +660,16 @@ std::vector<liblas::FilterPtr> GetFilters(po::variables_map vm, bool verbose)
         if (verbose)
             std::cout << "Dropping intensities with values: " << intensities << std::endl;
 
-        if (IsDualRangeFilter(intensities)) {
-            throw std::runtime_error("Range filters are not supported for drop-intensity");
-        } else {
-            liblas::FilterPtr intensity_filter = MakeIntensityFilter(intensities, liblas::FilterI::eExclusion);
-            filters.push_back(intensity_filter);   
-        }
+        liblas::FilterPtr intensity_filter = MakeIntensityFilter(intensities, liblas::FilterI::eExclusion);
+        filters.push_back(intensity_filter);
     }
     if (vm.count("keep-scan-angle")) 
     {
         std::string angles = vm["keep-scan-angle"].as< string >();
         if (verbose)
             std::cout << "Keeping scan angles with values: " << angles << std::endl;
-        if (IsDualRangeFilter(angles)) {
-            // We need to make two filters
-            // Given a range 0-200, split the expression into two filters 
-            string::size_type dash = angles.find_first_of("-");
-            std::string low = angles.substr(0,dash);
-            std::string high = angles.substr(dash+1, angles.size());
-
-            liblas::FilterPtr lt_filter = MakeScanAngleFilter(">="+low, liblas::FilterI::eInclusion);
-            filters.push_back(lt_filter);
-            liblas::FilterPtr gt_filter = MakeScanAngleFilter("<="+high, liblas::FilterI::eInclusion);
-            filters.push_back(gt_filter);                
-        } else {
-            liblas::FilterPtr angle_filter = MakeScanAngleFilter(angles, liblas::FilterI::eInclusion);
-            filters.push_back(angle_filter);
-            
-        }
+        liblas::FilterPtr angle_filter = MakeScanAngleFilter(angles, liblas::FilterI::eInclusion);
+        filters.push_back(angle_filter);
     }
     if (vm.count("drop-scan-angle")) 
     {
@@ -698,12 +677,8 @@ std::vector<liblas::FilterPtr> GetFilters(po::variables_map vm, bool verbose)
         if (verbose)
             std::cout << "Dropping scan angles with values: " << angles << std::endl;
 
-        if (IsDualRangeFilter(angles)) {
-            throw std::runtime_error("Range filters are not supported for drop-scan-angle");
-        } else {
-            liblas::FilterPtr angle_filter = MakeScanAngleFilter(angles, liblas::FilterI::eExclusion);
-            filters.push_back(angle_filter);   
-        }
+        liblas::FilterPtr angle_filter = MakeScanAngleFilter(angles, liblas::FilterI::eExclusion);
+        filters.push_back(angle_filter);
     }
     
     if (vm.count("keep-time")) 
@@ -711,35 +686,27 @@ std::vector<liblas::FilterPtr> GetFilters(po::variables_map vm, bool verbose)
         std::string times = vm["keep-time"].as< string >();
         if (verbose)
             std::cout << "Keeping times with values: " << times << std::endl;
-        if (IsDualRangeFilter(times)) {
-            // We need to make two filters
-            // Given a range 0-200, split the expression into two filters 
-            string::size_type dash = times.find_first_of("-");
-            std::string low = times.substr(0,dash);
-            std::string high = times.substr(dash+1, times.size());
-
-            liblas::FilterPtr lt_filter = MakeTimeFilter(">="+low, liblas::FilterI::eInclusion);
-            filters.push_back(lt_filter);
-            liblas::FilterPtr gt_filter = MakeTimeFilter("<="+high, liblas::FilterI::eInclusion);
-            filters.push_back(gt_filter);                
-        } else {
-            liblas::FilterPtr time_filter = MakeTimeFilter(times, liblas::FilterI::eInclusion);
-            filters.push_back(time_filter);
-            
-        }
+        liblas::FilterPtr time_filter = MakeTimeFilter(times, liblas::FilterI::eInclusion);
+        filters.push_back(time_filter);
     }
     if (vm.count("drop-time")) 
     {
         std::string times = vm["drop-time"].as< string >();
         if (verbose)
             std::cout << "Dropping times with values: " << times << std::endl;
-            
-        if (IsDualRangeFilter(times)) {
-            throw std::runtime_error("Range filters are not supported for drop-time");
-        } else {
-            liblas::FilterPtr time_filter = MakeTimeFilter(times, liblas::FilterI::eExclusion);
-            filters.push_back(time_filter);   
-        }
+
+        liblas::FilterPtr time_filter = MakeTimeFilter(times, liblas::FilterI::eExclusion);
+        filters.push_back(time_filter);
+    }
+
+    if (vm.count("filter")) 
+    {
+        std::string expression = vm["filter"].as< string >();
+        if (verbose)
+            std::cout << "Keeping points matching: " << expression << std::endl;
+
+        liblas::FilterPtr expression_filter(new liblas::ExpressionFilter(expression));
+        filters.push_back(expression_filter);
     }
 
     if (vm.count("keep-color")) 
@@ -364,11 +364,16 @@ int main(int argc, char* argv[])
     
     // std::cout << "stream position is: " << istrm->tellg() << std::endl;
     liblas::Header header = CreateHeader(hdr, verbose);
-    liblas::Writer writer(ostrm, header);
+    // Points are written behind our back while we go on reading
+    liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ostrm, header);
+    liblas::Writer writer(liblas::WriterFactory::CreateAsync(w));
+    writer.SetHeader(header);
+    writer.WriteHeader();
     
     writer.SetFilters(filters);
     
     success = WritePoints(writer, istrm, hdr, verbose);
+    writer.Flush();
 
     if (verbose)
     {
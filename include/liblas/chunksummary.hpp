@@ -0,0 +1,92 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Ranges of values found in a run of point records
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_CHUNKSUMMARY_HPP_INCLUDED
+#define LIBLAS_CHUNKSUMMARY_HPP_INCLUDED
+
+#include <liblas/export.hpp>
+// boost
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+// std
+#include <bitset>
+
+namespace liblas {
+
+/// Ranges of the values found in a run of point records, such as one 
+/// compressed chunk of a LAZ file.  Readers hand summaries to 
+/// FilterI::filter_summary to find out whether a run can be skipped 
+/// without decoding it.  Coordinates are raw record integers; apply 
+/// the scale and offset of the header to get real world ones.
+struct LAS_DLL ChunkSummary
+{
+    ChunkSummary();
+
+    /// Widens the ranges to take in the record at \a data, laid out as 
+    /// a point format 0-3 record.  \a has_time tells whether the record 
+    /// carries a GPS time.
+    void Add(boost::uint8_t const* data, bool has_time);
+
+    /// Widens the ranges to take in those of \a other.
+    void Merge(ChunkSummary const& other);
+
+    bool empty() const { return 0 == count; }
+
+    /// Number of records summarized
+    boost::uint32_t count;
+
+    boost::array<boost::int32_t, 3> min;
+    boost::array<boost::int32_t, 3> max;
+
+    /// Whether min_time and max_time hold the GPS time range
+    bool has_time;
+    double min_time;
+    double max_time;
+
+    /// Bit b is set if some record has b as its whole classification 
+    /// byte, flags included.
+    std::bitset<256> classifications;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_CHUNKSUMMARY_HPP_INCLUDED
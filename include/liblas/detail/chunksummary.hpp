@@ -0,0 +1,101 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Storage of chunk summaries in LAZ files
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_CHUNKSUMMARY_HPP_INCLUDED
+#define LIBLAS_DETAIL_CHUNKSUMMARY_HPP_INCLUDED
+
+#include <liblas/chunksummary.hpp>
+#include <liblas/variablerecord.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace liblas { namespace detail { 
+
+/// The chunk summaries of a LAZ file are written after the LASzip chunk 
+/// table, once all points are known.  A "liblas" VLR written with the 
+/// header says where to find them:
+///
+///   uint16 version, uint16 reserved, uint32 points per chunk, 
+///   uint32 number of summaries, uint64 file offset of the summaries
+///
+/// The count and offset are zero until the file is closed.
+struct ChunkSummaryLocation
+{
+    ChunkSummaryLocation()
+        : chunk_size(0)
+        , count(0)
+        , offset(0)
+    {}
+
+    boost::uint32_t chunk_size;
+    boost::uint32_t count;
+    boost::uint64_t offset;
+};
+
+boost::uint16_t const chunk_summary_record_id = 2114;
+
+/// Number of bytes ahead of the count in the payload of the VLR
+std::size_t const chunk_summary_count_position = 8;
+
+/// Size of one stored summary
+std::size_t const chunk_summary_record_size = 80;
+
+bool IsChunkSummaryVLR(VariableRecord const& vlr);
+VariableRecord MakeChunkSummaryVLR(ChunkSummaryLocation const& location);
+
+/// Reads the location out of \a vlr.  Returns false if \a vlr is not a 
+/// chunk summary VLR this version understands.
+bool ReadChunkSummaryVLR(VariableRecord const& vlr, ChunkSummaryLocation& location);
+
+void WriteChunkSummaries(std::ostream& ofs, std::vector<ChunkSummary> const& summaries);
+
+/// Reads \a count summaries from the current position of \a ifs.  
+/// Returns false if the stream ends first.
+bool ReadChunkSummaries(std::istream& ifs, std::size_t count, std::vector<ChunkSummary>& summaries);
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_CHUNKSUMMARY_HPP_INCLUDED
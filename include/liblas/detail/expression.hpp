@@ -0,0 +1,220 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Filter expression parser and batch evaluator
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_DETAIL_EXPRESSION_HPP_INCLUDED
+#define LIBLAS_DETAIL_EXPRESSION_HPP_INCLUDED
+
+#include <liblas/chunksummary.hpp>
+#include <liblas/dimension.hpp>
+#include <liblas/dimensionaccessor.hpp>
+#include <liblas/filter.hpp>
+#include <liblas/header.hpp>
+#include <liblas/pointbuffer.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace liblas { namespace detail { namespace expression {
+
+/// Comparisons a field can be tested with.
+enum CompareOp
+{
+    eLess,
+    eLessEqual,
+    eGreater,
+    eGreaterEqual,
+    eEqual,
+    eNotEqual,
+    eBetween, ///< values[0] <= field <= values[1]
+    eIn       ///< field equal to any of values
+};
+
+/// Node of a parsed expression.  Comparisons of a field against 
+/// numeric constants are the leaves and always yield a boolean, the 
+/// inner nodes combine booleans.
+struct Node
+{
+    enum Kind
+    {
+        eCompare,
+        eAnd,
+        eOr,
+        eNot
+    };
+
+    Node(Kind k) : kind(k), op(eEqual) {}
+
+    Kind kind;
+
+    // eCompare
+    std::string field;
+    CompareOp op;
+    std::vector<double> values;
+
+    // eAnd and eOr use both, eNot only left
+    boost::shared_ptr<Node> left;
+    boost::shared_ptr<Node> right;
+};
+
+typedef boost::shared_ptr<Node> NodePtr;
+
+/// Parses text into an expression tree.  The grammar is
+///
+///   expr    := term ( ('||' | 'or') term )*
+///   term    := factor ( ('&&' | 'and') factor )*
+///   factor  := ('!' | 'not') factor | '(' expr ')' | test
+///   test    := field op number
+///            | field ['not'] 'between' number 'and' number
+///            | field ['not'] 'in' '(' number (',' number)* ')'
+///   op      := '<' | '<=' | '>' | '>=' | '==' | '=' | '!='
+///
+/// Keywords and field names are case insensitive.  Throws 
+/// liblas::invalid_expression if text does not follow the grammar.
+NodePtr Parse(std::string const& text);
+
+/// Flat instruction of a compiled expression.  Instructions run on a 
+/// stack of selection masks: eTest pushes the result of comparing one 
+/// field of every point, the others pop their operands and push the 
+/// combined mask.
+struct Instruction
+{
+    enum OpCode
+    {
+        eTest,
+        eAnd,
+        eOr,
+        eNot
+    };
+
+    OpCode code;
+    std::size_t field; ///< index into Program::GetFields()
+    CompareOp op;
+    std::vector<double> values;
+};
+
+/// The dimension a field reads in the records of one header, and the 
+/// scaling applied to its values.
+struct FieldLayout
+{
+    FieldLayout(Dimension const& d)
+        : dimension(d)
+        , scale(1.0)
+        , offset(0.0)
+    {}
+
+    Dimension dimension;
+    double scale;
+    double offset;
+};
+
+/// Looks up the dimension called name in the schema of header.  Names 
+/// are matched ignoring case with spaces replaced by underscores, so 
+/// "return_number" finds the "Return Number" dimension.  Throws 
+/// liblas::invalid_expression for unknown dimensions or ones that 
+/// cannot be compared as numbers.
+FieldLayout GetFieldLayout(liblas::Header const& header, std::string const& name);
+
+/// An expression compiled to instructions that read the raw record 
+/// bytes directly.  Field offsets come from the Schema of the header 
+/// of the points being evaluated and are looked up again whenever 
+/// that header changes.
+class Program
+{
+public:
+
+    Program(std::string const& text);
+
+    std::string const& GetText() const { return m_text; }
+    std::vector<std::string> const& GetFields() const { return m_fields; }
+    std::vector<Instruction> const& GetInstructions() const { return m_code; }
+
+    /// Sets mask[i] to 1 for every point of points the expression holds 
+    /// for and to 0 otherwise.  Returns the number of matching points.
+    std::size_t Evaluate(liblas::PointSpan const& points, liblas::SelectionMask& mask);
+
+    /// Works out from the ranges in summary whether the expression can 
+    /// hold and whether it can fail for some of the points summarized.  
+    /// Comparisons of fields the summary has no range for can do both.
+    void EvaluateSummary(liblas::Header const* header, 
+                         liblas::ChunkSummary const& summary,
+                         bool& can_hold, 
+                         bool& can_fail);
+
+private:
+
+    bool GetRange(std::size_t field, liblas::ChunkSummary const& summary, double& lo, double& hi) const;
+
+    void Compile(Node const& node, std::size_t depth);
+    void Bind(liblas::Header const* header);
+    bool IsBound(liblas::Header const* header) const;
+    std::vector<double> const& LoadColumn(std::size_t field, 
+                                          boost::uint8_t const* data,
+                                          std::size_t count);
+
+    std::string m_text;
+    std::vector<std::string> m_fields;
+    std::vector<Instruction> m_code;
+    std::size_t m_stack_depth;
+
+    // The header last bound, along with what the field layouts depend 
+    // on.  The header may have been changed since, or freed and another 
+    // one allocated in its place, so the address alone is not enough.
+    liblas::Header const* m_header;
+    liblas::PointFormatName m_format;
+    boost::uint16_t m_record_length;
+    double m_scale[3];
+    double m_offset[3];
+    std::vector<FieldLayout> m_layout;
+    std::vector< liblas::DimensionAccessor<double> > m_accessors;
+
+    // per chunk scratch space
+    std::vector< std::vector<double> > m_columns;
+    std::vector<bool> m_loaded;
+    std::vector<liblas::SelectionMask> m_stack;
+};
+
+}}} // namespace liblas::detail::expression
+
+#endif // LIBLAS_DETAIL_EXPRESSION_HPP_INCLUDED
@@ -53,6 +53,9 @@ class Color;
 class FilterI;
 class Header;
 class Point;
+class PointBuffer;
+class PointSpan;
+class PointTable;
 class PointFormat;
 class Reader;
 class ReaderI;
@@ -79,6 +82,10 @@ class WriterImpl;
 struct PointRecord;
 struct Color;
 
+namespace expression {
+class Program;
+} // namespace expression
+
 }} // namespace liblas::detail
 
 #endif // LIBLAS_DETAIL_FWD_HPP_INCLUDED
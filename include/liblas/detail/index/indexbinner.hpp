@@ -0,0 +1,101 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  index point binning implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_INDEXBINNER_HPP_INCLUDED
+#define LIBLAS_DETAIL_INDEXBINNER_HPP_INCLUDED
+
+#include <liblas/index.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/detail/index/indexcell.hpp>
+
+// std
+#include <cstdio>	// file io
+#include <string>
+
+namespace liblas { namespace detail {
+
+// IndexBinner sorts one thread's share of the points into the cell matrix while an Index is built.
+// Each binner has its own copy of the cell matrix and its own temp file, so binners can run concurrently.
+// When its records exceed its share of the memory allowance they are offloaded to its temp file, from 
+// which they are reloaded one cell at a time after all points have been binned.
+class IndexBinner
+{
+friend class liblas::Index;
+public:
+    IndexBinner(liblas::Index *indexsource, std::string const& tempfilename, boost::uint32_t maxpointsinmemory);
+    ~IndexBinner();
+
+private:
+    liblas::Index *m_index;
+    IndexCellDataBlock m_cellBlock;
+    std::string m_tempFileName;
+    FILE *m_tempFile;
+    TempFileOffsetType m_tempFileWrittenBytes;
+    boost::uint32_t m_pointsInMemory, m_maxPointsInMemory;
+    boost::uint32_t m_lastCellX, m_lastCellY, m_lastPointID, m_nextPointID;
+    bool m_tempFileStarted, m_failed, m_outOfMemory;
+
+    // Blocked copying operations, declared but not defined.
+    IndexBinner(IndexBinner const& other);
+    IndexBinner& operator=(IndexBinner const& rhs);
+
+protected:
+    // Bins the points of Points, the first of which has the ID FirstPointID. Failures are recorded, not thrown, 
+    // so that this can be run as the body of a thread
+    void BinPoints(PointSpan const& Points, boost::uint32_t FirstPointID);
+    // Offloads binned cell data to the temp file
+    bool PurgePointsToTempFile(void);
+    // Adds the records this binner holds for one cell to CellBlock, whether in memory or in the temp file
+    bool LoadCellFromTempFile(IndexCell *CellBlock, boost::uint32_t CurCellX, boost::uint32_t CurCellY);
+    // Releases the cell matrix once every record has been offloaded to the temp file
+    void ReleaseCells(void);
+    FILE *OpenTempFile(void);
+    void CloseTempFile(void);
+    bool Failed(void) const	{return m_failed;}
+    bool OutOfMemory(void) const	{return m_outOfMemory;}
+    IndexCell const& GetCell(boost::uint32_t x, boost::uint32_t y) const	{return m_cellBlock[x][y];}
+    
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_INDEXBINNER_HPP_INCLUDED
@@ -358,9 +358,9 @@ inline void read_n<std::string>(std::string& dest, std::istream& src, std::strea
 }
 
 // adapted from http://www.cplusplus.com/forum/beginner/3076/
-template <typename IntegerType>
+template <typename IntegerType, typename Data>
 inline IntegerType bitsToInt(IntegerType& output,
-                             std::vector<boost::uint8_t> const& data, 
+                             Data const& data, 
                              std::size_t index)
 {
     binary::endian_value<IntegerType> value;
@@ -369,9 +369,9 @@ inline IntegerType bitsToInt(IntegerType& output,
     return output;
 }
 
-template <typename IntegerType>
+template <typename IntegerType, typename Data>
 inline void intToBits(IntegerType input, 
-                      std::vector<boost::uint8_t>& data, 
+                      Data& data, 
                       std::size_t index)
 {
     binary::endian_value<IntegerType> value(input);
@@ -43,26 +43,58 @@
 #define LIBLAS_DETAIL_CACHEDREADERIMPL_HPP_INCLUDED
 
 #include <liblas/detail/fwd.hpp>
-#include <liblas/detail/reader/header.hpp>
 #include <liblas/liblas.hpp>
+#include <liblas/sharedpagecache.hpp>
 // boost
 #include <boost/cstdint.hpp>
-// std
-#include <iosfwd>
 #include <boost/shared_ptr.hpp>
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace liblas { namespace detail { 
 
-
-class CachedReaderImpl : public ReaderImpl
+/// Wraps another reader and keeps the records it reads in pages of 
+/// \a page_size points, so that points read again -- sequentially after 
+/// a Reset or at random with ReadPointAt -- come out of memory.  Pages 
+/// are evicted least recently used first once they take up more than 
+/// \a budget bytes (0 means no limit).  Any reader can be wrapped, 
+/// including compressed ones, because pages are filled with Seek and 
+/// ReadNextPoints.
+///
+/// The pages can also go into a SharedPageCache, where readers of the 
+/// same file, on the same or other threads, reuse each other's pages.
+///
+/// Pages hold the records as stored in the file.  Filters and transforms 
+/// are applied as points are handed out, so changing them does not 
+/// throw the cache away.
+class CachedReaderImpl : public ReaderI
 {
 public:
 
-    CachedReaderImpl(std::istream& ifs, std::size_t cache_size);
+    // Number of points per page used by ReaderFactory::CreateCached.
+    static const std::size_t default_page_size = 65536;
+
+    /// Reader with a cache of its own.
+    CachedReaderImpl(ReaderIPtr reader, std::size_t page_size, std::size_t budget);
 
+    /// Reader that keeps its pages in \a cache under \a identity, 
+    /// usually the file name.  The point count, record length and data 
+    /// offset from the header are added to the identity, so a file that 
+    /// was rewritten with a different layout does not pick up stale 
+    /// pages.  All readers sharing pages must use the same page size.
+    CachedReaderImpl(ReaderIPtr reader, std::size_t page_size, 
+                     SharedPageCache& cache, std::string const& identity);
+
+    liblas::Header const& GetHeader() const;
     void ReadHeader();
+    void SetHeader(liblas::Header const& header);
+    liblas::Point const& GetPoint() const { return m_point; }
     void ReadNextPoint();
+    std::size_t ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n);
     liblas::Point const& ReadPointAt(std::size_t n);
+    void ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap);
 
     void Seek(std::size_t n);
     void Reset();
@@ -72,28 +104,59 @@ public:
     void SetTransforms(std::vector<liblas::TransformPtr> const& transforms);
     std::vector<liblas::TransformPtr> GetTransforms() const;
 
-protected:
+    std::size_t GetPageSize() const { return m_page_size; }
+
+    /// Counters of the cache the pages are kept in.  For a shared cache 
+    /// these cover every reader using it.
+    SharedPageCache::Stats GetStats() const { return m_cache->GetStats(); }
 
 private:
 
     // Blocked copying operations, declared but not defined.
     CachedReaderImpl(CachedReaderImpl const& other);
     CachedReaderImpl& operator=(CachedReaderImpl const& rhs);
-    void ReadCachedPoint(boost::uint32_t position);
-    
-    void CacheData(boost::uint32_t position);
-    void ReadNextUncachedPoint();
-    
-    typedef std::vector<boost::uint8_t> cache_mask_type;
-
-    cache_mask_type m_mask;
-    cache_mask_type::size_type m_cache_size;    
-    cache_mask_type::size_type m_cache_start_position;
-    cache_mask_type::size_type m_cache_read_position;
-
-    typedef std::vector<liblas::Point> cache_type;
-    cache_type m_cache;
-    bool m_cache_initialized;
+
+    void Check() const;
+    void SetLayout(liblas::Header const& header);
+    SharedPageCache::PagePtr const& GetPage(std::size_t page);
+    void ReadRecord(std::size_t n);
+    std::size_t CopyRecords(liblas::PointBuffer& buffer, std::size_t n);
+    bool CopyBlock();
+    void TransformPoint(liblas::Point& p);
+    void CheckPosition(std::size_t n, char const* caller) const;
+
+    ReaderIPtr m_reader;
+    std::size_t m_page_size;
+
+    boost::shared_ptr<SharedPageCache> m_owned_cache;
+    SharedPageCache* m_cache;
+    std::string m_identity;
+    boost::uint64_t m_file;
+
+    // The page last used, which saves a cache lookup for every point 
+    // read from it.
+    SharedPageCache::PagePtr m_page;
+    std::size_t m_page_number;
+
+    // Layout the cached pages were read with.
+    std::size_t m_record_length;
+    std::size_t m_size;
+    std::size_t m_position;
+
+    liblas::Point m_point;
+
+    std::vector<liblas::FilterPtr> m_filters;
+    std::vector<liblas::TransformPtr> m_transforms;
+
+    // Filtered points read ahead by ReadNextPoint and not handed out 
+    // yet, with the index of each in the file
+    liblas::PointBuffer m_block;
+    std::vector<boost::uint32_t> m_block_ids;
+    std::size_t m_block_position;
+
+    // Index of the record after the last one handed out, where reading 
+    // starts over when the filters change
+    std::size_t m_next_index;
 };
 
 
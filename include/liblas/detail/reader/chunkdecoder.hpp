@@ -0,0 +1,179 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Parallel LASzip chunk decoder
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_CHUNKDECODER_HPP_INCLUDED
+#define LIBLAS_DETAIL_CHUNKDECODER_HPP_INCLUDED
+
+#include <liblas/header.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/detail/fwd.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+// std
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace liblas { namespace detail { 
+
+/// Stream buffer reading from a stream that other SharedStreamBuffers 
+/// read from too.  Every buffer keeps its own position and only takes 
+/// the lock to refill, so several threads can each read their own part 
+/// of one file through the single std::istream they were given.
+class SharedStreamBuffer : public std::streambuf
+{
+public:
+
+    SharedStreamBuffer(std::istream& source, boost::mutex& mutex, std::size_t size = 65536);
+
+protected:
+
+    int_type underflow();
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    SharedStreamBuffer(SharedStreamBuffer const& other);
+    SharedStreamBuffer& operator=(SharedStreamBuffer const& rhs);
+
+    std::istream& m_source;
+    boost::mutex& m_mutex;
+    std::vector<char> m_buffer;
+
+    // Offset in the source of the first byte of m_buffer
+    std::streamoff m_offset;
+};
+
+/// Decompresses a chunked LASzip file on a pool of threads, a whole 
+/// chunk at a time, and hands the records out in file order.  Every 
+/// thread has its own unzipper, opened on its own view of the stream, 
+/// so the chunks are decoded independently.  Decoded chunks wait in a 
+/// reorder buffer that holds at most \a window chunks past the one 
+/// being read, which bounds memory use when the caller is slower than 
+/// the threads.
+///
+/// The decoder owns the stream while it is running: nobody else may use 
+/// it between the first Read and Stop.
+class ChunkDecoder
+{
+public:
+
+    /// Decoder for the points of the file \a header belongs to.  
+    /// A \a window of 0 picks twice the number of threads.
+    /// @exception configuration_error if \a threads is 0 or the file 
+    /// is not chunked.
+    ChunkDecoder(std::istream& ifs, liblas::Header const& header, 
+                 std::size_t threads, std::size_t window = 0);
+    ~ChunkDecoder();
+
+    std::size_t GetThreadCount() const { return m_threads; }
+    std::size_t GetChunkSize() const { return m_chunk_size; }
+
+    /// Makes point \a n the next one Read returns.  Chunks decoded so far 
+    /// are thrown away.
+    void Start(std::size_t n);
+
+    /// Appends up to \a n of the next records to \a buffer, which must 
+    /// have the layout of the file's header, and returns how many were 
+    /// appended.  0 means the last point was read.
+    /// @exception liblas_error if a chunk cannot be decoded.
+    std::size_t Read(liblas::PointBuffer& buffer, std::size_t n);
+
+    /// Joins the threads.  The next Read starts them again, carrying on 
+    /// where reading stopped.
+    void Stop();
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    ChunkDecoder(ChunkDecoder const& other);
+    ChunkDecoder& operator=(ChunkDecoder const& rhs);
+
+    struct Worker;
+    typedef boost::shared_ptr<Worker> WorkerPtr;
+    typedef boost::shared_ptr<liblas::PointBuffer> BufferPtr;
+    typedef boost::shared_ptr<boost::thread> ThreadPtr;
+
+    void Run(std::size_t worker);
+    void Decode(Worker& worker, std::size_t chunk, liblas::PointBuffer& buffer);
+    bool NextChunk();
+
+    liblas::Header m_header;
+    std::size_t m_threads;
+    std::size_t m_window;
+    std::size_t m_size;
+    std::size_t m_chunk_size;
+    std::size_t m_chunks;
+
+    // Serializes the workers' reads from the stream
+    boost::mutex m_stream_mutex;
+    std::vector<WorkerPtr> m_workers;
+    std::vector<ThreadPtr> m_pool;
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+
+    // Next chunk a worker picks up, and next chunk handed to Read
+    std::size_t m_next;
+    std::size_t m_wanted;
+    std::map<std::size_t, BufferPtr> m_ready;
+    bool m_stop;
+    std::string m_error;
+
+    // Chunk being read and where in it
+    BufferPtr m_front;
+    std::size_t m_position;
+    std::size_t m_skip;
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_CHUNKDECODER_HPP_INCLUDED
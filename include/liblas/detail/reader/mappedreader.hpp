@@ -0,0 +1,141 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Memory-mapped LAS reader implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_DETAIL_MAPPEDREADERIMPL_HPP_INCLUDED
+#define LIBLAS_DETAIL_MAPPEDREADERIMPL_HPP_INCLUDED
+
+#include <liblas/detail/fwd.hpp>
+#include <liblas/detail/reader/header.hpp>
+#include <liblas/liblas.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+// std
+#include <fstream>
+#include <string>
+
+namespace boost { namespace interprocess {
+class file_mapping;
+class mapped_region;
+}} // namespace boost::interprocess
+
+namespace liblas { namespace detail { 
+
+typedef boost::shared_ptr< reader::Header > HeaderReaderPtr;
+
+/// Reader for uncompressed files that maps the point data region of 
+/// the file into memory.  Records are copied straight out of the 
+/// mapping, so ReadPointAt and Seek are simple pointer arithmetic and 
+/// no stream calls are made once the header has been read.
+class MappedReaderImpl : public ReaderI
+{
+public:
+
+    MappedReaderImpl(std::string const& filename);
+    ~MappedReaderImpl();
+
+    void ReadHeader();
+    liblas::Header const& GetHeader() const {return *m_header;}
+    void SetHeader(liblas::Header const& header);
+    liblas::Point const& GetPoint() const { return *m_point; }
+    void ReadNextPoint();
+    std::size_t ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n);
+    liblas::Point const& ReadPointAt(std::size_t n);
+    void ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap);
+    void Seek(std::size_t n);
+    
+    void Reset();
+
+    void SetFilters(std::vector<liblas::FilterPtr> const& filters);
+    std::vector<liblas::FilterPtr> GetFilters() const;
+
+    void SetTransforms(std::vector<liblas::TransformPtr> const& transforms);
+    std::vector<liblas::TransformPtr> GetTransforms() const;
+
+    /// Address of the n-th record inside the mapping.  The pointer 
+    /// stays valid for the lifetime of the reader or until the header 
+    /// is read again.
+    boost::uint8_t const* GetRecord(std::size_t n) const;
+
+private:
+
+    void TransformPoint(liblas::Point& p);
+    void CopyRecord(std::size_t n);
+    bool CopyBlock();
+    void Map();
+
+    std::string m_filename;
+    std::ifstream m_ifs;
+    boost::uint32_t m_size;
+    boost::uint32_t m_current;
+
+    HeaderReaderPtr m_header_reader;
+    HeaderPtr m_header;
+    PointPtr m_point;
+
+    std::vector<liblas::FilterPtr> m_filters;
+    std::vector<liblas::TransformPtr> m_transforms;
+    std::size_t m_record_size;
+    bool bNeedHeaderCheck;
+
+    boost::scoped_ptr<boost::interprocess::file_mapping> m_mapping;
+    boost::scoped_ptr<boost::interprocess::mapped_region> m_region;
+    boost::uint8_t const* m_data;
+
+    // Filtered points copied ahead by ReadNextPoint and not handed out 
+    // yet, with the index of each in the file
+    liblas::PointBuffer m_block;
+    std::vector<boost::uint32_t> m_block_ids;
+    std::size_t m_block_position;
+
+    // Index of the record after the last one handed out, where reading 
+    // starts over when the filters change
+    boost::uint32_t m_next_index;
+
+    // Blocked copying operations, declared but not defined.
+    MappedReaderImpl(MappedReaderImpl const& other);
+    MappedReaderImpl& operator=(MappedReaderImpl const& rhs);
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_MAPPEDREADERIMPL_HPP_INCLUDED
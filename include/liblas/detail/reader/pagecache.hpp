@@ -0,0 +1,143 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  LRU cache of point record pages
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_PAGECACHE_HPP_INCLUDED
+#define LIBLAS_DETAIL_PAGECACHE_HPP_INCLUDED
+
+#include <liblas/pointbuffer.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+// std
+#include <cstddef>
+#include <list>
+#include <map>
+
+namespace liblas { namespace detail { 
+
+/// Identifies page number \a page of the file registered as \a file.
+struct PageKey
+{
+    PageKey(boost::uint64_t f, std::size_t p) : file(f), page(p) {}
+
+    bool operator<(PageKey const& other) const
+    {
+        return file < other.file || (file == other.file && page < other.page);
+    }
+
+    boost::uint64_t file;
+    std::size_t page;
+};
+
+/// Pages of raw point records, keyed by file and page number, that are evicted 
+/// least recently used first once their total size exceeds a byte 
+/// budget.  Pages are handed out as shared pointers, so a page that is 
+/// evicted while a caller still holds it stays valid for that caller.
+/// Not thread safe.
+class PageCache
+{
+public:
+
+    typedef boost::shared_ptr<liblas::PointBuffer> PagePtr;
+
+    /// Cache holding up to \a budget bytes of records.  A budget of 0 
+    /// means no limit.  The most recently inserted page is always kept, 
+    /// even if it alone is larger than the budget.
+    explicit PageCache(std::size_t budget);
+
+    /// Page \a key, or a null pointer if it is not cached.  Counts as a 
+    /// hit or a miss and marks the page as most recently used.
+    PagePtr Find(PageKey const& key);
+
+    /// Adds \a data as page \a key, replacing any page with the same 
+    /// key, and evicts pages until the cache fits its budget.
+    void Insert(PageKey const& key, PagePtr data);
+
+    /// Drops all pages.  The counters are kept.
+    void Clear();
+
+    std::size_t GetBudget() const { return m_budget; }
+    void SetBudget(std::size_t budget);
+
+    /// Number of pages and bytes of records currently held.
+    std::size_t GetPageCount() const { return m_pages.size(); }
+    std::size_t GetByteCount() const { return m_bytes; }
+
+    boost::uint64_t GetHitCount() const { return m_hits; }
+    boost::uint64_t GetMissCount() const { return m_misses; }
+    boost::uint64_t GetEvictionCount() const { return m_evictions; }
+
+    /// Total size of the pages returned by Find.
+    boost::uint64_t GetBytesServed() const { return m_served; }
+
+private:
+
+    typedef std::list<PageKey> lru_type;
+
+    struct Entry
+    {
+        PagePtr data;
+        std::size_t bytes;
+        lru_type::iterator lru;
+    };
+
+    typedef std::map<PageKey, Entry> page_map;
+
+    void Erase(page_map::iterator i);
+    void Evict();
+
+    std::size_t m_budget;
+    std::size_t m_bytes;
+    page_map m_pages;
+
+    // Page keys, most recently used first.
+    lru_type m_lru;
+
+    boost::uint64_t m_hits;
+    boost::uint64_t m_misses;
+    boost::uint64_t m_evictions;
+    boost::uint64_t m_served;
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_PAGECACHE_HPP_INCLUDED
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Read-ahead LAS reader implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_DETAIL_PREFETCHREADERIMPL_HPP_INCLUDED
+#define LIBLAS_DETAIL_PREFETCHREADERIMPL_HPP_INCLUDED
+
+#include <liblas/detail/fwd.hpp>
+#include <liblas/liblas.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+// std
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace liblas { namespace detail { 
+
+/// Wraps another reader and reads blocks of points from it on a worker 
+/// thread while the caller consumes the previous block.  Up to \a depth 
+/// blocks of \a block_size points are kept ahead of the caller, so 
+/// stream latency and decompression overlap with whatever the caller 
+/// does with the points.
+///
+/// The filters and transforms are applied on the worker thread rather 
+/// than by the wrapped reader, so the file index of every point read 
+/// ahead is known.  Seek, Reset, ReadPointAt, ReadPointsAt, SetHeader, 
+/// SetFilters and SetTransforms throw away the points read ahead and 
+/// reposition the wrapped reader at the first record not yet handed 
+/// out, so a change of header, filters or transforms applies to every 
+/// point read after it.  After ReadPointAt and ReadPointsAt, reading 
+/// continues after the last point they read.
+class PrefetchReaderImpl : public ReaderI
+{
+public:
+
+    PrefetchReaderImpl(ReaderIPtr reader, std::size_t block_size, std::size_t depth);
+    ~PrefetchReaderImpl();
+
+    liblas::Header const& GetHeader() const;
+    void ReadHeader();
+    void SetHeader(liblas::Header const& header);
+    liblas::Point const& GetPoint() const { return m_point; }
+    void ReadNextPoint();
+    std::size_t ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n);
+    liblas::Point const& ReadPointAt(std::size_t n);
+    void ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap);
+    void Seek(std::size_t n);
+
+    void Reset();
+
+    void SetFilters(std::vector<liblas::FilterPtr> const& filters);
+    std::vector<liblas::FilterPtr> GetFilters() const;
+
+    void SetTransforms(std::vector<liblas::TransformPtr> const& transforms);
+    std::vector<liblas::TransformPtr> GetTransforms() const;
+
+    /// Number of blocks the worker has read so far.
+    boost::uint64_t GetBlockCount() const;
+
+    /// Number of times the caller had to wait for the worker 
+    /// because no block was ready.
+    boost::uint64_t GetStallCount() const;
+
+    /// Total time the caller spent waiting for the worker, in seconds.
+    double GetStallTime() const;
+
+    /// Total time the worker spent waiting for the caller to hand 
+    /// back a buffer, in seconds.  A large value means the read-ahead 
+    /// depth could be reduced.
+    double GetIdleTime() const;
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    PrefetchReaderImpl(PrefetchReaderImpl const& other);
+    PrefetchReaderImpl& operator=(PrefetchReaderImpl const& rhs);
+
+    // Points read ahead along with the file index of each of them
+    struct Block
+    {
+        liblas::PointBuffer points;
+        std::vector<boost::uint32_t> ids;
+    };
+
+    typedef boost::shared_ptr<Block> BlockPtr;
+    typedef std::deque<BlockPtr> queue_type;
+
+    void Run();
+    void Stop();
+    void Discard();
+    void Reposition();
+    bool NextBlock();
+
+    ReaderIPtr m_reader;
+    std::size_t m_block_size;
+    std::size_t m_depth;
+
+    mutable boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    boost::scoped_ptr<boost::thread> m_thread;
+
+    queue_type m_free;
+    queue_type m_ready;
+    BlockPtr m_front;
+    std::size_t m_position;
+
+    // File index of the first record not yet handed out, and of the 
+    // next record the worker reads from the wrapped reader.
+    boost::uint32_t m_next_index;
+    boost::uint32_t m_read_index;
+
+    std::vector<liblas::FilterPtr> m_filters;
+    std::vector<liblas::TransformPtr> m_transforms;
+    liblas::Point m_scratch;
+
+    bool m_stop;
+    bool m_done;
+
+    // What the worker failed with, rethrown to the caller as it was 
+    // thrown by the wrapped reader
+    boost::exception_ptr m_error;
+
+    liblas::Point m_point;
+
+    boost::uint64_t m_blocks;
+    boost::uint64_t m_stalls;
+    boost::posix_time::time_duration m_stall_time;
+    boost::posix_time::time_duration m_idle_time;
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_PREFETCHREADERIMPL_HPP_INCLUDED
@@ -49,6 +49,8 @@
 #include <boost/cstdint.hpp>
 // std
 #include <iosfwd>
+#include <utility>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 namespace liblas { namespace detail { 
@@ -56,6 +58,64 @@ namespace liblas { namespace detail {
 // typedef boost::shared_ptr< reader::Point > PointReaderPtr;
 typedef boost::shared_ptr< reader::Header > HeaderReaderPtr;
 
+// Number of records ReadNextPoint reads at once when filters are set.
+static const std::size_t filter_block_size = 4096;
+
+// Block-at-a-time helpers shared by the reader implementations.
+
+/// Applies filters to the records of buffer starting at first, 
+/// compacting the survivors towards the front of the buffer.
+/// Filters are run one after the other over the whole block with 
+/// FilterI::filter_batch.  If \a ids is given it holds one entry per 
+/// record of buffer and is compacted along with the records.
+void FilterPoints(std::vector<liblas::FilterPtr> const& filters,
+                  liblas::PointBuffer& buffer,
+                  std::size_t first,
+                  std::vector<boost::uint32_t>* ids = 0);
+
+/// Appends up to n of the records of block from position on to the 
+/// end of buffer and moves position past them.  Returns the number of 
+/// records appended.
+std::size_t DrainBlock(liblas::PointBuffer const& block,
+                       std::size_t& position,
+                       liblas::PointBuffer& buffer,
+                       std::size_t n);
+
+/// Applies transforms in place to every record of buffer.  If the 
+/// transforms move the points onto a different header the buffer is 
+/// rebuilt with the layout of that header.
+void TransformPoints(std::vector<liblas::TransformPtr> const& transforms,
+                     liblas::PointBuffer& buffer,
+                     liblas::Point& scratch);
+
+/// Ids asked for by ReadPointsAt in ascending order, each paired with 
+/// the place its point goes in the buffer handed back.
+typedef std::vector< std::pair<boost::uint32_t, std::size_t> > PointRequest;
+
+/// Records ReadPointsAt reads in one go.  The run starts at record 
+/// first and covers the entries [begin, end) of the PointRequest.
+struct PointRun
+{
+    std::size_t first;
+    std::size_t count;
+    std::size_t begin;
+    std::size_t end;
+};
+
+/// Sorts ids into request and merges ids that are no more than gap 
+/// records apart into runs, so that every run takes a single seek.
+void PlanPointRuns(std::vector<boost::uint32_t> const& ids,
+                   std::size_t gap,
+                   PointRequest& request,
+                   std::vector<PointRun>& runs);
+
+/// Copies the records of run, held in records from run.first on, to 
+/// their places in buffer.
+void ScatterPointRun(PointRequest const& request,
+                     PointRun const& run,
+                     liblas::PointBuffer const& records,
+                     liblas::PointBuffer& buffer);
+
 class ReaderImpl : public ReaderI
 {
 public:
@@ -68,7 +128,9 @@ public:
     void SetHeader(liblas::Header const& header);
     liblas::Point const& GetPoint() const { return *m_point; }
     void ReadNextPoint();
+    std::size_t ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n);
     liblas::Point const& ReadPointAt(std::size_t n);
+    void ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap);
     void Seek(std::size_t n);
     
     void Reset();
@@ -103,9 +165,22 @@ protected:
     std::vector<liblas::TransformPtr> m_transforms;
     std::vector<boost::uint8_t>::size_type m_record_size;
     bool bNeedHeaderCheck;
+
+    // Filtered points read ahead by ReadNextPoint and not handed out 
+    // yet, with the index of each in the file
+    liblas::PointBuffer m_block;
+    std::vector<boost::uint32_t> m_block_ids;
+    std::size_t m_block_position;
+
+    // Index of the record after the last one handed out, where reading 
+    // starts over when the filters change
+    boost::uint32_t m_next_index;
     
 private:
 
+    std::size_t ReadRecords(liblas::PointBuffer& buffer, std::size_t n);
+    bool ReadBlock();
+
     // Blocked copying operations, declared but not defined.
     ReaderImpl(ReaderImpl const& other);
     ReaderImpl& operator=(ReaderImpl const& rhs);
@@ -43,6 +43,8 @@
 #define LIBLAS_DETAIL_ZIPREADERIMPL_HPP_INCLUDED
 
 
+#include <liblas/chunksummary.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/detail/fwd.hpp>
 #include <liblas/detail/reader/header.hpp>
 // boost
@@ -50,6 +52,7 @@
 // std
 #include <iosfwd>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 
 // liblaszip
 class LASunzipper;
@@ -58,12 +61,16 @@ class LASzip;
 namespace liblas { namespace detail { 
 
 class ZipPoint;
+class ChunkDecoder;
 typedef boost::shared_ptr< reader::Header > HeaderReaderPtr;
 
 class ZipReaderImpl : public ReaderI
 {
 public:
-    ZipReaderImpl(std::istream& ifs);
+    /// With more than one thread, the chunks of a chunked file are 
+    /// decompressed in parallel by a ChunkDecoder.  Files that are not 
+    /// chunked are decoded on the calling thread.
+    ZipReaderImpl(std::istream& ifs, std::size_t threads = 1);
     ~ZipReaderImpl();
 
     void ReadHeader();
@@ -71,12 +78,14 @@ public:
     void SetHeader(liblas::Header const& header);
     liblas::Point const& GetPoint() const { return *m_point; }
     void ReadNextPoint();
+    std::size_t ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n);
 
     // Warning: seeking is not supporting in the laszip format, so 
     // ReadPointAt() and Seek() are implemented to rewind to the 
     // beginning of the file and read through all the N-1 previous
     // point first.  That is, these functions are SLOW.
     liblas::Point const& ReadPointAt(std::size_t n);
+    void ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap);
     void Seek(std::size_t n);
     
     void Reset();
@@ -110,13 +119,35 @@ protected:
 
 private:
     void ReadIdiom();
+    void DecodeNext();
+    std::size_t DecodeRecords(liblas::PointBuffer& buffer, std::size_t n);
+    void LoadSummaries();
+    std::size_t SkipChunks(std::size_t n);
+    bool DecodeBlock();
 
     // boost::scoped_ptr<LASzip> m_zip;
     boost::scoped_ptr<ZipPoint> m_zipPoint;
     boost::scoped_ptr<LASunzipper> m_unzipper;
 
+    std::size_t m_threads;
+    boost::scoped_ptr<ChunkDecoder> m_decoder;
+
     bool bNeedHeaderCheck;
     std::streampos m_zipReadStartPosition;
+
+    // Chunk summaries stored with the file, if any
+    std::vector<liblas::ChunkSummary> m_summaries;
+    std::size_t m_summary_chunk_size;
+
+    // Filtered points read ahead by ReadNextPoint and not handed out 
+    // yet, with the index of each in the file
+    liblas::PointBuffer m_block;
+    std::vector<boost::uint32_t> m_block_ids;
+    std::size_t m_block_position;
+
+    // Index of the record after the last one handed out, where reading 
+    // starts over when the filters change
+    boost::uint32_t m_next_index;
     
     // Blocked copying operations, declared but not defined.
     ZipReaderImpl(ZipReaderImpl const& other);
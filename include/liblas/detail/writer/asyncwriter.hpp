@@ -0,0 +1,159 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Write-behind LAS writer implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_ASYNCWRITERIMPL_HPP_INCLUDED
+#define LIBLAS_DETAIL_ASYNCWRITERIMPL_HPP_INCLUDED
+
+#include <liblas/detail/fwd.hpp>
+#include <liblas/liblas.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+// std
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace liblas { namespace detail { 
+
+/// Wraps another writer and hands it the points on a worker thread, so 
+/// the stream writes -- and the compression of a compressed file -- 
+/// overlap with whatever the caller does to produce the points.
+///
+/// WritePoint gathers points into blocks of \a block_size points and 
+/// WritePoints copies the caller's buffer; either way the block is 
+/// queued for the worker.  The caller waits while more than 
+/// \a queue_bytes bytes of records are queued.  An error of the worker 
+/// is thrown by the next call that queues a block, or by Flush.  Points 
+/// queued after the error are dropped.
+///
+/// WriteHeader, SetHeader and UpdatePointCount wait for the queue to 
+/// drain first.  GetHeader waits for the queued blocks to be written, 
+/// as the worker updates the point count of the header, but points of 
+/// a block not yet full are only counted after Flush.
+class AsyncWriterImpl : public WriterI
+{
+public:
+
+    static const std::size_t default_queue_bytes = 64 * 1024 * 1024;
+    static const std::size_t default_block_size = 4096;
+
+    AsyncWriterImpl(WriterIPtr writer, 
+                    std::size_t queue_bytes = default_queue_bytes, 
+                    std::size_t block_size = default_block_size);
+
+    /// Writes the queued points.  Errors are lost; call Flush first 
+    /// to see them.
+    ~AsyncWriterImpl();
+
+    liblas::Header& GetHeader() const;
+    void WriteHeader();
+    void SetHeader(liblas::Header const& header);
+
+    void UpdatePointCount(boost::uint32_t count);
+    void WritePoint(liblas::Point const& point);
+    void WritePoints(liblas::PointBuffer const& buffer);
+    void Flush();
+
+    void SetFilters(std::vector<liblas::FilterPtr> const& filters);
+    std::vector<liblas::FilterPtr> GetFilters() const;
+
+    void SetTransforms(std::vector<liblas::TransformPtr> const& transforms);
+    std::vector<liblas::TransformPtr> GetTransforms() const;
+
+    /// Number of blocks the worker has written so far.
+    boost::uint64_t GetBlockCount() const;
+
+    /// Number of times the caller had to wait for the worker 
+    /// because the queue was full.
+    boost::uint64_t GetStallCount() const;
+
+    /// Total time the caller spent waiting for the worker, in seconds.
+    double GetStallTime() const;
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    AsyncWriterImpl(AsyncWriterImpl const& other);
+    AsyncWriterImpl& operator=(AsyncWriterImpl const& rhs);
+
+    typedef boost::shared_ptr<liblas::PointBuffer> BufferPtr;
+    typedef std::deque<BufferPtr> queue_type;
+
+    void Run();
+    void Stop();
+    BufferPtr Acquire();
+    void Submit();
+    void Enqueue(BufferPtr buffer);
+    void Fence();
+
+    WriterIPtr m_writer;
+    std::size_t m_queue_bytes;
+    std::size_t m_block_size;
+
+    mutable boost::mutex m_mutex;
+    mutable boost::condition_variable m_cond;
+    boost::scoped_ptr<boost::thread> m_thread;
+
+    queue_type m_free;
+    queue_type m_ready;
+    BufferPtr m_current;
+    std::size_t m_queued;
+
+    bool m_busy;
+    bool m_stop;
+    std::string m_error;
+
+    boost::uint64_t m_blocks;
+    boost::uint64_t m_stalls;
+    boost::posix_time::time_duration m_stall_time;
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_ASYNCWRITERIMPL_HPP_INCLUDED
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Parallel LASzip chunk encoder
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_DETAIL_CHUNKENCODER_HPP_INCLUDED
+#define LIBLAS_DETAIL_CHUNKENCODER_HPP_INCLUDED
+
+#include <liblas/header.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/pointdata.hpp>
+#include <liblas/detail/fwd.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+// std
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace liblas { namespace detail { 
+
+class ZipPoint;
+
+/// Writes the LASzip chunk table for chunks of \a chunk_bytes bytes 
+/// each, the way LASzipper does when it is closed: a version and a 
+/// chunk count followed by the arithmetic coded chunk sizes.
+void WriteChunkTable(std::ostream& ofs, std::vector<boost::uint32_t> const& chunk_bytes);
+
+/// Compresses points into a chunked LASzip stream on a pool of threads.  
+/// Points are gathered into chunks of the size the LASzip VLR of the 
+/// header asks for, and every chunk is compressed on its own by a 
+/// worker, which is possible because LASzip starts every chunk with 
+/// fresh models.  The caller's thread writes the compressed chunks in 
+/// order and, on Close, the chunk table, so the result is read like 
+/// the output of a single LASzipper.
+///
+/// At most \a window chunks are queued or compressed but not written 
+/// yet; Write blocks while the window is full.
+class ChunkEncoder
+{
+public:
+
+    /// Encoder that writes to \a ofs from its current position, which 
+    /// must be right after the header and VLRs.  A \a window of 0 picks 
+    /// twice the number of threads.
+    /// @exception configuration_error if \a threads is 0 or the header 
+    /// does not ask for a chunked stream.
+    ChunkEncoder(std::ostream& ofs, liblas::Header const& header, 
+                 std::size_t threads, std::size_t window = 0);
+
+    /// Stops the threads.  Points not written by Close are lost.
+    ~ChunkEncoder();
+
+    std::size_t GetThreadCount() const { return m_threads; }
+    std::size_t GetChunkSize() const { return m_chunk_size; }
+
+    /// Adds the record \a data to the stream.  Bytes past the record 
+    /// length of the header are ignored.
+    /// @exception liblas_error if compressing an earlier chunk failed.
+    void Write(liblas::PointData const& data);
+
+    /// Adds the \a count records stored back to back at \a data.
+    /// @exception liblas_error if compressing an earlier chunk failed.
+    void Write(boost::uint8_t const* data, std::size_t count);
+
+    /// Compresses and writes the points not written yet, then writes 
+    /// the chunk table.  Leaves \a ofs positioned at the end.
+    void Close();
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    ChunkEncoder(ChunkEncoder const& other);
+    ChunkEncoder& operator=(ChunkEncoder const& rhs);
+
+    typedef boost::shared_ptr<ZipPoint> ZipPointPtr;
+    typedef boost::shared_ptr<liblas::PointBuffer> BufferPtr;
+    typedef boost::shared_ptr<boost::thread> ThreadPtr;
+    typedef std::pair<std::size_t, BufferPtr> Job;
+
+    void Run(std::size_t worker);
+    void Compress(ZipPoint& point, liblas::PointBuffer const& points, std::string& chunk);
+    void Submit();
+    bool WriteReady(boost::mutex::scoped_lock& lock);
+    void Stop();
+
+    std::ostream& m_ofs;
+    liblas::Header m_header;
+    std::size_t m_threads;
+    std::size_t m_window;
+    std::size_t m_chunk_size;
+
+    // Where the offset of the chunk table goes
+    std::streamoff m_start;
+
+    std::vector<ZipPointPtr> m_points;
+    std::vector<ThreadPtr> m_pool;
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+
+    std::deque<Job> m_jobs;
+    std::map<std::size_t, std::string> m_compressed;
+    std::size_t m_submitted;
+    std::size_t m_written;
+    bool m_stop;
+    bool m_closed;
+    std::string m_error;
+
+    // Points of the chunk being filled
+    BufferPtr m_current;
+
+    std::vector<boost::uint32_t> m_chunk_bytes;
+};
+
+}} // namespace liblas::detail
+
+#endif // LIBLAS_DETAIL_CHUNKENCODER_HPP_INCLUDED
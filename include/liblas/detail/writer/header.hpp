@@ -43,11 +43,14 @@
 #define LIBLAS_DETAIL_WRITER_HEADER_HPP_INCLUDED
 
 #include <liblas/header.hpp>
+#include <liblas/chunksummary.hpp>
 #include <liblas/detail/fwd.hpp>
 #include <liblas/detail/private_utility.hpp>
 // boost
+#include <boost/array.hpp>
 #include <boost/cstdint.hpp>
 // std
+#include <cstddef>
 #include <iosfwd>
 
 namespace liblas { namespace detail { namespace writer {
@@ -62,6 +65,42 @@ public:
     liblas::Header const& GetHeader() const { return m_header; }
     void write();
 
+    /// Positions the stream after the points of the uncompressed file 
+    /// described by GetHeader(), without changing anything in the file.  
+    /// The header on the stream only learns of the points written from 
+    /// there on through WriteSummary, so the file stays valid until 
+    /// then.
+    /// @exception invalid_format - if the file holds fewer points than 
+    /// its header says.
+    void append();
+
+    /// Reserve a chunk summary VLR for chunks of the given size when the 
+    /// header is written.  Reset to 0 if the stream is appended to.
+    void SetChunkSummarySize(boost::uint32_t size) { m_chunk_summary_size = size; }
+    boost::uint32_t GetChunkSummarySize() const { return m_chunk_summary_size; }
+
+    /// Adds \a count records of \a length bytes at \a data to the 
+    /// running bounds and points by return of the points written.
+    void AddPoints(boost::uint8_t const* data, std::size_t count, std::size_t length);
+
+    /// Adds \a count records of \a length bytes at \a data to 
+    /// \a bounds and \a returns, for AddPoints and for writers that 
+    /// summarize records before handing them to AddSummary.
+    static void SummarizePoints(boost::uint8_t const* data, std::size_t count, std::size_t length, 
+                                ChunkSummary& bounds, boost::array<boost::uint32_t, 5>& returns);
+
+    /// Adds the bounds and points by return of records summarized 
+    /// elsewhere, for writers that fill the file from several threads.
+    void AddSummary(ChunkSummary const& bounds, boost::array<boost::uint32_t, 5> const& returns);
+
+    /// Stores \a count as the number of points, and the bounds and 
+    /// points by return of the points written so far, in \a header 
+    /// and in the header on the stream, merged with those already in 
+    /// the file in append mode.  The points are flushed first, then 
+    /// the bounds, then the count and points by return in one write.  
+    /// The stream position is kept.
+    void WriteSummary(liblas::Header& header, boost::uint32_t count);
+
 private:
     
     void WriteVLRs();
@@ -73,6 +112,11 @@ private:
     std::ostream& m_ofs;    
     liblas::Header m_header;
     boost::uint32_t& m_pointCount;
+    boost::uint32_t m_chunk_summary_size;
+
+    bool m_append;
+    ChunkSummary m_bounds;
+    boost::array<boost::uint32_t, 5> m_returns;
 };
 
 }}} // namespace liblas::detail::writer
@@ -43,6 +43,7 @@
 #define LIBLAS_DETAIL_WRITER_POINT_HPP_INCLUDED
 
 #include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/schema.hpp>
 #include <liblas/header.hpp>
 #include <liblas/detail/private_utility.hpp>
@@ -65,6 +66,9 @@ public:
 
     // const liblas::Point& GetPoint() const { return m_point; }
     void write( const liblas::Point& );
+
+    /// Writes every record of \a buffer with a single stream write.
+    void write(liblas::PointBuffer const& buffer);
     
 protected:
 
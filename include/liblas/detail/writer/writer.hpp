@@ -60,9 +60,17 @@ class WriterImpl : public WriterI
 public:
 
     WriterImpl(std::ostream& ofs);
+
+    /// Writer that adds points to the end of the uncompressed file on 
+    /// \a ofs described by \a existing.  SetHeader only accepts headers 
+    /// whose points can go in the file, and WriteHeader leaves the file 
+    /// as it is until the writer is destroyed.
+    WriterImpl(std::ostream& ofs, liblas::Header const& existing);
     ~WriterImpl();
     LASVersion GetVersion() const;
     void WritePoint(liblas::Point const& record);
+    void WritePoints(liblas::PointBuffer const& buffer);
+    void Flush();
 
     liblas::Header& GetHeader() const;
     void WriteHeader();
@@ -91,6 +99,7 @@ protected:
 private:
 
     boost::uint32_t m_pointCount;
+    bool m_appending;
 
     // block copying operations
     WriterImpl(WriterImpl const& other);
@@ -44,6 +44,7 @@
 
 
 #include <liblas/detail/fwd.hpp>
+#include <liblas/chunksummary.hpp>
 #include <liblas/liblas.hpp>
 #include <liblas/detail/writer/point.hpp>
 #include <liblas/detail/writer/header.hpp>
@@ -51,6 +52,8 @@
 #include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
+// std
+#include <cstddef>
 
 // liblaszip
 class LASzip;
@@ -58,6 +61,7 @@ class LASzipper;
 
 namespace liblas { namespace detail { 
 
+class ChunkEncoder;
 class ZipPoint;
 typedef boost::shared_ptr< writer::Point > PointWriterPtr;
 typedef boost::shared_ptr< writer::Header > HeaderWriterPtr;
@@ -66,10 +70,16 @@ class ZipWriterImpl : public WriterI
 {
 public:
 
-    ZipWriterImpl(std::ostream& ofs);
+    /// Writer that compresses the chunks of a chunked stream on 
+    /// \a threads threads at once when \a threads is more than 1.  
+    /// With \a summarize, a ChunkSummary of every chunk is stored 
+    /// with the file for readers to skip chunks with.
+    ZipWriterImpl(std::ostream& ofs, std::size_t threads = 1, bool summarize = false);
     ~ZipWriterImpl();
     LASVersion GetVersion() const;
     void WritePoint(liblas::Point const& record);
+    void WritePoints(liblas::PointBuffer const& buffer);
+    void Flush();
 
     liblas::Header& GetHeader() const;
     void WriteHeader();
@@ -96,10 +106,21 @@ protected:
     HeaderPtr m_header;
 
 private:
+    void Summarize(boost::uint8_t const* data, std::size_t index);
+    void WriteSummaries();
+
     boost::uint32_t m_pointCount;
+    std::size_t m_threads;
+
+    bool m_summarize;
+    std::vector<liblas::ChunkSummary> m_summaries;
+    // Where the payload of the chunk summary VLR starts, 0 if we 
+    // are not summarizing
+    std::streamoff m_summary_position;
 
     boost::scoped_ptr<LASzipper> m_zipper;
     boost::scoped_ptr<ZipPoint> m_zipPoint;
+    boost::scoped_ptr<ChunkEncoder> m_encoder;
     
     // block copying operations
     ZipWriterImpl(ZipWriterImpl const& other);
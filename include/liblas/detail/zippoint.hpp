@@ -75,6 +75,11 @@ public:
     
     LASzip* GetZipper() const { return m_zip.get(); }
 
+    /// Points the laszip items at the record at \a data, which must be 
+    /// m_lz_point_size bytes long, so points are read into and written 
+    /// from it without a copy.  NULL points them back at m_lz_point_data.
+    void SetData(boost::uint8_t* data);
+
 private:
     void ConstructItems();
 
@@ -0,0 +1,326 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Typed access to point record dimensions
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_DIMENSIONACCESSOR_HPP_INCLUDED
+#define LIBLAS_DIMENSIONACCESSOR_HPP_INCLUDED
+
+#include <liblas/dimension.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/schema.hpp>
+#include <liblas/detail/binary.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace liblas {
+
+namespace detail {
+
+/// How the value of a Dimension is stored in a point record.
+struct LAS_DLL DimensionLayout
+{
+    enum Kind
+    {
+        eUInt8,
+        eInt8,
+        eUInt16,
+        eInt16,
+        eUInt32,
+        eInt32,
+        eUInt64,
+        eInt64,
+        eFloat,
+        eDouble,
+        eUnsigned, ///< little-endian unsigned integer of byte_size bytes
+        eSigned,   ///< little-endian signed integer of byte_size bytes
+        eBits      ///< mask bits at shift within a single byte
+    };
+
+    /// Works out the layout of dim from its byte and bit offsets, bit 
+    /// size and numeric flags.  Throws liblas_error for dimensions that 
+    /// are wider than 64 bits or whose bits span a byte boundary.
+    explicit DimensionLayout(Dimension const& dim);
+
+    /// Number of record bytes the value touches, counted from byte_offset
+    std::size_t GetExtent() const { return kind == eBits ? 1 : byte_size; }
+
+    Kind kind;
+    std::size_t byte_offset;
+    std::size_t byte_size;
+    unsigned int shift;
+    boost::uint8_t mask;
+};
+
+LAS_DLL boost::uint64_t load_unsigned(boost::uint8_t const* data, std::size_t size);
+LAS_DLL boost::int64_t load_signed(boost::uint8_t const* data, std::size_t size);
+LAS_DLL void store_integer(boost::uint8_t* data, std::size_t size, boost::uint64_t value);
+
+template <typename Stored>
+inline Stored load_stored(boost::uint8_t const* data)
+{
+    binary::endian_value<Stored> value;
+    value.template load<binary::little_endian_tag>(data);
+    return value;
+}
+
+template <>
+inline float load_stored<float>(boost::uint8_t const* data)
+{
+    binary::endian_value<boost::uint32_t> raw;
+    raw.load<binary::little_endian_tag>(data);
+    boost::uint32_t const bits = raw;
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+template <typename Stored>
+inline void store_stored(boost::uint8_t* data, Stored value)
+{
+    binary::endian_value<Stored> v(value);
+    v.template store<binary::little_endian_tag>(data);
+}
+
+template <>
+inline void store_stored<float>(boost::uint8_t* data, float value)
+{
+    boost::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    binary::endian_value<boost::uint32_t> raw(bits);
+    raw.store<binary::little_endian_tag>(data);
+}
+
+template <typename T, typename Stored>
+inline void load_column(boost::uint8_t const* data, std::size_t stride, std::size_t count, T* out)
+{
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+        out[i] = static_cast<T>(load_stored<Stored>(data));
+}
+
+} // namespace detail
+
+/// Reads and writes one Dimension of raw point records as values of 
+/// type T.  The offsets, size and sign of the dimension are worked out 
+/// once, when the accessor is constructed, so it is cheap to use on 
+/// every record of a PointBuffer and works the same for the standard 
+/// dimensions and for custom ones such as the Riegl attributes added by 
+/// Schema::AddRieglDimensions.  Values are converted to T with 
+/// static_cast; no scale or offset is applied.
+///
+/// \code
+/// liblas::DimensionAccessor<double> amplitude(header.GetSchema(), "Amplitude");
+/// std::vector<double> values;
+/// amplitude.Get(liblas::PointSpan(buffer), values);
+/// \endcode
+template <typename T>
+class DimensionAccessor
+{
+public:
+
+    explicit DimensionAccessor(Dimension const& dim)
+        : m_dimension(dim)
+        , m_layout(dim)
+    {}
+
+    /// Accessor for the dimension called name in schema.  Throws 
+    /// liblas_error if the schema has no such dimension.
+    DimensionAccessor(Schema const& schema, std::string const& name)
+        : m_dimension(FindDimension(schema, name))
+        , m_layout(m_dimension)
+    {}
+
+    Dimension const& GetDimension() const { return m_dimension; }
+
+    /// Value of the dimension in the record starting at record.
+    T Get(boost::uint8_t const* record) const
+    {
+        using namespace detail;
+
+        boost::uint8_t const* data = record + m_layout.byte_offset;
+        switch (m_layout.kind)
+        {
+            case DimensionLayout::eUInt8:  return static_cast<T>(*data);
+            case DimensionLayout::eInt8:   return static_cast<T>(static_cast<boost::int8_t>(*data));
+            case DimensionLayout::eUInt16: return static_cast<T>(load_stored<boost::uint16_t>(data));
+            case DimensionLayout::eInt16:  return static_cast<T>(load_stored<boost::int16_t>(data));
+            case DimensionLayout::eUInt32: return static_cast<T>(load_stored<boost::uint32_t>(data));
+            case DimensionLayout::eInt32:  return static_cast<T>(load_stored<boost::int32_t>(data));
+            case DimensionLayout::eUInt64: return static_cast<T>(load_stored<boost::uint64_t>(data));
+            case DimensionLayout::eInt64:  return static_cast<T>(load_stored<boost::int64_t>(data));
+            case DimensionLayout::eFloat:  return static_cast<T>(load_stored<float>(data));
+            case DimensionLayout::eDouble: return static_cast<T>(load_stored<double>(data));
+            case DimensionLayout::eUnsigned: return static_cast<T>(load_unsigned(data, m_layout.byte_size));
+            case DimensionLayout::eSigned: return static_cast<T>(load_signed(data, m_layout.byte_size));
+            case DimensionLayout::eBits:   return static_cast<T>((*data >> m_layout.shift) & m_layout.mask);
+        }
+        return T();
+    }
+
+    /// Stores value into the record starting at record.
+    void Set(boost::uint8_t* record, T value) const
+    {
+        using namespace detail;
+
+        boost::uint8_t* data = record + m_layout.byte_offset;
+        switch (m_layout.kind)
+        {
+            case DimensionLayout::eUInt8:  *data = static_cast<boost::uint8_t>(value); break;
+            case DimensionLayout::eInt8:   *data = static_cast<boost::uint8_t>(static_cast<boost::int8_t>(value)); break;
+            case DimensionLayout::eUInt16: store_stored(data, static_cast<boost::uint16_t>(value)); break;
+            case DimensionLayout::eInt16:  store_stored(data, static_cast<boost::int16_t>(value)); break;
+            case DimensionLayout::eUInt32: store_stored(data, static_cast<boost::uint32_t>(value)); break;
+            case DimensionLayout::eInt32:  store_stored(data, static_cast<boost::int32_t>(value)); break;
+            case DimensionLayout::eUInt64: store_stored(data, static_cast<boost::uint64_t>(value)); break;
+            case DimensionLayout::eInt64:  store_stored(data, static_cast<boost::int64_t>(value)); break;
+            case DimensionLayout::eFloat:  store_stored(data, static_cast<float>(value)); break;
+            case DimensionLayout::eDouble: store_stored(data, static_cast<double>(value)); break;
+            case DimensionLayout::eUnsigned: 
+                store_integer(data, m_layout.byte_size, static_cast<boost::uint64_t>(value)); 
+                break;
+            case DimensionLayout::eSigned: 
+                store_integer(data, m_layout.byte_size, 
+                              static_cast<boost::uint64_t>(static_cast<boost::int64_t>(value))); 
+                break;
+            case DimensionLayout::eBits:
+            {
+                boost::uint8_t const bits = static_cast<boost::uint8_t>(
+                    (static_cast<boost::uint8_t>(value) & m_layout.mask) << m_layout.shift);
+                boost::uint8_t const keep = static_cast<boost::uint8_t>(~(m_layout.mask << m_layout.shift));
+                *data = static_cast<boost::uint8_t>((*data & keep) | bits);
+                break;
+            }
+        }
+    }
+
+    T Get(Point const& p) const
+    {
+        PointData const& data = p.GetData();
+        CheckLength(data.size());
+        return Get(&data.front());
+    }
+
+    void Set(Point& p, T value) const
+    {
+        PointData& data = p.GetData();
+        CheckLength(data.size());
+        Set(&data.front(), value);
+    }
+
+    T Get(PointSpan const& points, std::size_t i) const
+    {
+        return Get(points.GetRecord(i));
+    }
+
+    /// Decodes the dimension of every record of points into values.
+    void Get(PointSpan const& points, std::vector<T>& values) const
+    {
+        using namespace detail;
+
+        std::size_t const count = points.size();
+        values.resize(count);
+        if (0 == count)
+            return;
+
+        CheckLength(points.GetRecordLength());
+
+        std::size_t const stride = points.GetRecordLength();
+        boost::uint8_t const* data = points.GetRecord(0) + m_layout.byte_offset;
+        T* out = &values.front();
+
+        switch (m_layout.kind)
+        {
+            case DimensionLayout::eUInt8:  load_column<T, boost::uint8_t>(data, stride, count, out); break;
+            case DimensionLayout::eInt8:   load_column<T, boost::int8_t>(data, stride, count, out); break;
+            case DimensionLayout::eUInt16: load_column<T, boost::uint16_t>(data, stride, count, out); break;
+            case DimensionLayout::eInt16:  load_column<T, boost::int16_t>(data, stride, count, out); break;
+            case DimensionLayout::eUInt32: load_column<T, boost::uint32_t>(data, stride, count, out); break;
+            case DimensionLayout::eInt32:  load_column<T, boost::int32_t>(data, stride, count, out); break;
+            case DimensionLayout::eUInt64: load_column<T, boost::uint64_t>(data, stride, count, out); break;
+            case DimensionLayout::eInt64:  load_column<T, boost::int64_t>(data, stride, count, out); break;
+            case DimensionLayout::eFloat:  load_column<T, float>(data, stride, count, out); break;
+            case DimensionLayout::eDouble: load_column<T, double>(data, stride, count, out); break;
+            case DimensionLayout::eUnsigned:
+                for (std::size_t i = 0; i < count; ++i, data += stride)
+                    out[i] = static_cast<T>(load_unsigned(data, m_layout.byte_size));
+                break;
+            case DimensionLayout::eSigned:
+                for (std::size_t i = 0; i < count; ++i, data += stride)
+                    out[i] = static_cast<T>(load_signed(data, m_layout.byte_size));
+                break;
+            case DimensionLayout::eBits:
+                for (std::size_t i = 0; i < count; ++i, data += stride)
+                    out[i] = static_cast<T>((*data >> m_layout.shift) & m_layout.mask);
+                break;
+        }
+    }
+
+private:
+
+    static Dimension const& FindDimension(Schema const& schema, std::string const& name)
+    {
+        boost::optional<Dimension const&> dim = schema.GetDimension(name);
+        if (!dim)
+            throw liblas_error("DimensionAccessor: the schema has no dimension named '" + name + "'");
+        return *dim;
+    }
+
+    void CheckLength(std::size_t record_length) const
+    {
+        if (m_layout.byte_offset + m_layout.GetExtent() > record_length)
+            throw std::out_of_range("DimensionAccessor: dimension '" + m_dimension.GetName() + 
+                                    "' lies outside of the point record");
+    }
+
+    Dimension m_dimension;
+    detail::DimensionLayout m_layout;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_DIMENSIONACCESSOR_HPP_INCLUDED
@@ -45,10 +45,13 @@
 
 #include <liblas/reader.hpp>
 #include <liblas/writer.hpp>
+#include <liblas/sharedpagecache.hpp>
 #include <liblas/export.hpp>
 // boost
 #include <boost/cstdint.hpp>
 // std
+#include <iosfwd>
+#include <string>
 
 
 namespace liblas {
@@ -66,8 +69,44 @@ public:
 
     Reader CreateWithImpl(ReaderIPtr r);
     
+    /// Creates a reader for \a stream, compressed or not, that keeps up 
+    /// to \a cache_size points in memory in pages that are evicted least 
+    /// recently used first, so points that are read again, in order or 
+    /// with ReadPointAt, are not read from the stream again.  A 
+    /// \a cache_size of 0 caches the whole file.  Use CreateWithImpl with 
+    /// a detail::CachedReaderImpl directly to choose the page size or to 
+    /// get at its hit and miss counters.
     Reader CreateCached(std::istream& stream, boost::uint32_t cache_size);
+
+    /// Creates a reader for \a stream that keeps the pages it reads in 
+    /// \a cache, usually DefaultPageCache::get(), where every reader 
+    /// created with the same \a identity -- the file name, say -- finds 
+    /// them again.  \a cache must outlive the reader.
+    Reader CreateCached(std::istream& stream, std::string const& identity, SharedPageCache& cache);
+
+    /// Creates a reader that maps the point data of an uncompressed 
+    /// file into memory.  Random access with ReadPointAt and Seek 
+    /// involves no stream operations.
+    /// @exception configuration_error - if the file is compressed.
+    Reader CreateMapped(std::string const& filename);
+
     Reader CreateWithStream(std::istream& stream);
+
+    /// Creates a reader for \a stream that decompresses the chunks of a 
+    /// compressed file on \a decode_threads threads at once and hands 
+    /// the points out in file order.  Uncompressed files, and compressed 
+    /// ones written without chunks, are read as by CreateWithStream.
+    /// @exception configuration_error - if decode_threads is 0.
+    Reader CreateWithStream(std::istream& stream, std::size_t decode_threads);
+
+    /// Creates a reader for \a stream, compressed or not, that reads 
+    /// blocks of \a block_size points on a background thread and keeps 
+    /// up to \a depth blocks ahead of the caller.  Reader::GetPrefetchStats 
+    /// reports how often the caller had to wait for a block.
+    /// @exception configuration_error - if block_size or depth is 0.
+    Reader CreatePrefetched(std::istream& stream, 
+                            std::size_t block_size = 4096, 
+                            std::size_t depth = 2);
     
     // help function to create an input stream
     // returns NULL if failed to open
@@ -102,6 +141,42 @@ public:
 
     // makes a WriterImpl or a ZipWriterImpl, depending on header type
     static WriterIPtr CreateWithStream(std::ostream& stream, Header const& header); 
+
+    /// Makes a writer for \a stream that, if \a header asks for a 
+    /// chunked compressed file, compresses its chunks on 
+    /// \a encode_threads threads at once.  The file reads the same as 
+    /// one written on a single thread.  With \a chunk_summaries, the 
+    /// ranges of the coordinates, GPS times and classifications of 
+    /// every chunk are stored with the file, and readers with filters 
+    /// skip the chunks none of whose points can pass them.
+    /// @exception configuration_error - if encode_threads is 0.
+    static WriterIPtr CreateWithStream(std::ostream& stream, 
+                                       Header const& header, 
+                                       std::size_t encode_threads, 
+                                       bool chunk_summaries = false); 
+
+    /// Wraps \a writer so the points go to it on a background thread 
+    /// while the caller carries on.  The caller waits while more than 
+    /// \a queue_bytes bytes of records are waiting to be written.  
+    /// Errors are reported by a later call or by Writer::Flush.  Use a 
+    /// detail::AsyncWriterImpl directly to get at its stall counters.
+    /// @exception configuration_error - if queue_bytes is 0.
+    static WriterIPtr CreateAsync(WriterIPtr writer, 
+                                  std::size_t queue_bytes = 64 * 1024 * 1024);
+
+    /// Makes a writer that adds points described by \a header to the 
+    /// end of the uncompressed LAS file on \a stream, which must be open 
+    /// for reading and writing.  The points already in the file are not 
+    /// read or rewritten.  The file's point count, bounds and points by 
+    /// return are only updated in place once the writer is destroyed, so 
+    /// an append that does not finish leaves the old header valid, and 
+    /// the next append writes over whatever it left behind.  The writer 
+    /// is ready for points, its header is the file's.
+    /// @exception configuration_error - if the file is compressed.
+    /// @exception invalid_format - if \a header has another point 
+    /// format, schema, scale or offset than the file, or the file holds 
+    /// fewer points than its header says.
+    static WriterIPtr CreateAppend(std::iostream& stream, Header const& header);
     
     /// Destructor.
     /// @exception nothrow
@@ -43,14 +43,19 @@
 #define LIBLAS_LASFILTER_HPP_INCLUDED
 
 #include <liblas/version.hpp>
+#include <liblas/chunksummary.hpp>
+#include <liblas/dimensionaccessor.hpp>
 #include <liblas/header.hpp>
 #include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/detail/fwd.hpp>
 #include <liblas/export.hpp>
 // boost
+#include <boost/array.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 // std
 #include <vector>
@@ -59,6 +64,9 @@
 
 namespace liblas {
 
+/// One entry per point of a batch, nonzero for points that are kept.
+typedef std::vector<boost::uint8_t> SelectionMask;
+
 /// Defines public interface to LAS filter implementation.
 class LAS_DLL FilterI
 {
@@ -76,6 +84,22 @@ public:
     /// of filter to the point.  If the function returns true, the point 
     /// passes the filter and is kept.
     virtual bool filter(const Point& point) = 0;
+
+    /// Function called by the readers to filter a whole block of points 
+    /// at once.  Sets \a mask[i] to 1 for every point of \a points that 
+    /// passes the filter and to 0 otherwise, and returns the number of 
+    /// points that passed.  Points are presented in order, so the result 
+    /// must match calling filter() on each of them in turn.  The default 
+    /// implementation does exactly that; the built-in filters override it 
+    /// to work on the raw records.
+    virtual std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
+
+    /// Function called by the readers with the summary of a run of 
+    /// points stored with \a header, such as a compressed chunk, before 
+    /// decoding it.  Returns false only if no point within the ranges of 
+    /// \a summary can pass the filter, in which case the run is skipped.  
+    /// The default implementation keeps every run.
+    virtual bool filter_summary(ChunkSummary const& summary, Header const& header);
     
     /// Sets whether the filter is one that keeps data that matches 
     /// construction criteria or rejects them.
@@ -100,7 +124,10 @@ private:
 typedef boost::shared_ptr<FilterI> FilterPtr;
 
 /// A filter for keeping or rejecting points that fall within a 
-/// specified bounds.
+/// specified bounds.  The bounds are converted into raw integer 
+/// coordinates once for each header the points come with, so 
+/// points are tested without scaling their coordinates.  Bounds 
+/// with no Z extent keep points regardless of their Z value.
 class LAS_DLL BoundsFilter: public FilterI
 {
 public:
@@ -110,10 +137,25 @@ public:
     BoundsFilter(Bounds<double> const& b);
     bool filter(const Point& point);
 
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
+    bool filter_summary(ChunkSummary const& summary, Header const& header);
+
 private:
+
+    typedef boost::array<boost::int32_t, 3> raw_type;
     
+    bool Prepare(Header const* header);
+
     liblas::Bounds<double> bounds;
 
+    // Raw bounds cached for the last header seen
+    Header const* m_header;
+    boost::array<double, 3> m_scale;
+    boost::array<double, 3> m_offset;
+    raw_type m_raw_min;
+    raw_type m_raw_max;
+    bool m_raw;
+
     BoundsFilter(BoundsFilter const& other);
     BoundsFilter& operator=(BoundsFilter const& rhs);
 };
@@ -127,11 +169,20 @@ public:
 
     ClassificationFilter(class_list_type classes);
     bool filter(const Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
+    bool filter_summary(ChunkSummary const& summary, Header const& header);
     
 private:
 
+    void PrepareTable();
+
     class_list_type m_classes;
 
+    // filter() results for every classification byte, built for m_table_type
+    boost::array<boost::uint8_t, 256> m_table;
+    FilterType m_table_type;
+    bool m_table_ready;
+
     ClassificationFilter(ClassificationFilter const& other);
     ClassificationFilter& operator=(ClassificationFilter const& rhs);
 };
@@ -144,6 +195,7 @@ public:
     /// Default constructor.  Keep every thin'th point.
     ThinFilter(boost::uint32_t thin);
     bool filter(const liblas::Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
 
 
 private:
@@ -165,12 +217,18 @@ public:
 
     ReturnFilter(return_list_type returns, bool last_only);
     bool filter(const Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
     
 private:
 
     return_list_type m_returns;
     bool last_only;
 
+    // filter() results for every scan flags byte, built for m_table_type
+    boost::array<boost::uint8_t, 256> m_table;
+    FilterType m_table_type;
+    bool m_table_ready;
+
     ReturnFilter(ReturnFilter const& other);
     ReturnFilter& operator=(ReturnFilter const& rhs);
 };
@@ -182,14 +240,37 @@ public:
 
     ValidationFilter();
     bool filter(const Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
     
 private:
 
+    void PrepareTables();
+
+    // filter() results for every scan flags byte and every scan angle 
+    // byte, built for m_table_type
+    boost::array<boost::uint8_t, 256> m_flags;
+    boost::array<boost::uint8_t, 256> m_angles;
+    FilterType m_table_type;
+
     ValidationFilter(ValidationFilter const& other);
     ValidationFilter& operator=(ValidationFilter const& rhs);
 };
 
 
+namespace detail {
+
+/// True if \a f holds the member function \a getter of Point.
+template <typename T, typename R>
+inline bool is_point_getter(boost::function<T (const liblas::Point*)> const& f, 
+                            R (liblas::Point::*getter)() const)
+{
+    typedef R (liblas::Point::*getter_type)() const;
+    getter_type const* stored = f.template target<getter_type>();
+    return stored != 0 && *stored == getter;
+}
+
+} // namespace detail
+
 /// A templated class that allows you 
 /// to create complex filters using functions that are callable 
 /// from the liblas::Point class.  See laskernel.cpp for examples 
@@ -228,7 +309,9 @@ public:
     /// intensity_filter->SetType(liblas::FilterI::eInclusion);
     ContinuousValueFilter(filter_func f, T value, compare_func c)
         : liblas::FilterI(eInclusion), f(f), c(c),value(value)
-    {}
+    {
+        Resolve();
+    }
 
         
     /// Construct the filter with a filter_func and a simple 
@@ -308,6 +391,8 @@ public:
         
         value =  boost::lexical_cast<T>(out);
         // std::cout << "Value is: " << value << " pos " << pos << " out " << out << std::endl;
+
+        Resolve();
     }
             
     bool filter(const liblas::Point& p)
@@ -336,15 +421,149 @@ public:
         // std::cout << " returning " << output << std::endl;
         return output;
     }
+
+    /// Getters of the Point class that read a single dimension, such as 
+    /// &Point::GetIntensity or &Point::GetZ, are evaluated on the raw 
+    /// records using the offset of that dimension in the schema of the 
+    /// points, and std::less, std::greater, std::less_equal, 
+    /// std::greater_equal and std::equal_to are called directly.  Other 
+    /// functions can only be called with a Point, so one is filled in 
+    /// for every record.
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask)
+    {
+        std::size_t const count = points.size();
+        mask.resize(count);
+
+        if (0 == count)
+            return 0;
+
+        Header const* header = points.GetHeader();
+        boost::optional< Dimension const& > dim;
+        if (m_dimension && header)
+            dim = header->GetSchema().GetDimension(m_dimension);
+
+        if (!dim)
+        {
+            bool const inclusion = (GetType() == eInclusion);
+            std::size_t kept = 0;
+
+            Point p;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                points.GetPoint(i, p);
+                bool const keep = (c(f(&p), value) == inclusion);
+                mask[i] = keep ? 1 : 0;
+                kept += mask[i];
+            }
+            return kept;
+        }
+
+        m_values.resize(count);
+        std::size_t const stride = points.GetRecordLength();
+        boost::uint8_t const* data = points.GetRecord(0);
+        if (m_axis < 0)
+        {
+            DimensionAccessor<T> const accessor(*dim);
+            for (std::size_t i = 0; i < count; ++i, data += stride)
+                m_values[i] = accessor.Get(data);
+        }
+        else
+        {
+            // Scaled the same way as Point::GetX, GetY and GetZ
+            double const scales[3] = { header->GetScaleX(), header->GetScaleY(), header->GetScaleZ() };
+            double const offsets[3] = { header->GetOffsetX(), header->GetOffsetY(), header->GetOffsetZ() };
+            double const scale = scales[m_axis];
+            double const offset = offsets[m_axis];
+
+            DimensionAccessor<double> const accessor(*dim);
+            for (std::size_t i = 0; i < count; ++i, data += stride)
+                m_values[i] = static_cast<T>((accessor.Get(data) * scale) + offset);
+        }
+
+        switch (m_compare)
+        {
+            case eLess:         return Select(std::less<T>(), mask);
+            case eLessEqual:    return Select(std::less_equal<T>(), mask);
+            case eGreater:      return Select(std::greater<T>(), mask);
+            case eGreaterEqual: return Select(std::greater_equal<T>(), mask);
+            case eEqual:        return Select(std::equal_to<T>(), mask);
+            default:            return Select(c, mask);
+        }
+    }
     
 private:
 
     ContinuousValueFilter(ContinuousValueFilter const& other);
     ContinuousValueFilter& operator=(ContinuousValueFilter const& rhs);
+    enum Comparison
+    {
+        eCustom,
+        eLess,
+        eLessEqual,
+        eGreater,
+        eGreaterEqual,
+        eEqual
+    };
+
     filter_func f;
     compare_func c;
     T value;
 
+    // Dimension read by f, or 0 if f is not a known Point getter, and 
+    // the axis of X, Y or Z if f returns the scaled value.
+    char const* m_dimension;
+    int m_axis;
+    Comparison m_compare;
+    std::vector<T> m_values;
+
+    void Resolve()
+    {
+        using detail::is_point_getter;
+
+        m_dimension = 0;
+        m_axis = -1;
+
+        if (is_point_getter(f, &Point::GetX)) { m_dimension = "X"; m_axis = 0; }
+        else if (is_point_getter(f, &Point::GetY)) { m_dimension = "Y"; m_axis = 1; }
+        else if (is_point_getter(f, &Point::GetZ)) { m_dimension = "Z"; m_axis = 2; }
+        else if (is_point_getter(f, &Point::GetRawX)) m_dimension = "X";
+        else if (is_point_getter(f, &Point::GetRawY)) m_dimension = "Y";
+        else if (is_point_getter(f, &Point::GetRawZ)) m_dimension = "Z";
+        else if (is_point_getter(f, &Point::GetIntensity)) m_dimension = "Intensity";
+        else if (is_point_getter(f, &Point::GetReturnNumber)) m_dimension = "Return Number";
+        else if (is_point_getter(f, &Point::GetNumberOfReturns)) m_dimension = "Number of Returns";
+        else if (is_point_getter(f, &Point::GetScanDirection)) m_dimension = "Scan Direction";
+        else if (is_point_getter(f, &Point::GetFlightLineEdge)) m_dimension = "Flightline Edge";
+        else if (is_point_getter(f, &Point::GetScanAngleRank)) m_dimension = "Scan Angle Rank";
+        else if (is_point_getter(f, &Point::GetUserData)) m_dimension = "User Data";
+        else if (is_point_getter(f, &Point::GetPointSourceID)) m_dimension = "Point Source ID";
+        else if (is_point_getter(f, &Point::GetTime)) m_dimension = "Time";
+
+        if (c.template target< std::less<T> >()) m_compare = eLess;
+        else if (c.template target< std::less_equal<T> >()) m_compare = eLessEqual;
+        else if (c.template target< std::greater<T> >()) m_compare = eGreater;
+        else if (c.template target< std::greater_equal<T> >()) m_compare = eGreaterEqual;
+        else if (c.template target< std::equal_to<T> >()) m_compare = eEqual;
+        else m_compare = eCustom;
+    }
+
+    template <typename Compare>
+    std::size_t Select(Compare compare, SelectionMask& mask) const
+    {
+        boost::uint8_t const pass = (GetType() == eInclusion) ? 1 : 0;
+        boost::uint8_t const fail = static_cast<boost::uint8_t>(1 - pass);
+
+        std::size_t kept = 0;
+        std::size_t const count = m_values.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            boost::uint8_t const keep = compare(m_values[i], value) ? pass : fail;
+            mask[i] = keep;
+            kept += keep;
+        }
+        return kept;
+    }
+
     bool HasPredicate(std::string const& parse_string, std::string predicate)
     {
         // Check if the given string contains all of the characters of predicate
@@ -380,6 +599,7 @@ public:
                 liblas::Color::value_type low_green,
                 liblas::Color::value_type high_green);
     bool filter(const Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
     
 private:
     
@@ -391,6 +611,47 @@ private:
     bool DoExclude();
 };
 
+/// A filter built from a boolean expression over the point dimensions, 
+/// for example 
+///
+///   intensity > 200 && classification in (2, 9) && z between 100 and 300
+///
+/// Any dimension of the reader's Schema can be used by its name, with 
+/// case ignored and spaces written as underscores (return_number, 
+/// point_source_id, ...).  x, y and z are compared in scaled units and 
+/// classification is the class number without the flag bits.  Tests 
+/// are combined with &&/and, ||/or, !/not and parentheses.
+///
+/// The expression is parsed once, when the filter is constructed, and 
+/// compiled into instructions that compare whole blocks of raw records, 
+/// so one ExpressionFilter is much cheaper than a chain of 
+/// ContinuousValueFilter objects testing the same things.  An 
+/// eInclusion filter keeps the points the expression holds for, an 
+/// eExclusion filter drops them.  Throws liblas::invalid_expression if 
+/// the expression cannot be parsed; unknown dimension names are only 
+/// detected once the first points are filtered.
+class LAS_DLL ExpressionFilter: public FilterI
+{
+public:
+
+    ExpressionFilter(std::string const& expression);
+    ~ExpressionFilter();
+
+    std::string const& GetExpression() const;
+
+    bool filter(const Point& point);
+    std::size_t filter_batch(PointSpan const& points, SelectionMask& mask);
+    bool filter_summary(ChunkSummary const& summary, Header const& header);
+
+private:
+
+    boost::shared_ptr<detail::expression::Program> m_program;
+    SelectionMask m_single;
+
+    ExpressionFilter(ExpressionFilter const& other);
+    ExpressionFilter& operator=(ExpressionFilter const& rhs);
+};
+
 } // namespace liblas
 
 #endif // ndef LIBLAS_LASFILTER_HPP_INCLUDED
@@ -244,6 +244,9 @@ public:
     /// Set identifier of point data (record) format.
     void SetDataFormatId(PointFormatName v, const boost::uint16_t riegl_extra = 0);
 
+    /// Set the bit size of the point record schema.
+    void SetBitSize(std::size_t s);
+
     /// The length in bytes of each point.  All points in the file are 
     /// considered to be fixed in size, and the PointFormatName is used 
     /// to determine the fixed portion of the dimensions in the point.  Any 
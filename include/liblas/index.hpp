@@ -49,6 +49,9 @@
 #include <liblas/detail/index/indexcell.hpp>
 #include <liblas/export.hpp>
 
+// boost
+#include <boost/shared_ptr.hpp>
+
 // std
 #include <stdexcept> // std::out_of_range
 #include <cstdio>	// file io
@@ -76,6 +79,12 @@ typedef std::vector<boost::uint8_t> IndexVLRData;
 typedef std::vector<liblas::detail::IndexCell> IndexCellRow;
 typedef std::vector<IndexCellRow>	IndexCellDataBlock;
 
+namespace detail {
+class IndexBinner;
+} // namespace detail
+
+typedef std::vector<boost::shared_ptr<liblas::detail::IndexBinner> >	IndexBinnerList;
+
 class LAS_DLL IndexData;
 class LAS_DLL IndexIterator;
 
@@ -95,6 +104,10 @@ class LAS_DLL IndexIterator;
 // The user can constrain the memory used in building an index if that is believed to be an issue. 
 //		The results will be the same but some efficiency may be lost in the index building process.
 
+// Points can be sorted into cells on several threads while the index is built. Each thread keeps its own
+//		copy of the cell matrix and its own temp file, so memory use grows with the number of threads.
+//		Filter results are the same regardless of the number of threads used.
+
 //	Data stored in index header can be examined for determining suitability of index for desired purpose.
 //		1) presence of z-dimensional cell structure is indicated by GetCellsZ() called on the Index.
 //		2) Index author GetIndexAuthorStr() - provided by author at time of creation
@@ -118,6 +131,7 @@ class LAS_DLL IndexIterator;
 
 class LAS_DLL Index
 {
+friend class liblas::detail::IndexBinner;
 public:
 	Index();
     Index(IndexData const& ParamSrc);
@@ -136,12 +150,11 @@ private:
 	Header m_pointheader;
 	Header m_idxheader;
 	Bounds<double> m_bounds;
-	bool m_indexBuilt, m_tempFileStarted, m_readerCreated, m_readOnly, m_writestandaloneindex, m_forceNewIndex;
+	bool m_indexBuilt, m_readerCreated, m_readOnly, m_writestandaloneindex, m_forceNewIndex;
 	int m_debugOutputLevel;
 	boost::uint8_t m_versionMajor, m_versionMinor;
     boost::uint32_t m_pointRecordsCount, m_maxMemoryUsage, m_cellsX, m_cellsY, m_cellsZ, m_totalCells, 
-		m_DataVLR_ID;
-    liblas::detail::TempFileOffsetType m_tempFileWrittenBytes;
+		m_DataVLR_ID, m_buildThreads;
     double m_rangeX, m_rangeY, m_rangeZ, m_cellSizeZ, m_cellSizeX, m_cellSizeY;
 	std::string m_tempFileName;	
 	std::string m_indexAuthor;
@@ -149,7 +162,7 @@ private:
 	std::string m_indexDate;
 	std::vector<boost::uint32_t> m_filterResult;
 	std::ostream *m_ofs;
-    FILE *m_tempFile, *m_outputFile;
+    FILE *m_outputFile;
     FILE *m_debugger;
     
 	void SetValues(void);
@@ -178,15 +191,11 @@ private:
 	bool IdentifyCellZ(Point const& CurPt, boost::uint32_t& CurCellZ) const;
 	// Determines what quadrant sub-cell a point falls in
 	bool IdentifySubCell(Point const& CurPt, boost::uint32_t x, boost::uint32_t y, boost::uint32_t& CurSubCell) const;
-	// Offloads binned cell data while building Index when cell data in memory exceeds maximum set by user
-	bool PurgePointsToTempFile(IndexCellDataBlock& CellBlock);
-	// Reloads and examines one cell of data from temp file
-	bool LoadCellFromTempFile(liblas::detail::IndexCell *CellBlock, 
+	// Sorts all points into the cells of each binner, spreading the points over m_buildThreads threads
+	bool BinPoints(IndexBinnerList& Binners);
+	// Reloads and examines one cell of data from the temp files of all binners
+	bool LoadCellFromTempFile(IndexBinnerList const& Binners, liblas::detail::IndexCell *CellBlock, 
 		boost::uint32_t CurCellX, boost::uint32_t CurCellY);
-	// temp file is used to store sorted data while building index
-	FILE *OpenTempFile(void);
-	// closes and removes the temp file
-	void CloseTempFile(void);
 	// Creates a Writer from m_ofs and re-saves entire LAS input file with new index
 	// Current version does not save any data following the points
 	bool SaveIndexInLASFile(void);
@@ -255,6 +264,7 @@ public:
 	bool GetStandaloneIndex(void) const	{return m_writestandaloneindex;}
 	bool GetForceNewIndex(void) const	{return m_forceNewIndex;}
 	boost::uint32_t GetMaxMemoryUsage(void) const	{return m_maxMemoryUsage;}
+	boost::uint32_t GetBuildThreads(void) const	{return m_buildThreads;}
 	int GetDebugOutputLevel(void) const {return m_debugOutputLevel;}
 	// Not sure if these are more useful than dangerous
 	Header *GetPointHeader(void) {return &m_pointheader;}
@@ -319,6 +329,7 @@ public:
 // Options include:
 //		a) control the maximum memory used during the build process
 //			1) pass a value for maxmem in bytes greater than 0. 0 resolves to default LIBLAS_INDEX_MAXMEMDEFAULT.
+//			2) the memory is shared by the threads sorting points into cells, see f) below.
 //		b) debug messages generated during index creation or filtering. The higher the number, the more messages.
 //			0) no debug reports
 //			1) general info messages
@@ -335,6 +346,10 @@ public:
 //			3) Index creation date indexdate - provided by author at time of creation
 //			The fields are not validated in any way by the index building code and are just three fields 
 //			which can be used as the user sees fit. Maximum length is LIBLAS_INDEX_MAXSTRLEN - 1.
+//		f) control how many threads sort points into cells
+//			1) call SetBuildThreads with the number of threads. Default is 1.
+//			2) 0 resolves to the number of processors, boost::thread::hardware_concurrency().
+//			3) each thread after the first uses its own temp file, named tmpfilenme with the thread number appended.
 
 // Once an index is built, or if an index already exists, the IndexData can be configured
 //		to define the bounds of a filter operation. Any dimension whose bounds pair are equal will
@@ -421,7 +436,7 @@ protected:
 		m_LowZCellCompletelyIn, m_HighZCellCompletelyIn;
     boost::int32_t m_LowXBorderCell, m_HighXBorderCell, m_LowYBorderCell, m_HighYBorderCell,
 		m_LowZBorderCell, m_HighZBorderCell;
-	boost::uint32_t m_maxMemoryUsage;
+	boost::uint32_t m_maxMemoryUsage, m_buildThreads;
 	int m_debugOutputLevel;
 	bool m_noFilterX, m_noFilterY, m_noFilterZ, m_readOnly, m_writestandaloneindex, m_forceNewIndex, m_indexValid;
 	FILE *m_debugger;
@@ -436,6 +451,7 @@ public:
 	bool GetStandaloneIndex(void) const	{return m_writestandaloneindex;}
 	bool GetForceNewIndex(void) const	{return m_forceNewIndex;}
 	boost::uint32_t GetMaxMemoryUsage(void) const	{return m_maxMemoryUsage;}
+	boost::uint32_t GetBuildThreads(void) const	{return m_buildThreads;}
 	Reader *GetReader(void) const {return m_reader;}
 	int GetDebugOutputLevel(void) const {return m_debugOutputLevel;}
 	const char *GetTempFileName(void) const {return m_tempFileName;}
@@ -458,6 +474,7 @@ public:
 	void SetIndexDate(const char *indexdate)	{m_indexDate = indexdate;}
 	void SetCellSizeZ(double cellsizez)	{m_cellSizeZ = cellsizez;}
 	void SetMaxMem(boost::uint32_t maxmem)	{m_maxMemoryUsage = maxmem;}
+	void SetBuildThreads(boost::uint32_t buildthreads)	{m_buildThreads = buildthreads;}
 	void SetDebugOutputLevel(int debugoutputlevel)	{m_debugOutputLevel = debugoutputlevel;}
 	void SetReadOnly(bool readonly)	{m_readOnly = readonly;}
 	void SetStandaloneIndex(bool writestandaloneindex)	{m_writestandaloneindex = writestandaloneindex;}
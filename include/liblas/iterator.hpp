@@ -43,6 +43,7 @@
 #define LIBLAS_ITERATOR_HPP_INCLUDED
 
 #include <liblas/reader.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/writer.hpp>
 #include <liblas/index.hpp>
 #include <liblas/export.hpp>
@@ -56,6 +57,10 @@ namespace liblas {
 /// as well as apply STL algorithms that accept pair of input iterators.
 /// \sa About Input Iterator at http://www.sgi.com/tech/stl/InputIterator.html
 ///
+/// Records are fetched from the reader in blocks with 
+/// LASReader::ReadNextPoints, so the reader may be positioned up to 
+/// one block ahead of the iterator.  Copies of an iterator share the 
+/// same block and advance together.
 template <typename T>
 class LAS_DLL reader_iterator
 {
@@ -67,6 +72,9 @@ public:
     typedef T const& reference;
     typedef ptrdiff_t difference_type;
 
+    /// Number of records fetched from the reader at a time.
+    static const std::size_t block_size = 4096;
+
     /// Initializes iterator pointing to pass-the-end.
     reader_iterator()
         : m_reader(0)
@@ -76,33 +84,35 @@ public:
     /// No ownership transfer of reader object occurs.
     reader_iterator(liblas::Reader& reader)
         : m_reader(&reader)
+        , m_block(new block_type())
     {
         assert(0 != m_reader);
         getval();
     }
 
     /// Dereference operator.
-    /// It is implemented in terms of LASReader::GetPoint function.
+    /// It is implemented in terms of the current record of the block.
     reference operator*() const
     {
         assert(0 != m_reader);
         if (0 != m_reader)
         {
-            return m_reader->GetPoint();
+            return m_block->value;
         }
 
         throw std::runtime_error("reader is null and iterator not dereferencable");
     }
 
     /// Pointer-to-member operator.
-    /// It is implemented in terms of LASReader::GetPoint function.
+    /// It is implemented in terms of the current record of the block.
     pointer operator->() const
     {
         return &(operator*());
     }
 
     /// Pre-increment opertor.
-    /// Moves iterator to next record by calling LASReader::ReadNextPoint.
+    /// Moves iterator to next record, calling LASReader::ReadNextPoints 
+    /// once the current block is exhausted.
     reader_iterator& operator++()
     {
         assert(0 != m_reader);
@@ -111,7 +121,7 @@ public:
     }
 
     /// Post-increment opertor.
-    /// Moves iterator to next record by calling LASReader::ReadNextPoint.
+    /// Moves iterator to next record, see the pre-increment operator.
     reader_iterator operator++(int)
     {
         reader_iterator tmp(*this);
@@ -128,17 +138,42 @@ public:
 
 private:
 
+    struct block_type
+    {
+        block_type() : position(0) {}
+
+        liblas::PointBuffer buffer;
+        std::size_t position;
+        T value;
+    };
+
     void getval()
     {
-        if (0 != m_reader && !(m_reader->ReadNextPoint()))
+        if (0 == m_reader)
+            return;
+
+        if (m_block->position == m_block->buffer.size())
         {
-            m_reader = 0;
+            m_block->position = 0;
+            if (0 == m_reader->ReadNextPoints(m_block->buffer, block_size))
+            {
+                m_reader = 0;
+                m_block.reset();
+                return;
+            }
         }
+
+        m_block->buffer.GetPoint(m_block->position, m_block->value);
+        ++m_block->position;
     }
 
     liblas::Reader* m_reader;
+    boost::shared_ptr<block_type> m_block;
 };
 
+template <typename T>
+const std::size_t reader_iterator<T>::block_size;
+
 /// Equality operator implemented in terms of reader_iterator::equal
 template <typename T>
 bool operator==(reader_iterator<T> const& lhs, reader_iterator<T> const& rhs)
@@ -49,21 +49,31 @@
 #include <liblas/exception.hpp>
 #include <liblas/guid.hpp>
 #include <liblas/iterator.hpp>
+#include <liblas/mappedwriter.hpp>
 #include <liblas/bounds.hpp>
+#include <liblas/chunksummary.hpp>
 #include <liblas/classification.hpp>
 #include <liblas/color.hpp>
+#include <liblas/dimensionaccessor.hpp>
 #include <liblas/error.hpp>
 #include <liblas/filter.hpp>
 #include <liblas/header.hpp>
 #include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/pointdata.hpp>
+#include <liblas/pointtable.hpp>
 #include <liblas/reader.hpp>
 #include <liblas/schema.hpp>
+#include <liblas/schemaconverter.hpp>
+#include <liblas/sharedpagecache.hpp>
 #include <liblas/spatialreference.hpp>
+#include <liblas/splitwriter.hpp>
 #include <liblas/transform.hpp>
 #include <liblas/variablerecord.hpp>
 #include <liblas/version.hpp>
 #include <liblas/writer.hpp>
 #include <liblas/utility.hpp>
+#include <liblas/parallelreader.hpp>
 #include <liblas/detail/endian.hpp>
 #include <liblas/detail/private_utility.hpp>
 #include <liblas/capi/las_version.h>
@@ -221,7 +231,9 @@ public:
     virtual void SetHeader(liblas::Header const& header) = 0;
     virtual liblas::Point const& GetPoint() const = 0;
     virtual void ReadNextPoint() = 0;
+    virtual std::size_t ReadNextPoints(PointBuffer& buffer, std::size_t n) = 0;
     virtual Point const& ReadPointAt(std::size_t n) = 0;
+    virtual void ReadPointsAt(std::vector<boost::uint32_t> const& ids, PointBuffer& buffer, std::size_t gap) = 0;
     virtual void Seek(std::size_t n) = 0;
     
     virtual void Reset() = 0;
@@ -246,6 +258,8 @@ public:
     
     virtual void UpdatePointCount(boost::uint32_t count) = 0;
     virtual void WritePoint(const Point& point) = 0;
+    virtual void WritePoints(PointBuffer const& buffer) = 0;
+    virtual void Flush() = 0;
 
     virtual void SetFilters(std::vector<liblas::FilterPtr> const& filters) = 0;
     virtual void SetTransforms(std::vector<liblas::TransformPtr> const& transforms) = 0;
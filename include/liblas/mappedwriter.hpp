@@ -0,0 +1,139 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Preallocated memory-mapped LAS writer
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_MAPPEDWRITER_HPP_INCLUDED
+#define LIBLAS_MAPPEDWRITER_HPP_INCLUDED
+
+#include <liblas/header.hpp>
+#include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+// std
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace boost { namespace interprocess {
+class file_mapping;
+class mapped_region;
+}} // namespace boost::interprocess
+
+namespace liblas {
+
+namespace detail { namespace writer {
+class Header;
+}} // namespace detail::writer
+
+/// Writes an uncompressed file whose number of points is known up 
+/// front.  The header and VLRs are written and the file is sized once 
+/// when the MappedWriter is made, and the point records are then 
+/// written straight into a mapping of the file by their index.  There 
+/// is no shared stream, so any number of threads may write at once as 
+/// long as they write different records, for example the ranges handed 
+/// out by ParallelReader::ForEachBatchAt.
+///
+/// The bounds and points by return of the header are worked out from 
+/// the records written and stored when the writer is closed.  Records 
+/// that are never written are left zeroed.
+class LAS_DLL MappedWriter
+{
+public:
+
+    /// Makes \a filename, replacing any file of that name, to hold 
+    /// \a count points described by \a header.
+    /// @exception configuration_error - if \a header asks for compression.
+    /// @exception std::runtime_error - if the file cannot be made or mapped.
+    MappedWriter(std::string const& filename, Header const& header, boost::uint32_t count);
+
+    /// Closes the writer if Close has not been called, ignoring errors.
+    ~MappedWriter();
+
+    Header const& GetHeader() const { return m_header; }
+
+    boost::uint32_t GetPointCount() const { return m_count; }
+
+    /// Writes \a point as record \a index.
+    /// @exception std::out_of_range - if \a index is not below GetPointCount().
+    /// @exception std::invalid_argument - if the data of \a point is 
+    /// shorter than the records of the header.
+    void WritePoint(std::size_t index, Point const& point);
+
+    /// Writes the records of \a buffer as records \a index onwards.
+    /// @exception std::out_of_range - if the records run past GetPointCount().
+    /// @exception std::invalid_argument - if the records of \a buffer 
+    /// are not as long as those of the header.
+    void WritePoints(std::size_t index, PointBuffer const& buffer);
+
+    /// Flushes the records to the file and stores the bounds and points 
+    /// by return in its header.  No points can be written afterwards.
+    void Close();
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    MappedWriter(MappedWriter const& other);
+    MappedWriter& operator=(MappedWriter const& rhs);
+
+    boost::uint8_t* GetRecords(std::size_t index, std::size_t count);
+
+    std::string m_filename;
+    std::fstream m_ofs;
+    Header m_header;
+    boost::uint32_t m_count;
+    boost::uint32_t m_written;
+    std::size_t m_record_size;
+
+    boost::scoped_ptr<detail::writer::Header> m_header_writer;
+    boost::mutex m_mutex;
+
+    boost::scoped_ptr<boost::interprocess::file_mapping> m_mapping;
+    boost::scoped_ptr<boost::interprocess::mapped_region> m_region;
+    boost::uint8_t* m_data;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_MAPPEDWRITER_HPP_INCLUDED
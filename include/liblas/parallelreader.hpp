@@ -0,0 +1,171 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Multithreaded reading of disjoint point ranges
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_PARALLELREADER_HPP_INCLUDED
+#define LIBLAS_PARALLELREADER_HPP_INCLUDED
+
+#include <liblas/header.hpp>
+#include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace liblas {
+
+/// Reads an uncompressed file with several threads at once.  The point 
+/// records are split into one contiguous range per thread, and every 
+/// thread opens its own stream over its range and hands the points to 
+/// a callback in batches.  Batches from one thread arrive in file 
+/// order, but batches from different threads are delivered concurrently, 
+/// so callbacks must not share unprotected state.
+///
+/// The points in every batch refer to the ParallelReader's header, 
+/// which stays valid as long as the ParallelReader.
+class LAS_DLL ParallelReader
+{
+public:
+
+    /// Called with the index of the thread delivering the batch, 
+    /// in [0, GetThreadCount()), and the batch itself.
+    typedef boost::function<void (std::size_t, PointBuffer const&)> BatchCallback;
+
+    /// Called with the index of the thread delivering the batch, the 
+    /// index in the file of the first point of the batch, and the batch.
+    typedef boost::function<void (std::size_t, std::size_t, PointBuffer const&)> IndexedBatchCallback;
+
+    /// @exception configuration_error - if the file is compressed.
+    /// @exception std::runtime_error - if the file cannot be opened.
+    ParallelReader(std::string const& filename, std::size_t nthreads);
+
+    Header const& GetHeader() const { return m_header; }
+
+    std::size_t GetThreadCount() const { return m_threads; }
+
+    /// Number of points that will be read, which is smaller than the 
+    /// header's count if the file is cut short.
+    std::size_t GetPointCount() const { return m_count; }
+
+    /// Number of points delivered to a callback at a time.  Defaults to 4096.
+    void SetBatchSize(std::size_t size);
+    std::size_t GetBatchSize() const { return m_batch_size; }
+
+    /// Reads every point in the file and runs \a callback on each batch.  
+    /// Returns once all threads are done.  The first exception thrown by 
+    /// a thread or a callback stops the remaining threads and is reported 
+    /// as a std::runtime_error.
+    void ForEachBatch(BatchCallback const& callback);
+
+    /// Like ForEachBatch, but also tells \a callback where each batch 
+    /// starts, so the points can be written by index to a MappedWriter 
+    /// sized with GetPointCount().
+    void ForEachBatchAt(IndexedBatchCallback const& callback);
+
+    /// Folds every point into \a result using one copy of \a result per 
+    /// thread.  The copies are combined with Accumulator::Merge at the 
+    /// end.  \a result must not have seen any points yet, but may be 
+    /// configured beforehand, for example with Summary::SetHeader.  Any 
+    /// type with AddPoint(Point const&) and Merge(Accumulator const&) 
+    /// works, such as liblas::Summary and liblas::CoordinateSummary.
+    template <typename Accumulator>
+    void Reduce(Accumulator& result);
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    ParallelReader(ParallelReader const& other);
+    ParallelReader& operator=(ParallelReader const& rhs);
+
+    std::string m_filename;
+    Header m_header;
+    std::size_t m_threads;
+    std::size_t m_batch_size;
+    std::size_t m_count;
+};
+
+namespace detail {
+
+template <typename Accumulator>
+class BatchReducer
+{
+public:
+
+    explicit BatchReducer(std::vector<Accumulator>& partials) 
+        : m_partials(&partials) {}
+
+    void operator()(std::size_t thread, PointBuffer const& batch) const
+    {
+        Accumulator& partial = (*m_partials)[thread];
+
+        liblas::Point p;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            batch.GetPoint(i, p);
+            partial.AddPoint(p);
+        }
+    }
+
+private:
+
+    std::vector<Accumulator>* m_partials;
+};
+
+} // namespace detail
+
+template <typename Accumulator>
+void ParallelReader::Reduce(Accumulator& result)
+{
+    std::vector<Accumulator> partials(m_threads, result);
+
+    ForEachBatch(detail::BatchReducer<Accumulator>(partials));
+
+    for (typename std::vector<Accumulator>::const_iterator i = partials.begin(); i != partials.end(); ++i)
+        result.Merge(*i);
+}
+
+} // namespace liblas
+
+#endif // LIBLAS_PARALLELREADER_HPP_INCLUDED
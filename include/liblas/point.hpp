@@ -44,6 +44,7 @@
 
 #include <liblas/classification.hpp>
 #include <liblas/color.hpp>
+#include <liblas/pointdata.hpp>
 #include <liblas/schema.hpp>
 #include <liblas/detail/pointrecord.hpp>
 #include <liblas/detail/fwd.hpp>
@@ -198,25 +199,41 @@ public:
     bool IsValid() const;
 
 
-    std::vector<boost::uint8_t> const& GetData() const {return m_data; }
-    std::vector<boost::uint8_t> & GetData() {return m_data; }
-    void SetData(std::vector<boost::uint8_t> const& v) { m_data = v;}
+    PointData const& GetData() const {return m_data; }
+    PointData & GetData() {return m_data; }
+    void SetData(std::vector<boost::uint8_t> const& v) { m_data.assign(v.begin(), v.end());}
+    void SetData(PointData const& v) { m_data = v;}
+
+    /// Exchanges the data and header of this point with \a other without 
+    /// copying records stored on the heap.
+    void swap(Point& other);
     
     void SetHeader(Header const* header); 
     Header const* GetHeader() const;
     property_tree::ptree GetPTree() const;    
+
+    /// Value of dimension \a d of this point, held in the type the 
+    /// dimension is stored as (boost::uint16_t for Intensity, double for 
+    /// Time, boost::uint8_t for bit fields, and so on).  Use 
+    /// liblas::DimensionAccessor to read many points without boxing 
+    /// every value.
     boost::any GetValue(Dimension const& d) const;
 
 private:
 
-    std::vector<boost::uint8_t> m_data;
+    PointData m_data;
     
-    std::vector<boost::uint8_t>::size_type GetDimensionBytePosition(std::size_t dim_pos) const;
+    PointData::size_type GetDimensionBytePosition(std::size_t dim_pos) const;
     Header const* m_header;
     Header const& m_default_header;
 
 };
 
+inline void swap(Point& lhs, Point& rhs)
+{
+    lhs.swap(rhs);
+}
+
 /// Equal-to operator implemented in terms of Point::equal method.
 inline bool operator==(Point const& lhs, Point const& rhs)
 {
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Contiguous buffer of LAS point records
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_POINTBUFFER_HPP_INCLUDED
+#define LIBLAS_POINTBUFFER_HPP_INCLUDED
+
+#include <liblas/point.hpp>
+#include <liblas/detail/fwd.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <vector>
+
+namespace liblas {
+
+/// A block of point records stored back to back in their on-disk layout.
+/// All records in the buffer share one Header, which determines the 
+/// record length and how the bytes are interpreted.  Readers fill the 
+/// buffer with a single stream read instead of one read per point, and 
+/// individual records can be copied in and out of liblas::Point instances 
+/// with GetPoint and SetPoint.
+class LAS_DLL PointBuffer
+{
+public:
+
+    typedef std::vector<boost::uint8_t> data_type;
+
+    PointBuffer();
+
+    /// Construct an empty buffer that can hold \a capacity records 
+    /// described by \a header without reallocating.
+    PointBuffer(Header const* header, std::size_t capacity);
+
+    PointBuffer(PointBuffer const& other);
+    PointBuffer& operator=(PointBuffer const& rhs);
+    ~PointBuffer() {}
+
+    /// Sets the header describing the records in the buffer.  The 
+    /// buffer keeps its storage but is reinterpreted using the new 
+    /// record length, so existing records are only meaningful if the 
+    /// layout did not change.
+    void SetHeader(Header const* header);
+    Header const* GetHeader() const;
+
+    /// Length in bytes of a single record.
+    std::size_t GetRecordLength() const { return m_record_length; }
+
+    /// Number of records currently held in the buffer.
+    std::size_t size() const { return m_size; }
+
+    /// Number of records the buffer can hold without reallocating.
+    std::size_t capacity() const;
+
+    bool empty() const { return m_size == 0; }
+
+    void reserve(std::size_t n);
+    void resize(std::size_t n);
+    void clear() { m_size = 0; }
+    void swap(PointBuffer& other);
+
+    /// Raw access to the bytes of record \a i.
+    boost::uint8_t* GetRecord(std::size_t i) { return &m_data[0] + i * m_record_length; }
+    boost::uint8_t const* GetRecord(std::size_t i) const { return &m_data[0] + i * m_record_length; }
+
+    data_type const& GetData() const { return m_data; }
+    data_type& GetData() { return m_data; }
+
+    /// Copies record \a i into \a p.  \a p is associated with the 
+    /// buffer's header if it is not already.
+    void GetPoint(std::size_t i, Point& p) const;
+
+    /// Overwrites record \a i with the data of \a p.
+    void SetPoint(std::size_t i, Point const& p);
+
+    /// Appends the data of \a p to the end of the buffer.
+    void AddPoint(Point const& p);
+
+private:
+
+    data_type m_data;
+    Header const* m_header;
+    std::size_t m_record_length;
+    std::size_t m_size;
+};
+
+/// A read-only view of consecutive records of a PointBuffer, or of any 
+/// other block of records laid out as described by a header.  Spans 
+/// are cheap to copy and do not own the records they refer to.
+class LAS_DLL PointSpan
+{
+public:
+
+    /// View of every record in \a buffer.
+    PointSpan(PointBuffer const& buffer);
+
+    /// View of \a count records of \a buffer starting at \a first.
+    PointSpan(PointBuffer const& buffer, std::size_t first, std::size_t count);
+
+    /// View of \a count records at \a data laid out as described by 
+    /// \a header.
+    PointSpan(Header const* header, boost::uint8_t const* data, std::size_t count);
+
+    Header const* GetHeader() const { return m_header; }
+    std::size_t GetRecordLength() const { return m_record_length; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    boost::uint8_t const* GetRecord(std::size_t i) const { return m_data + i * m_record_length; }
+
+    /// Copies record \a i into \a p.  \a p is associated with the 
+    /// span's header if it is not already.
+    void GetPoint(std::size_t i, Point& p) const;
+
+private:
+
+    Header const* m_header;
+    boost::uint8_t const* m_data;
+    std::size_t m_record_length;
+    std::size_t m_size;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_POINTBUFFER_HPP_INCLUDED
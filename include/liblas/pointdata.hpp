@@ -0,0 +1,155 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Point record bytes with inline storage
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_POINTDATA_HPP_INCLUDED
+#define LIBLAS_POINTDATA_HPP_INCLUDED
+
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace liblas {
+
+/// Raw bytes of a single point record.  The interface is the subset of 
+/// std::vector<boost::uint8_t> that liblas::Point and its users need, but 
+/// records of up to inline_capacity bytes -- every standard point format 
+/// plus a reasonable amount of extra bytes -- are stored inside the object
+/// itself, so constructing, copying and assigning points does not touch 
+/// the heap.  Wider schemas fall back to a heap allocation.
+class LAS_DLL PointData
+{
+public:
+
+    typedef boost::uint8_t value_type;
+    typedef std::size_t size_type;
+    typedef value_type* iterator;
+    typedef value_type const* const_iterator;
+    typedef value_type& reference;
+    typedef value_type const& const_reference;
+
+    enum { inline_capacity = 64 };
+
+    PointData();
+    explicit PointData(size_type n, value_type value = 0);
+    PointData(std::vector<value_type> const& data);
+    PointData(PointData const& other);
+    PointData& operator=(PointData const& rhs);
+    ~PointData();
+
+    size_type size() const { return m_size; }
+    size_type capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    /// True if the bytes live on the heap rather than inside the object.
+    bool IsHeapAllocated() const { return m_begin != m_inline; }
+
+    iterator begin() { return m_begin; }
+    iterator end() { return m_begin + m_size; }
+    const_iterator begin() const { return m_begin; }
+    const_iterator end() const { return m_begin + m_size; }
+
+    value_type* data() { return m_begin; }
+    value_type const* data() const { return m_begin; }
+
+    reference operator[](size_type i) { return m_begin[i]; }
+    const_reference operator[](size_type i) const { return m_begin[i]; }
+    reference front() { return m_begin[0]; }
+    const_reference front() const { return m_begin[0]; }
+    reference back() { return m_begin[m_size - 1]; }
+    const_reference back() const { return m_begin[m_size - 1]; }
+
+    /// \exception std::out_of_range if \a i is not less than size().
+    reference at(size_type i);
+    const_reference at(size_type i) const;
+
+    /// Resizes the record to \a n bytes, keeping the first min(n, size()) 
+    /// bytes and setting any new ones to \a value.
+    void resize(size_type n, value_type value = 0);
+
+    /// Replaces the contents with \a n copies of \a value.
+    void assign(size_type n, value_type value);
+
+    /// Replaces the contents with the bytes in [first, last).
+    template <typename ForwardIterator>
+    void assign(ForwardIterator first, ForwardIterator last)
+    {
+        size_type const n = static_cast<size_type>(std::distance(first, last));
+        Reserve(n, false);
+        std::copy(first, last, m_begin);
+        m_size = n;
+    }
+
+    /// Exchanges contents with \a other.  Heap buffers change hands 
+    /// without copying.
+    void swap(PointData& other);
+
+    bool operator==(PointData const& other) const;
+    bool operator!=(PointData const& other) const { return !(*this == other); }
+
+    /// Copy of the bytes as a std::vector.
+    std::vector<value_type> ToVector() const;
+
+private:
+
+    // Makes room for at least n bytes, preserving the current contents 
+    // when keep is true.
+    void Reserve(size_type n, bool keep);
+
+    value_type* m_begin;
+    size_type m_size;
+    size_type m_capacity;
+    value_type m_inline[inline_capacity];
+};
+
+inline void swap(PointData& lhs, PointData& rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace liblas
+
+#endif // LIBLAS_POINTDATA_HPP_INCLUDED
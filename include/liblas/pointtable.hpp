@@ -0,0 +1,177 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Columnar table of LAS point dimensions
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#ifndef LIBLAS_POINTTABLE_HPP_INCLUDED
+#define LIBLAS_POINTTABLE_HPP_INCLUDED
+
+#include <liblas/pointbuffer.hpp>
+#include <liblas/detail/fwd.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <vector>
+
+namespace liblas {
+
+/// A batch of points stored as one contiguous array per dimension 
+/// instead of one interleaved record per point.  Records are decoded 
+/// from a PointBuffer a column at a time and X, Y and Z are scaled in 
+/// bulk, so code that only looks at a few dimensions can run simple 
+/// loops over the columns instead of calling Point accessors for 
+/// every point.  The table can be filled from any Reader and written 
+/// back through any Writer.
+///
+/// Only the standard dimensions of point formats 0-3 are held by the 
+/// table.  Extra bytes at the end of a record are not preserved.
+class LAS_DLL PointTable
+{
+public:
+
+    PointTable();
+    
+    /// Construct an empty table for points described by \a header.
+    explicit PointTable(Header const* header);
+
+    /// Sets the header the table's coordinates are scaled by.  
+    /// The table is cleared.
+    void SetHeader(Header const* header);
+    Header const* GetHeader() const { return m_header; }
+
+    std::size_t size() const { return m_raw_x.size(); }
+    bool empty() const { return m_raw_x.empty(); }
+    void clear();
+    void reserve(std::size_t n);
+
+    /// Appends the records in \a buffer, decoding each dimension into 
+    /// its column.  An empty table without a header adopts the 
+    /// buffer's header.
+    /// @exception liblas_error - if the buffer's header describes a 
+    /// different format or scaling than the table's.
+    void Append(PointBuffer const& buffer);
+
+    /// Reads up to \a n points from \a reader and appends them.
+    /// Returns the number of points appended, 0 at the end of the file.
+    std::size_t Read(Reader& reader, std::size_t n);
+
+    /// Encodes rows [first, first + count) into \a buffer, replacing 
+    /// its contents.  The buffer takes the table's header.
+    void Encode(PointBuffer& buffer, std::size_t first, std::size_t count) const;
+
+    /// Writes every row of the table through \a writer, a block of 
+    /// rows at a time with Writer::WritePoints.
+    void Write(Writer& writer) const;
+
+    /// Copies row \a i into \a p.  \a p is associated with the table's 
+    /// header if it is not already.
+    void GetPoint(std::size_t i, Point& p) const;
+
+    /// Appends the dimensions of \a p as a new row.  
+    void AddPoint(Point const& p);
+
+    bool HasTime() const { return m_has_time; }
+    bool HasColor() const { return m_has_color; }
+
+    std::vector<boost::int32_t> const& GetRawX() const { return m_raw_x; }
+    std::vector<boost::int32_t> const& GetRawY() const { return m_raw_y; }
+    std::vector<boost::int32_t> const& GetRawZ() const { return m_raw_z; }
+
+    /// Scaled and offset coordinates.
+    std::vector<double> const& GetX() const { return m_x; }
+    std::vector<double> const& GetY() const { return m_y; }
+    std::vector<double> const& GetZ() const { return m_z; }
+
+    std::vector<boost::uint16_t> const& GetIntensity() const { return m_intensity; }
+
+    /// Return number, number of returns, scan direction and flight 
+    /// line edge packed as they are in the record.
+    std::vector<boost::uint8_t> const& GetScanFlags() const { return m_flags; }
+    std::vector<boost::uint8_t> const& GetClassification() const { return m_classification; }
+    std::vector<boost::int8_t> const& GetScanAngleRank() const { return m_scan_angle; }
+    std::vector<boost::uint8_t> const& GetUserData() const { return m_user_data; }
+    std::vector<boost::uint16_t> const& GetPointSourceID() const { return m_point_source_id; }
+
+    /// Empty unless HasTime() is true.
+    std::vector<double> const& GetTime() const { return m_time; }
+
+    /// Empty unless HasColor() is true.
+    std::vector<boost::uint16_t> const& GetRed() const { return m_red; }
+    std::vector<boost::uint16_t> const& GetGreen() const { return m_green; }
+    std::vector<boost::uint16_t> const& GetBlue() const { return m_blue; }
+
+private:
+
+    void CheckHeader(Header const* header);
+    void Resize(std::size_t n);
+    void Decode(boost::uint8_t const* data, std::size_t stride, 
+                std::size_t first, std::size_t count);
+    void EncodeRow(std::size_t i, boost::uint8_t* record) const;
+    void Scale(std::size_t first);
+
+    Header const* m_header;
+    bool m_has_time;
+    bool m_has_color;
+    std::size_t m_color_offset;
+
+    std::vector<boost::int32_t> m_raw_x;
+    std::vector<boost::int32_t> m_raw_y;
+    std::vector<boost::int32_t> m_raw_z;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<boost::uint16_t> m_intensity;
+    std::vector<boost::uint8_t> m_flags;
+    std::vector<boost::uint8_t> m_classification;
+    std::vector<boost::int8_t> m_scan_angle;
+    std::vector<boost::uint8_t> m_user_data;
+    std::vector<boost::uint16_t> m_point_source_id;
+    std::vector<double> m_time;
+    std::vector<boost::uint16_t> m_red;
+    std::vector<boost::uint16_t> m_green;
+    std::vector<boost::uint16_t> m_blue;
+
+    PointBuffer m_buffer;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_POINTTABLE_HPP_INCLUDED
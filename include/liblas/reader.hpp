@@ -45,6 +45,7 @@
 
 #include <liblas/header.hpp>
 #include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/variablerecord.hpp>
 #include <liblas/spatialreference.hpp>
 #include <liblas/transform.hpp>
@@ -61,6 +62,25 @@
 
 namespace liblas {
 
+/// Counters of a reader created with ReaderFactory::CreatePrefetched.
+struct LAS_DLL PrefetchStats
+{
+    PrefetchStats() : blocks(0), stalls(0), stall_time(0.0), idle_time(0.0) {}
+
+    /// Number of blocks read ahead so far.
+    boost::uint64_t blocks;
+
+    /// Number of times the caller had to wait because no block was ready.
+    boost::uint64_t stalls;
+
+    /// Total time the caller spent waiting for blocks, in seconds.
+    double stall_time;
+
+    /// Total time the worker spent waiting for the caller to hand back 
+    /// a buffer, in seconds.  A large value means the read-ahead depth 
+    /// could be reduced.
+    double idle_time;
+};
 
 /// Defines public interface to LAS reader implementation.
 class LAS_DLL Reader
@@ -95,10 +115,38 @@ public:
     /// @exception may throw std::exception
     bool ReadNextPoint();
 
+    /// Fetches up to n of the next point records in file into buffer.
+    /// The records are read in large blocks and filters and transforms 
+    /// are applied to the whole block, which is considerably cheaper 
+    /// than calling ReadNextPoint n times.  The buffer is cleared and 
+    /// associated with the header of the records it holds.
+    /// @return number of records stored in buffer, 0 once the end 
+    /// of the file is reached.
+    /// @exception may throw std::exception
+    std::size_t ReadNextPoints(PointBuffer& buffer, std::size_t n);
+
     /// Fetches n-th point record from file.
     /// @exception may throw std::exception
     bool ReadPointAt(std::size_t n);
 
+    /// Number of unrequested records ReadPointsAt reads through rather 
+    /// than seeking past them.
+    static const std::size_t default_gap = 256;
+
+    /// Fetches the point records with the given ids into buffer, in the 
+    /// order of ids, which need not be sorted and may repeat.  Ids no 
+    /// more than \a gap records apart are read in one run with a single 
+    /// seek, and a compressed file decompresses each chunk it needs only 
+    /// once, so this is much faster than calling ReadPointAt for every 
+    /// id.  Like ReadPointAt, transforms are applied and filters are 
+    /// not.  Seek or Reset before reading on with ReadNextPoint.
+    /// @return false if the file holds fewer points than its header 
+    /// claims.
+    /// @exception std::out_of_range if an id is not less than the 
+    /// number of points.
+    bool ReadPointsAt(std::vector<boost::uint32_t> const& ids, PointBuffer& buffer, 
+                      std::size_t gap = default_gap);
+
     /// Reinitializes state of the reader.
     /// @exception may throw std::exception
     void Reset();
@@ -132,6 +180,11 @@ public:
     /// Gets the list of transforms to be applied to points as they are read
     std::vector<liblas::TransformPtr> GetTransforms() const;
 
+    /// Gets the read-ahead counters of a reader created with 
+    /// ReaderFactory::CreatePrefetched.  All counters are zero for 
+    /// readers that do not read ahead.
+    PrefetchStats GetPrefetchStats() const;
+
 private:
 
 
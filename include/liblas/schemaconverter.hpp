@@ -0,0 +1,206 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Conversion of point records between schemas
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_SCHEMACONVERTER_HPP_INCLUDED
+#define LIBLAS_SCHEMACONVERTER_HPP_INCLUDED
+
+#include <liblas/dimensionaccessor.hpp>
+#include <liblas/header.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/schema.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace liblas {
+
+/// Converts point records laid out by one schema into records laid out 
+/// by another, for example when the point format of a file is changed or 
+/// a transform gives points a new header.  Dimensions are matched by 
+/// name.  The work needed for each one -- a byte copy, a bit mask, a 
+/// numeric conversion or a change of X, Y and Z scale and offset -- is 
+/// worked out once, when the converter is constructed, and then applied 
+/// to any number of records.  Adjacent byte copies are merged, so 
+/// converting between compatible formats is mostly a few memcpy calls.  
+/// Target dimensions that the source does not have are zeroed.
+///
+/// X, Y and Z are rescaled with integer arithmetic when one scale is an 
+/// integer multiple of the other and the offsets differ by a whole 
+/// number of steps, and through double otherwise, rounding the same way 
+/// as Point::SetX.
+class LAS_DLL SchemaConverter
+{
+public:
+
+    /// Converter from records described by \a source to records 
+    /// described by \a target, including any change of scale and offset.
+    SchemaConverter(Header const& source, Header const& target);
+
+    /// Converter between two schemas that share the same scale and 
+    /// offset, so X, Y and Z are copied unchanged.
+    SchemaConverter(Schema const& source, Schema const& target);
+
+    std::size_t GetSourceRecordLength() const { return m_source_length; }
+    std::size_t GetTargetRecordLength() const { return m_target_length; }
+
+    /// True if converting a record is a plain copy of all its bytes.
+    bool IsIdentity() const;
+
+    /// True if the converter was built for headers with the same 
+    /// dimensions, record layout, scale and offset as \a source and 
+    /// \a target.
+    bool Matches(Header const& source, Header const& target) const;
+
+    /// Converts \a count records stored back to back at \a source into 
+    /// \a target.  The two ranges must not overlap.
+    void Convert(boost::uint8_t const* source, 
+                 boost::uint8_t* target, 
+                 std::size_t count) const;
+
+    /// Converts every record of \a source and stores the result in 
+    /// \a target, which is resized to the same number of records.  
+    /// Throws liblas_error if \a target has no header or a record length 
+    /// other than GetTargetRecordLength().
+    void Convert(PointSpan const& source, PointBuffer& target) const;
+
+private:
+
+    // What the conversion plan depends on for one dimension.
+    struct DimensionKey
+    {
+        explicit DimensionKey(Dimension const& d);
+
+        bool Matches(Dimension const& d) const;
+
+        std::string name;
+        std::size_t byte_offset;
+        std::size_t bit_offset;
+        std::size_t bit_size;
+        bool numeric;
+        bool is_signed;
+        bool integer;
+    };
+
+    static void StoreLayout(Schema const& schema, std::vector<DimensionKey>& layout);
+    static bool SameLayout(std::vector<DimensionKey> const& layout, Schema const& schema);
+
+    struct CopyStep
+    {
+        std::size_t source;
+        std::size_t target;
+        std::size_t size;
+
+        bool operator<(CopyStep const& other) const { return target < other.target; }
+    };
+
+    // Bits of the target byte selected by mask come from the source 
+    // byte shifted right by shift (left when shift is negative).
+    struct MaskStep
+    {
+        std::size_t source;
+        std::size_t target;
+        int shift;
+        boost::uint8_t mask;
+    };
+
+    struct ScaleStep
+    {
+        enum Mode
+        {
+            eMultiply,
+            eDivide,
+            eReal
+        };
+
+        std::size_t source;
+        std::size_t target;
+        Mode mode;
+        boost::int64_t factor;
+        boost::int64_t delta;
+        double source_scale;
+        double source_offset;
+        double target_scale;
+        double target_offset;
+    };
+
+    typedef std::pair< DimensionAccessor<boost::int64_t>, 
+                       DimensionAccessor<boost::int64_t> > IntegerStep;
+    typedef std::pair< DimensionAccessor<double>, 
+                       DimensionAccessor<double> > RealStep;
+
+    void Compile(Schema const& source, Schema const& target, 
+                 double const* source_scale, double const* source_offset,
+                 double const* target_scale, double const* target_offset);
+    void AddCopy(std::size_t source, std::size_t target, std::size_t size);
+    void AddBits(detail::DimensionLayout const& source, 
+                 detail::DimensionLayout const& target);
+    void AddScale(Dimension const& source, Dimension const& target, 
+                  double source_scale, double source_offset,
+                  double target_scale, double target_offset);
+
+    std::size_t m_source_length;
+    std::size_t m_target_length;
+    PointFormatName m_source_format;
+    PointFormatName m_target_format;
+    bool m_zero_fill;
+    double m_source_scale[3];
+    double m_source_offset[3];
+    double m_target_scale[3];
+    double m_target_offset[3];
+    std::vector<DimensionKey> m_source_layout;
+    std::vector<DimensionKey> m_target_layout;
+
+    std::vector<CopyStep> m_copies;
+    std::vector<MaskStep> m_masks;
+    std::vector<ScaleStep> m_scales;
+    std::vector<IntegerStep> m_integers;
+    std::vector<RealStep> m_reals;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_SCHEMACONVERTER_HPP_INCLUDED
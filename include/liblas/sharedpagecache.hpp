@@ -0,0 +1,183 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Point page cache shared between readers and threads
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_SHAREDPAGECACHE_HPP_INCLUDED
+#define LIBLAS_SHAREDPAGECACHE_HPP_INCLUDED
+
+#include <liblas/pointbuffer.hpp>
+#include <liblas/detail/singleton.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+// std
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace liblas {
+
+namespace detail {
+class PageCache;
+}
+
+/// A cache of point record pages that any number of readers, on any 
+/// number of threads, can share.  Pages are keyed by file and page 
+/// number.  Files are identified by a string registered with GetFileId, 
+/// typically the file name, so readers of the same file opened at 
+/// different times find each other's pages.
+///
+/// The pages are spread over a number of stripes, each with its own lock 
+/// and least recently used list and an equal share of the byte budget, 
+/// so readers working on different pages rarely wait for each other.
+///
+/// \code
+/// std::ifstream ifs("tile.las", std::ios::in | std::ios::binary);
+/// liblas::Reader reader = factory.CreateCached(ifs, "tile.las", 
+///                                              liblas::DefaultPageCache::get());
+/// \endcode
+class LAS_DLL SharedPageCache
+{
+public:
+
+    typedef boost::shared_ptr<liblas::PointBuffer> PagePtr;
+
+    /// Counters of the cache as a whole.
+    struct Stats
+    {
+        Stats();
+
+        boost::uint64_t hits;
+        boost::uint64_t misses;
+        boost::uint64_t evictions;
+
+        /// Bytes of records handed out from the cache instead of read 
+        /// from a file.
+        boost::uint64_t bytes_served;
+
+        std::size_t pages;
+        std::size_t bytes;
+        std::size_t budget;
+
+        /// Fraction of lookups that found their page, 0 if there were 
+        /// none.
+        double GetHitRatio() const;
+    };
+
+    /// Budget and stripe count used by the default constructor.
+    static const std::size_t default_budget = 256 * 1024 * 1024;
+    static const std::size_t default_stripes = 16;
+
+    SharedPageCache();
+
+    /// Cache holding up to \a budget bytes of records spread over 
+    /// \a stripes independently locked stripes.  A budget of 0 means no 
+    /// limit.
+    /// @exception configuration_error if \a stripes is 0.
+    SharedPageCache(std::size_t budget, std::size_t stripes);
+
+    ~SharedPageCache();
+
+    /// Number that identifies the file called \a identity in Find and 
+    /// Insert.  The same identity always gives the same number.
+    boost::uint64_t GetFileId(std::string const& identity);
+
+    /// Page \a page of \a file, or a null pointer if it is not cached.
+    PagePtr Find(boost::uint64_t file, std::size_t page);
+
+    /// Adds \a data as page \a page of \a file.  The page must not be 
+    /// modified once it has been added.
+    void Insert(boost::uint64_t file, std::size_t page, PagePtr data);
+
+    /// Drops all pages.  The counters are kept.
+    void Clear();
+
+    std::size_t GetBudget() const;
+    void SetBudget(std::size_t budget);
+
+    std::size_t GetStripeCount() const { return m_stripes.size(); }
+
+    Stats GetStats() const;
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    SharedPageCache(SharedPageCache const& other);
+    SharedPageCache& operator=(SharedPageCache const& rhs);
+
+    struct Stripe
+    {
+        Stripe(std::size_t budget);
+
+        mutable boost::mutex mutex;
+        boost::shared_ptr<detail::PageCache> cache;
+    };
+
+    typedef boost::shared_ptr<Stripe> StripePtr;
+
+    void Initialize(std::size_t budget, std::size_t stripes);
+    Stripe& GetStripe(boost::uint64_t file, std::size_t page) const;
+
+    std::vector<StripePtr> m_stripes;
+    std::size_t m_budget;
+
+    mutable boost::mutex m_files_mutex;
+    std::map<std::string, boost::uint64_t> m_files;
+};
+
+/// The process-wide SharedPageCache, with the default budget.
+class LAS_DLL DefaultPageCache : public Singleton<SharedPageCache>
+{
+public:
+    ~DefaultPageCache() {}
+
+protected:
+    DefaultPageCache();
+    DefaultPageCache(DefaultPageCache const&);
+    DefaultPageCache& operator=(DefaultPageCache const&);
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_SHAREDPAGECACHE_HPP_INCLUDED
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Writing points to a series of files of bounded size
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifndef LIBLAS_SPLITWRITER_HPP_INCLUDED
+#define LIBLAS_SPLITWRITER_HPP_INCLUDED
+
+#include <liblas/header.hpp>
+#include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/writer.hpp>
+#include <liblas/export.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+// std
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
+#include <string>
+
+namespace liblas {
+
+/// Writes a stream of points to a series of files, or parts, of at most 
+/// a given number of points each.  Part n is named prefix-n followed by 
+/// the extension, counting from 1.
+///
+/// Every part is written on its own background thread, and a compressed 
+/// part is compressed on the encode threads of its own writer, so a full 
+/// part finishes while the next one is being filled.  Up to 
+/// GetOpenParts() parts are kept open at once; starting one more waits 
+/// for the oldest to finish.  Each part's header gets its bounds and 
+/// points by return from the points written to it.
+class LAS_DLL SplitWriter
+{
+public:
+
+    /// @exception configuration_error - if part_size is 0.
+    SplitWriter(std::string const& prefix, 
+                std::string const& extension, 
+                Header const& header, 
+                boost::uint32_t part_size);
+
+    /// Closes the writer if Close has not been called, ignoring errors.
+    ~SplitWriter();
+
+    Header const& GetHeader() const { return m_header; }
+
+    boost::uint32_t GetPartSize() const { return m_part_size; }
+
+    /// Number of parts started so far
+    std::size_t GetPartCount() const { return m_part_count; }
+
+    /// Number of threads compressing each part, for headers asking 
+    /// for compression.  Defaults to 1.  Set before writing any point.
+    /// @exception configuration_error - if threads is 0.
+    void SetEncodeThreads(std::size_t threads);
+    std::size_t GetEncodeThreads() const { return m_encode_threads; }
+
+    /// Whether compressed parts store chunk summaries.  Defaults to false.
+    void SetChunkSummaries(bool summaries) { m_chunk_summaries = summaries; }
+    bool GetChunkSummaries() const { return m_chunk_summaries; }
+
+    /// Number of parts that may be open at once.  Defaults to 4.
+    /// @exception configuration_error - if parts is 0.
+    void SetOpenParts(std::size_t parts);
+    std::size_t GetOpenParts() const { return m_open_parts; }
+
+    void WritePoint(Point const& point);
+
+    /// Writes the records of \a buffer, spread over as many parts as 
+    /// they need.
+    void WritePoints(PointBuffer const& buffer);
+
+    /// Waits for every part to be written and closes it.  Reports the 
+    /// first error of any part.  If no point was written, an empty 
+    /// first part is made.
+    void Close();
+
+private:
+
+    // Blocked copying operations, declared but not defined.
+    SplitWriter(SplitWriter const& other);
+    SplitWriter& operator=(SplitWriter const& rhs);
+
+    struct Part
+    {
+        boost::shared_ptr<std::ostream> ofs;
+        boost::shared_ptr<Writer> writer;
+    };
+
+    /// Returns the writer of the part being filled, starting a new 
+    /// part if it is full.
+    Writer& GetWriter();
+    void StartPart();
+    void FinishPart();
+
+    std::string m_prefix;
+    std::string m_extension;
+    Header m_header;
+    boost::uint32_t m_part_size;
+    std::size_t m_encode_threads;
+    bool m_chunk_summaries;
+    std::size_t m_open_parts;
+
+    std::deque<Part> m_parts;
+    std::size_t m_part_count;
+    boost::uint32_t m_part_points;
+    bool m_closed;
+
+    PointBuffer m_slice;
+};
+
+} // namespace liblas
+
+#endif // LIBLAS_SPLITWRITER_HPP_INCLUDED
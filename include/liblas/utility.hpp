@@ -74,10 +74,17 @@ public:
     void AddPoint(liblas::Point const& p);
     ptree GetPTree() const;
     void SetHeader(liblas::Header const& h);
+
+    /// Adds the points summarized by \a other, which must come from 
+    /// data with the same scale and offset.  Used to combine partial 
+    /// summaries computed in parallel.
+    void Merge(Summary const& other);
     
     ~Summary() {}
 private:
 
+    void UpdateExtremes(liblas::Point const& p);
+
     classes_type classes;
     boost::uint32_t synthetic;
     boost::uint32_t withheld;
@@ -106,6 +113,10 @@ public:
     void AddPoint(liblas::Point const& p);
     ptree GetPTree() const;
     void SetHeader(liblas::Header const& h);
+
+    /// Adds the points summarized by \a other, which must come from 
+    /// data with the same scale and offset.
+    void Merge(CoordinateSummary const& other);
     
     ~CoordinateSummary() {}
     
@@ -45,6 +45,7 @@
 #include <liblas/version.hpp>
 #include <liblas/header.hpp>
 #include <liblas/point.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/transform.hpp>
 #include <liblas/filter.hpp>
 #include <liblas/export.hpp>
@@ -90,6 +91,24 @@ public:
     /// \todo TODO: How to handle point_source_id in portable way, for LAS 1.0 and 1.1
     bool WritePoint(Point const& point);
 
+    /// Writes every record of buffer in one go: a single stream write 
+    /// for uncompressed files, a single batch for the compressor.  The 
+    /// point count is updated once for the whole block.  This is 
+    /// considerably cheaper than calling WritePoint for each record.
+    /// @exception std::invalid_argument - if the records of the buffer 
+    /// are not laid out as described by the writer's header.
+    void WritePoints(PointBuffer const& buffer);
+
+    /// Writes every row of table, encoded a block at a time.
+    void WritePoints(PointTable const& table);
+
+    /// Hands every point written so far to the output stream and flushes 
+    /// it.  Writers that write on a background thread wait for it to 
+    /// catch up, and report any error it ran into.  Compressed points 
+    /// of an unfinished chunk stay with the compressor.
+    /// @exception std::runtime_error - if writing failed.
+    void Flush();
+
     /// Allow in-place writing of header
     void WriteHeader();
 
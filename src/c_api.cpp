@@ -568,11 +568,11 @@ LAS_DLL LASErrorEnum LASPoint_SetData(LASPointH hPoint, unsigned char* data) {
         liblas::Header const* h = p->GetHeader();
         size = h->GetDataRecordLength();
         
-        std::vector<boost::uint8_t> & d = p->GetData();
+        liblas::PointData & d = p->GetData();
         if (d.size() != size)
         {
             d.resize(size);
-            d.assign(static_cast<boost::uint32_t>(0), d.size());
+            d.assign(size, 0);
         }
                 
         for (boost::uint16_t i=0; i < size; i++) {
@@ -596,7 +596,7 @@ LAS_DLL LASErrorEnum LASPoint_GetData( const LASPointH hPoint, boost::uint8_t* d
     try {
         liblas::Point* p = ((liblas::Point*) hPoint);
         boost::uint16_t size = 0;
-        std::vector<boost::uint8_t> const& d = p->GetData();
+        liblas::PointData const& d = p->GetData();
 
         liblas::Header const* h = p->GetHeader();
         size = h->GetDataRecordLength();
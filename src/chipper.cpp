@@ -195,16 +195,24 @@ int Chipper::Load()
     if (Allocate())
         return -1;
     count = 0;
-    while (m_reader->ReadNextPoint()) {
-        const liblas::Point& pt = m_reader->GetPoint();
 
-        ref.m_pos = pt.GetX();
-        ref.m_ptindex = count;
-        m_xvec.push_back(ref);
-
-        ref.m_pos = pt.GetY();
-        m_yvec.push_back(ref);
-        count++;
+    // Only X and Y are needed, so decode a block of points at a time 
+    // into columns and walk those.
+    liblas::PointTable table;
+    while (table.Read(*m_reader, 4096)) {
+        const vector<double>& x = table.GetX();
+        const vector<double>& y = table.GetY();
+
+        for (size_t i = 0; i < table.size(); ++i) {
+            ref.m_pos = x[i];
+            ref.m_ptindex = count;
+            m_xvec.push_back(ref);
+
+            ref.m_pos = y[i];
+            m_yvec.push_back(ref);
+            count++;
+        }
+        table.clear();
     }
     // Sort xvec and assign other index in yvec to sorted indices in xvec.
     sort(m_xvec.begin(), m_xvec.end());
@@ -0,0 +1,271 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Ranges of values found in a run of point records
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/chunksummary.hpp>
+#include <liblas/variablerecord.hpp>
+#include <liblas/detail/binary.hpp>
+#include <liblas/detail/chunksummary.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace liblas {
+
+namespace {
+
+template <typename T>
+inline T load(boost::uint8_t const* data)
+{
+    detail::binary::endian_value<T> value;
+    value.template load<detail::binary::little_endian_tag>(data);
+    return value;
+}
+
+template <typename T>
+inline void store(boost::uint8_t* data, T value)
+{
+    detail::binary::endian_value<T> v(value);
+    v.template store<detail::binary::little_endian_tag>(data);
+}
+
+inline double load_double(boost::uint8_t const* data)
+{
+    boost::uint64_t const bits = load<boost::uint64_t>(data);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline void store_double(boost::uint8_t* data, double value)
+{
+    boost::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(value));
+    store<boost::uint64_t>(data, bits);
+}
+
+std::string const chunk_summary_user_id("liblas");
+std::string const chunk_summary_description("Chunk summaries");
+
+boost::uint16_t const chunk_summary_version = 1;
+std::size_t const chunk_summary_vlr_size = 20;
+
+} // namespace
+
+ChunkSummary::ChunkSummary()
+    : count(0)
+    , has_time(false)
+    , min_time(0.0)
+    , max_time(0.0)
+{
+    min.assign((std::numeric_limits<boost::int32_t>::max)());
+    max.assign((std::numeric_limits<boost::int32_t>::min)());
+}
+
+void ChunkSummary::Add(boost::uint8_t const* data, bool has_time)
+{
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        boost::int32_t const v = load<boost::int32_t>(data + 4 * i);
+        if (v < min[i]) min[i] = v;
+        if (v > max[i]) max[i] = v;
+    }
+
+    classifications.set(data[15]);
+
+    if (has_time)
+    {
+        double const t = load_double(data + 20);
+        if (!this->has_time || t < min_time) min_time = t;
+        if (!this->has_time || t > max_time) max_time = t;
+        this->has_time = true;
+    }
+
+    ++count;
+}
+
+void ChunkSummary::Merge(ChunkSummary const& other)
+{
+    if (other.empty())
+        return;
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (other.min[i] < min[i]) min[i] = other.min[i];
+        if (other.max[i] > max[i]) max[i] = other.max[i];
+    }
+
+    classifications |= other.classifications;
+
+    if (other.has_time)
+    {
+        if (!has_time || other.min_time < min_time) min_time = other.min_time;
+        if (!has_time || other.max_time > max_time) max_time = other.max_time;
+        has_time = true;
+    }
+
+    count += other.count;
+}
+
+namespace detail {
+
+bool IsChunkSummaryVLR(VariableRecord const& vlr)
+{
+    return chunk_summary_user_id == vlr.GetUserId(true).c_str() && 
+           chunk_summary_record_id == vlr.GetRecordId();
+}
+
+VariableRecord MakeChunkSummaryVLR(ChunkSummaryLocation const& location)
+{
+    std::vector<boost::uint8_t> data(chunk_summary_vlr_size);
+    store<boost::uint16_t>(&data[0], chunk_summary_version);
+    store<boost::uint16_t>(&data[2], 0);
+    store<boost::uint32_t>(&data[4], location.chunk_size);
+    store<boost::uint32_t>(&data[chunk_summary_count_position], location.count);
+    store<boost::uint64_t>(&data[12], location.offset);
+
+    VariableRecord v;
+    v.SetReserved(0xAABB);
+    v.SetUserId(chunk_summary_user_id);
+    v.SetRecordId(chunk_summary_record_id);
+    v.SetDescription(chunk_summary_description);
+    v.SetData(data);
+    v.SetRecordLength(static_cast<boost::uint16_t>(data.size()));
+    return v;
+}
+
+bool ReadChunkSummaryVLR(VariableRecord const& vlr, ChunkSummaryLocation& location)
+{
+    if (!IsChunkSummaryVLR(vlr))
+        return false;
+
+    std::vector<boost::uint8_t> const& data = vlr.GetData();
+    if (data.size() < chunk_summary_vlr_size)
+        return false;
+    if (load<boost::uint16_t>(&data[0]) != chunk_summary_version)
+        return false;
+
+    location.chunk_size = load<boost::uint32_t>(&data[4]);
+    location.count = load<boost::uint32_t>(&data[chunk_summary_count_position]);
+    location.offset = load<boost::uint64_t>(&data[12]);
+    return true;
+}
+
+// Every summary is stored as
+//
+//   uint32 count, int32 min[3], int32 max[3], float64 min_time, 
+//   float64 max_time, uint8 classifications[32], uint8 flags, 
+//   uint8 reserved[3]
+//
+// with bit 0 of flags telling whether the time range is set.
+
+void WriteChunkSummaries(std::ostream& ofs, std::vector<ChunkSummary> const& summaries)
+{
+    std::vector<boost::uint8_t> data(chunk_summary_record_size * summaries.size());
+
+    for (std::size_t s = 0; s < summaries.size(); ++s)
+    {
+        ChunkSummary const& summary = summaries[s];
+        boost::uint8_t* p = &data[s * chunk_summary_record_size];
+
+        store<boost::uint32_t>(p, summary.count);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            store<boost::int32_t>(p + 4 + 4 * i, summary.min[i]);
+            store<boost::int32_t>(p + 16 + 4 * i, summary.max[i]);
+        }
+        store_double(p + 28, summary.min_time);
+        store_double(p + 36, summary.max_time);
+        for (std::size_t b = 0; b < summary.classifications.size(); ++b)
+        {
+            if (summary.classifications.test(b))
+                p[44 + b / 8] |= static_cast<boost::uint8_t>(1 << (b % 8));
+        }
+        p[76] = summary.has_time ? 1 : 0;
+    }
+
+    if (!data.empty())
+        ofs.write(reinterpret_cast<char const*>(&data[0]), static_cast<std::streamsize>(data.size()));
+}
+
+bool ReadChunkSummaries(std::istream& ifs, std::size_t count, std::vector<ChunkSummary>& summaries)
+{
+    summaries.clear();
+    if (0 == count)
+        return true;
+
+    std::vector<boost::uint8_t> data(chunk_summary_record_size * count);
+    ifs.read(reinterpret_cast<char*>(&data[0]), static_cast<std::streamsize>(data.size()));
+    if (static_cast<std::size_t>(ifs.gcount()) != data.size())
+        return false;
+
+    summaries.resize(count);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        ChunkSummary& summary = summaries[s];
+        boost::uint8_t const* p = &data[s * chunk_summary_record_size];
+
+        summary.count = load<boost::uint32_t>(p);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            summary.min[i] = load<boost::int32_t>(p + 4 + 4 * i);
+            summary.max[i] = load<boost::int32_t>(p + 16 + 4 * i);
+        }
+        summary.min_time = load_double(p + 28);
+        summary.max_time = load_double(p + 36);
+        for (std::size_t b = 0; b < summary.classifications.size(); ++b)
+            summary.classifications[b] = (p[44 + b / 8] >> (b % 8)) & 1;
+        summary.has_time = (p[76] & 1) != 0;
+    }
+
+    return true;
+}
+
+} // namespace detail
+
+} // namespace liblas
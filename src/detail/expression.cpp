@@ -0,0 +1,848 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Filter expression parser and batch evaluator
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/detail/expression.hpp>
+#include <liblas/dimension.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/schema.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace liblas { namespace detail { namespace expression {
+
+namespace {
+
+// Number of points evaluated at once, small enough for the columns 
+// and masks of a chunk to stay in cache.
+const std::size_t chunk_size = 1024;
+
+struct Token
+{
+    enum Kind
+    {
+        eEnd,
+        eIdentifier,
+        eNumber,
+        eSymbol
+    };
+
+    Kind kind;
+    std::string text;
+    double number;
+    std::size_t position;
+};
+
+std::string to_lower(std::string s)
+{
+    for (std::string::iterator i = s.begin(); i != s.end(); ++i)
+        *i = static_cast<char>(std::tolower(static_cast<unsigned char>(*i)));
+    return s;
+}
+
+std::string normalize_name(std::string const& name)
+{
+    std::string s = to_lower(name);
+    std::replace(s.begin(), s.end(), ' ', '_');
+    return s;
+}
+
+class Parser
+{
+public:
+
+    Parser(std::string const& text)
+        : m_text(text)
+        , m_position(0)
+    {
+        Next();
+    }
+
+    NodePtr ParseAll()
+    {
+        NodePtr node = ParseOr();
+        if (m_token.kind != Token::eEnd)
+            Fail("unexpected '" + m_token.text + "'");
+        return node;
+    }
+
+private:
+
+    void Fail(std::string const& what) const
+    {
+        std::ostringstream msg;
+        msg << "Invalid filter expression '" << m_text << "': " << what 
+            << " at position " << m_token.position;
+        throw liblas::invalid_expression(msg.str());
+    }
+
+    void Next()
+    {
+        while (m_position < m_text.size() && 
+               std::isspace(static_cast<unsigned char>(m_text[m_position])))
+            ++m_position;
+
+        m_token.position = m_position;
+        m_token.number = 0;
+
+        if (m_position == m_text.size())
+        {
+            m_token.kind = Token::eEnd;
+            m_token.text = "end of expression";
+            return;
+        }
+
+        char const c = m_text[m_position];
+
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+        {
+            std::size_t end = m_position;
+            while (end < m_text.size() && 
+                   (std::isalnum(static_cast<unsigned char>(m_text[end])) || m_text[end] == '_'))
+                ++end;
+
+            m_token.kind = Token::eIdentifier;
+            m_token.text = to_lower(m_text.substr(m_position, end - m_position));
+            m_position = end;
+            return;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+        {
+            char const* begin = m_text.c_str() + m_position;
+            char* end = 0;
+            m_token.number = std::strtod(begin, &end);
+            if (end == begin)
+                Fail("malformed number");
+
+            m_token.kind = Token::eNumber;
+            m_token.text = m_text.substr(m_position, end - begin);
+            m_position += end - begin;
+            return;
+        }
+
+        static char const* const symbols[] = {
+            "<=", ">=", "==", "!=", "&&", "||", 
+            "<", ">", "=", "!", "(", ")", ",", "-", "+"
+        };
+
+        for (std::size_t i = 0; i < sizeof(symbols) / sizeof(symbols[0]); ++i)
+        {
+            std::string const s(symbols[i]);
+            if (m_text.compare(m_position, s.size(), s) == 0)
+            {
+                m_token.kind = Token::eSymbol;
+                m_token.text = s;
+                m_position += s.size();
+                return;
+            }
+        }
+
+        m_token.text = std::string(1, c);
+        Fail("unexpected '" + m_token.text + "'");
+    }
+
+    bool Accept(std::string const& text)
+    {
+        if (m_token.kind != Token::eNumber && m_token.text == text)
+        {
+            Next();
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(std::string const& text)
+    {
+        if (!Accept(text))
+            Fail("expected '" + text + "' but found '" + m_token.text + "'");
+    }
+
+    double ParseNumber()
+    {
+        double sign = 1.0;
+        if (Accept("-"))
+            sign = -1.0;
+        else
+            Accept("+");
+
+        if (m_token.kind != Token::eNumber)
+            Fail("expected a number but found '" + m_token.text + "'");
+
+        double const value = sign * m_token.number;
+        Next();
+        return value;
+    }
+
+    NodePtr ParseOr()
+    {
+        NodePtr node = ParseAnd();
+        while (Accept("||") || Accept("or"))
+        {
+            NodePtr parent(new Node(Node::eOr));
+            parent->left = node;
+            parent->right = ParseAnd();
+            node = parent;
+        }
+        return node;
+    }
+
+    NodePtr ParseAnd()
+    {
+        NodePtr node = ParseNot();
+        while (Accept("&&") || Accept("and"))
+        {
+            NodePtr parent(new Node(Node::eAnd));
+            parent->left = node;
+            parent->right = ParseNot();
+            node = parent;
+        }
+        return node;
+    }
+
+    NodePtr ParseNot()
+    {
+        if (Accept("!") || Accept("not"))
+        {
+            NodePtr node(new Node(Node::eNot));
+            node->left = ParseNot();
+            return node;
+        }
+
+        if (Accept("("))
+        {
+            NodePtr node = ParseOr();
+            Expect(")");
+            return node;
+        }
+
+        return ParseTest();
+    }
+
+    NodePtr ParseTest()
+    {
+        if (m_token.kind != Token::eIdentifier)
+            Fail("expected a dimension name but found '" + m_token.text + "'");
+
+        NodePtr node(new Node(Node::eCompare));
+        node->field = normalize_name(m_token.text);
+        Next();
+
+        bool const negate = Accept("not");
+
+        if (Accept("between"))
+        {
+            node->op = eBetween;
+            node->values.push_back(ParseNumber());
+            Expect("and");
+            node->values.push_back(ParseNumber());
+            if (node->values[0] > node->values[1])
+                std::swap(node->values[0], node->values[1]);
+        }
+        else if (Accept("in"))
+        {
+            node->op = eIn;
+            Expect("(");
+            node->values.push_back(ParseNumber());
+            while (Accept(","))
+                node->values.push_back(ParseNumber());
+            Expect(")");
+        }
+        else if (negate)
+        {
+            Fail("expected 'between' or 'in' but found '" + m_token.text + "'");
+        }
+        else
+        {
+            if (Accept("<="))
+                node->op = eLessEqual;
+            else if (Accept(">="))
+                node->op = eGreaterEqual;
+            else if (Accept("<"))
+                node->op = eLess;
+            else if (Accept(">"))
+                node->op = eGreater;
+            else if (Accept("==") || Accept("="))
+                node->op = eEqual;
+            else if (Accept("!="))
+                node->op = eNotEqual;
+            else
+                Fail("expected a comparison but found '" + m_token.text + "'");
+
+            node->values.push_back(ParseNumber());
+        }
+
+        if (negate)
+        {
+            NodePtr parent(new Node(Node::eNot));
+            parent->left = node;
+            return parent;
+        }
+        return node;
+    }
+
+    std::string const& m_text;
+    std::size_t m_position;
+    Token m_token;
+};
+
+template <typename Compare>
+void compare_column(double const* values, std::size_t count, Compare c, boost::uint8_t* out)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = c(values[i]) ? 1 : 0;
+}
+
+struct less_than
+{
+    less_than(double v) : v(v) {}
+    bool operator()(double x) const { return x < v; }
+    double v;
+};
+
+struct less_equal
+{
+    less_equal(double v) : v(v) {}
+    bool operator()(double x) const { return x <= v; }
+    double v;
+};
+
+struct greater_than
+{
+    greater_than(double v) : v(v) {}
+    bool operator()(double x) const { return x > v; }
+    double v;
+};
+
+struct greater_equal
+{
+    greater_equal(double v) : v(v) {}
+    bool operator()(double x) const { return x >= v; }
+    double v;
+};
+
+struct equal_to
+{
+    equal_to(double v) : v(v) {}
+    bool operator()(double x) const { return x == v; }
+    double v;
+};
+
+struct not_equal_to
+{
+    not_equal_to(double v) : v(v) {}
+    bool operator()(double x) const { return x != v; }
+    double v;
+};
+
+struct between
+{
+    between(double lo, double hi) : lo(lo), hi(hi) {}
+    bool operator()(double x) const { return (x >= lo) & (x <= hi); }
+    double lo;
+    double hi;
+};
+
+void test_column(Instruction const& ins, double const* values, std::size_t count, boost::uint8_t* out)
+{
+    std::vector<double> const& v = ins.values;
+
+    switch (ins.op)
+    {
+        case eLess:
+            compare_column(values, count, less_than(v[0]), out);
+            break;
+        case eLessEqual:
+            compare_column(values, count, less_equal(v[0]), out);
+            break;
+        case eGreater:
+            compare_column(values, count, greater_than(v[0]), out);
+            break;
+        case eGreaterEqual:
+            compare_column(values, count, greater_equal(v[0]), out);
+            break;
+        case eEqual:
+            compare_column(values, count, equal_to(v[0]), out);
+            break;
+        case eNotEqual:
+            compare_column(values, count, not_equal_to(v[0]), out);
+            break;
+        case eBetween:
+            compare_column(values, count, between(v[0], v[1]), out);
+            break;
+        case eIn:
+            std::fill(out, out + count, 0);
+            for (std::size_t j = 0; j < v.size(); ++j)
+            {
+                double const value = v[j];
+                for (std::size_t i = 0; i < count; ++i)
+                    out[i] |= (values[i] == value) ? 1 : 0;
+            }
+            break;
+    }
+}
+
+// Whether a test holds for some (can_hold) and fails for some 
+// (can_fail) of the values in [lo, hi].
+void test_range(Instruction const& ins, double lo, double hi, bool& can_hold, bool& can_fail)
+{
+    std::vector<double> const& v = ins.values;
+
+    switch (ins.op)
+    {
+        case eLess:
+            can_hold = lo < v[0];
+            can_fail = hi >= v[0];
+            break;
+        case eLessEqual:
+            can_hold = lo <= v[0];
+            can_fail = hi > v[0];
+            break;
+        case eGreater:
+            can_hold = hi > v[0];
+            can_fail = lo <= v[0];
+            break;
+        case eGreaterEqual:
+            can_hold = hi >= v[0];
+            can_fail = lo < v[0];
+            break;
+        case eEqual:
+            can_hold = lo <= v[0] && v[0] <= hi;
+            can_fail = lo != v[0] || hi != v[0];
+            break;
+        case eNotEqual:
+            can_hold = lo != v[0] || hi != v[0];
+            can_fail = lo <= v[0] && v[0] <= hi;
+            break;
+        case eBetween:
+            can_hold = hi >= v[0] && lo <= v[1];
+            can_fail = lo < v[0] || hi > v[1];
+            break;
+        case eIn:
+            can_hold = false;
+            for (std::size_t j = 0; j < v.size(); ++j)
+            {
+                if (lo <= v[j] && v[j] <= hi)
+                    can_hold = true;
+            }
+            // A single value is either in the list or not
+            can_fail = lo != hi || !can_hold;
+            break;
+    }
+}
+
+} // namespace
+
+NodePtr Parse(std::string const& text)
+{
+    Parser parser(text);
+    return parser.ParseAll();
+}
+
+FieldLayout GetFieldLayout(liblas::Header const& header, std::string const& name)
+{
+    std::string wanted = normalize_name(name);
+
+    // A few friendlier spellings of the standard dimension names
+    if (wanted == "scan_angle")
+        wanted = "scan_angle_rank";
+    else if (wanted == "gps_time")
+        wanted = "time";
+    else if (wanted == "edge_of_flight_line")
+        wanted = "flightline_edge";
+
+    liblas::IndexMap const& dims = header.GetSchema().GetDimensions();
+    liblas::index_by_index const& idx = dims.get<liblas::index>();
+
+    liblas::index_by_index::const_iterator dim = idx.begin();
+    for (; dim != idx.end(); ++dim)
+    {
+        if (normalize_name(dim->GetName()) == wanted)
+            break;
+    }
+
+    if (dim == idx.end())
+    {
+        std::ostringstream msg;
+        msg << "Invalid filter expression: no dimension named '" << name 
+            << "' in point format " << header.GetDataFormatId();
+        throw liblas::invalid_expression(msg.str());
+    }
+
+    // The class number is the low five bits of the classification 
+    // byte, the rest are the synthetic/keypoint/withheld flags.  Compare 
+    // the class like liblas::ClassificationFilter does.
+    Dimension field(*dim);
+    if (wanted == "classification" && dim->GetBitSize() == 8)
+    {
+        Dimension cls(dim->GetName(), 5);
+        cls.SetByteOffset(dim->GetByteOffset());
+        cls.SetBitOffset(0);
+        field = cls;
+    }
+
+    try
+    {
+        detail::DimensionLayout check(field);
+        boost::ignore_unused_variable_warning(check);
+    }
+    catch (liblas::liblas_error const& e)
+    {
+        throw liblas::invalid_expression(std::string("Invalid filter expression: ") + e.what());
+    }
+
+    FieldLayout layout(field);
+
+    // The coordinates are compared in scaled units
+    if (wanted == "x" || wanted == "y" || wanted == "z")
+    {
+        layout.scale = wanted == "x" ? header.GetScaleX() : 
+                       wanted == "y" ? header.GetScaleY() : header.GetScaleZ();
+        layout.offset = wanted == "x" ? header.GetOffsetX() : 
+                        wanted == "y" ? header.GetOffsetY() : header.GetOffsetZ();
+    }
+
+    return layout;
+}
+
+Program::Program(std::string const& text)
+    : m_text(text)
+    , m_stack_depth(0)
+    , m_header(0)
+    , m_format(liblas::ePointFormat0)
+    , m_record_length(0)
+{
+    std::fill(m_scale, m_scale + 3, 0.0);
+    std::fill(m_offset, m_offset + 3, 0.0);
+
+    NodePtr root = Parse(text);
+    Compile(*root, 1);
+
+    m_columns.resize(m_fields.size());
+    m_loaded.resize(m_fields.size(), false);
+    m_stack.resize(m_stack_depth);
+}
+
+void Program::Compile(Node const& node, std::size_t depth)
+{
+    // Post-order walk, depth is the stack size once node has run
+    m_stack_depth = (std::max)(m_stack_depth, depth);
+
+    Instruction ins;
+    ins.field = 0;
+    ins.op = eEqual;
+
+    switch (node.kind)
+    {
+        case Node::eCompare:
+        {
+            std::vector<std::string>::iterator f = 
+                std::find(m_fields.begin(), m_fields.end(), node.field);
+            ins.field = static_cast<std::size_t>(f - m_fields.begin());
+            if (f == m_fields.end())
+                m_fields.push_back(node.field);
+
+            ins.code = Instruction::eTest;
+            ins.op = node.op;
+            ins.values = node.values;
+            break;
+        }
+        case Node::eNot:
+            Compile(*node.left, depth);
+            ins.code = Instruction::eNot;
+            break;
+        case Node::eAnd:
+        case Node::eOr:
+            Compile(*node.left, depth);
+            Compile(*node.right, depth + 1);
+            ins.code = (node.kind == Node::eAnd) ? Instruction::eAnd : Instruction::eOr;
+            break;
+    }
+
+    m_code.push_back(ins);
+}
+
+bool Program::IsBound(liblas::Header const* header) const
+{
+    return header == m_header && 
+           header->GetDataFormatId() == m_format &&
+           header->GetDataRecordLength() == m_record_length &&
+           header->GetScaleX() == m_scale[0] &&
+           header->GetScaleY() == m_scale[1] &&
+           header->GetScaleZ() == m_scale[2] &&
+           header->GetOffsetX() == m_offset[0] &&
+           header->GetOffsetY() == m_offset[1] &&
+           header->GetOffsetZ() == m_offset[2];
+}
+
+void Program::Bind(liblas::Header const* header)
+{
+    if (IsBound(header))
+        return;
+
+    std::vector<FieldLayout> layout;
+    std::vector< liblas::DimensionAccessor<double> > accessors;
+    layout.reserve(m_fields.size());
+    accessors.reserve(m_fields.size());
+    for (std::size_t i = 0; i < m_fields.size(); ++i)
+    {
+        layout.push_back(GetFieldLayout(*header, m_fields[i]));
+        accessors.push_back(liblas::DimensionAccessor<double>(layout.back().dimension));
+    }
+
+    m_layout.swap(layout);
+    m_accessors.swap(accessors);
+    m_header = header;
+    m_format = header->GetDataFormatId();
+    m_record_length = header->GetDataRecordLength();
+    m_scale[0] = header->GetScaleX();
+    m_scale[1] = header->GetScaleY();
+    m_scale[2] = header->GetScaleZ();
+    m_offset[0] = header->GetOffsetX();
+    m_offset[1] = header->GetOffsetY();
+    m_offset[2] = header->GetOffsetZ();
+}
+
+std::vector<double> const& Program::LoadColumn(std::size_t field, 
+                                               boost::uint8_t const* data,
+                                               std::size_t count)
+{
+    std::vector<double>& column = m_columns[field];
+    if (m_loaded[field])
+        return column;
+
+    m_accessors[field].Get(liblas::PointSpan(m_header, data, count), column);
+
+    FieldLayout const& f = m_layout[field];
+    if (f.scale != 1.0 || f.offset != 0.0)
+    {
+        double* out = &column.front();
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = out[i] * f.scale + f.offset;
+    }
+
+    m_loaded[field] = true;
+    return column;
+}
+
+bool Program::GetRange(std::size_t field, liblas::ChunkSummary const& summary, double& lo, double& hi) const
+{
+    FieldLayout const& f = m_layout[field];
+    std::string const& name = f.dimension.GetName();
+
+    std::size_t axis = 3;
+    if (name == "X") axis = 0;
+    else if (name == "Y") axis = 1;
+    else if (name == "Z") axis = 2;
+
+    if (axis < 3)
+    {
+        // Scaled the way LoadColumn scales the values of the records
+        lo = summary.min[axis] * f.scale + f.offset;
+        hi = summary.max[axis] * f.scale + f.offset;
+        if (lo > hi)
+            std::swap(lo, hi);
+        return true;
+    }
+
+    if (name == "Time")
+    {
+        lo = summary.min_time;
+        hi = summary.max_time;
+        return summary.has_time;
+    }
+
+    if (name == "Classification")
+    {
+        // Either the whole byte or the class number in its low bits
+        unsigned int const mask = (1U << f.dimension.GetBitSize()) - 1;
+        bool found = false;
+        for (std::size_t b = 0; b < summary.classifications.size(); ++b)
+        {
+            if (!summary.classifications.test(b))
+                continue;
+            double const value = static_cast<double>(b & mask);
+            lo = found ? (std::min)(lo, value) : value;
+            hi = found ? (std::max)(hi, value) : value;
+            found = true;
+        }
+        return found;
+    }
+
+    return false;
+}
+
+void Program::EvaluateSummary(liblas::Header const* header, 
+                              liblas::ChunkSummary const& summary,
+                              bool& can_hold, 
+                              bool& can_fail)
+{
+    Bind(header);
+
+    // Three-valued evaluation: every entry says whether the expression 
+    // so far can hold and whether it can fail for the summarized points.
+    std::vector< std::pair<bool, bool> > stack;
+    stack.reserve(m_stack_depth);
+
+    std::vector<Instruction>::const_iterator ins;
+    for (ins = m_code.begin(); ins != m_code.end(); ++ins)
+    {
+        switch (ins->code)
+        {
+            case Instruction::eTest:
+            {
+                double lo = 0.0;
+                double hi = 0.0;
+                bool hold = true;
+                bool fail = true;
+                if (GetRange(ins->field, summary, lo, hi))
+                    test_range(*ins, lo, hi, hold, fail);
+                stack.push_back(std::make_pair(hold, fail));
+                break;
+            }
+            case Instruction::eNot:
+                std::swap(stack.back().first, stack.back().second);
+                break;
+            case Instruction::eAnd:
+            {
+                std::pair<bool, bool> const b = stack.back();
+                stack.pop_back();
+                stack.back().first = stack.back().first && b.first;
+                stack.back().second = stack.back().second || b.second;
+                break;
+            }
+            case Instruction::eOr:
+            {
+                std::pair<bool, bool> const b = stack.back();
+                stack.pop_back();
+                stack.back().first = stack.back().first || b.first;
+                stack.back().second = stack.back().second && b.second;
+                break;
+            }
+        }
+    }
+
+    can_hold = stack.front().first;
+    can_fail = stack.front().second;
+}
+
+std::size_t Program::Evaluate(liblas::PointSpan const& points, liblas::SelectionMask& mask)
+{
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    if (0 == count)
+        return 0;
+
+    Bind(points.GetHeader());
+
+    for (std::size_t s = 0; s < m_stack.size(); ++s)
+        m_stack[s].resize(chunk_size);
+
+    std::size_t kept = 0;
+
+    for (std::size_t first = 0; first < count; first += chunk_size)
+    {
+        std::size_t const n = (std::min)(chunk_size, count - first);
+        boost::uint8_t const* data = points.GetRecord(first);
+
+        std::fill(m_loaded.begin(), m_loaded.end(), false);
+
+        std::size_t sp = 0;
+        std::vector<Instruction>::const_iterator ins;
+        for (ins = m_code.begin(); ins != m_code.end(); ++ins)
+        {
+            switch (ins->code)
+            {
+                case Instruction::eTest:
+                {
+                    std::vector<double> const& column = LoadColumn(ins->field, data, n);
+                    test_column(*ins, &column.front(), n, &m_stack[sp].front());
+                    ++sp;
+                    break;
+                }
+                case Instruction::eNot:
+                {
+                    boost::uint8_t* a = &m_stack[sp - 1].front();
+                    for (std::size_t i = 0; i < n; ++i)
+                        a[i] ^= 1;
+                    break;
+                }
+                case Instruction::eAnd:
+                {
+                    --sp;
+                    boost::uint8_t* a = &m_stack[sp - 1].front();
+                    boost::uint8_t const* b = &m_stack[sp].front();
+                    for (std::size_t i = 0; i < n; ++i)
+                        a[i] &= b[i];
+                    break;
+                }
+                case Instruction::eOr:
+                {
+                    --sp;
+                    boost::uint8_t* a = &m_stack[sp - 1].front();
+                    boost::uint8_t const* b = &m_stack[sp].front();
+                    for (std::size_t i = 0; i < n; ++i)
+                        a[i] |= b[i];
+                    break;
+                }
+            }
+        }
+
+        boost::uint8_t const* result = &m_stack[0].front();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            mask[first + i] = result[i];
+            kept += result[i];
+        }
+    }
+
+    return kept;
+}
+
+}}} // namespace liblas::detail::expression
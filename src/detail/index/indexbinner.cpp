@@ -0,0 +1,295 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  index point binning implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/detail/index/indexbinner.hpp>
+// std
+#include <new>	// std::bad_alloc
+
+namespace liblas { namespace detail {
+
+IndexBinner::IndexBinner(liblas::Index *indexsource, std::string const& tempfilename, 
+	boost::uint32_t maxpointsinmemory) :
+	m_index(indexsource),
+	m_cellBlock(indexsource->GetCellsX(), IndexCellRow(indexsource->GetCellsY())),
+	m_tempFileName(tempfilename),
+	m_tempFile(0),
+	m_tempFileWrittenBytes(0),
+	m_pointsInMemory(0),
+	m_maxPointsInMemory(maxpointsinmemory),
+	m_lastCellX(static_cast<boost::uint32_t>(~0)),
+	m_lastCellY(static_cast<boost::uint32_t>(~0)),
+	m_lastPointID(0),
+	m_nextPointID(0),
+	m_tempFileStarted(false),
+	m_failed(false),
+	m_outOfMemory(false)
+{
+} // IndexBinner::IndexBinner
+
+IndexBinner::~IndexBinner()
+{
+	CloseTempFile();
+} // IndexBinner::~IndexBinner
+
+void IndexBinner::BinPoints(PointSpan const& Points, boost::uint32_t FirstPointID)
+{
+	if (m_failed)
+		return;
+	try {
+		// a run of consecutive points can only be extended if these points follow the last ones binned here
+		if (FirstPointID != m_nextPointID)
+			m_lastCellX = m_lastCellY = static_cast<boost::uint32_t>(~0);
+		liblas::Point CurPt(Points.GetHeader());
+		boost::uint32_t PointID = FirstPointID;
+		for (std::size_t i = 0; i < Points.size(); ++i, ++PointID)
+		{
+			boost::uint32_t CurCellX, CurCellY;
+			// analyze the point to determine its cell ID
+			Points.GetPoint(i, CurPt);
+			if (m_index->IdentifyCell(CurPt, CurCellX, CurCellY))
+			{
+				// if same cell as last point, attempt to increment the count of consecutive points for the cell
+				// otherwise add a new point, first checking to see if the memory allocated to this binner is full
+				if (! (CurCellX == m_lastCellX && CurCellY == m_lastCellY &&
+					m_cellBlock[CurCellX][CurCellY].IncrementPointRecord(m_lastPointID)))
+				{
+					// if memory allocated to this binner is full, write all its point data to its temp file
+					if (m_tempFileName.size() && m_pointsInMemory >= m_maxPointsInMemory)
+					{
+						if (! PurgePointsToTempFile())
+						{
+							m_failed = true;
+							return;
+						} // if
+					} // if
+					m_cellBlock[CurCellX][CurCellY].AddPointRecord(PointID);
+					m_lastPointID = PointID;
+					m_lastCellX = CurCellX;
+					m_lastCellY = CurCellY;
+					++m_pointsInMemory;
+				} // if
+				// update Z cell bounds
+				m_cellBlock[CurCellX][CurCellY].UpdateZBounds(CurPt.GetZ());
+			} // if
+		} // for
+		m_nextPointID = PointID;
+	} // try
+	catch (std::bad_alloc const&) {
+		m_failed = m_outOfMemory = true;
+	} // catch
+} // IndexBinner::BinPoints
+
+bool IndexBinner::PurgePointsToTempFile(void)
+{
+	if (m_tempFile || OpenTempFile())
+	{
+		boost::uint32_t CellsX = m_index->GetCellsX(), CellsY = m_index->GetCellsY();
+		TempFileOffsetType EmptyOffset = 0;	// this might not be large enough
+		
+		if (! m_tempFileStarted)
+		{
+			// there is some setup of the temp file to be done first
+			// write out a block of file offsets the size of the number of cells
+			for (boost::uint32_t i = 0; i < CellsX * CellsY; ++i)
+			{
+				if (fwrite(&EmptyOffset, sizeof(TempFileOffsetType), 1, m_tempFile) < 1)
+					return false;
+			} // for
+			m_tempFileWrittenBytes = CellsX * CellsY * sizeof(TempFileOffsetType);
+			m_tempFileStarted = true;
+		} // if
+		for (boost::uint32_t x = 0; x < CellsX; ++x)
+		{
+			for (boost::uint32_t y = 0; y < CellsY; ++y)
+			{
+				boost::uint32_t RecordsToWrite = m_cellBlock[x][y].GetNumRecords();
+				if (RecordsToWrite)
+				{
+					// write the current file location in the cell block header
+					// if cell block header is 0 write the current file location in the file header
+					// otherwise write the current file location at the file location specified in the 
+					// cell block header
+					TempFileOffsetType LastWriteLocation = m_cellBlock[x][y].GetFileOffset();
+					if (LastWriteLocation == 0)
+						LastWriteLocation = (x * CellsY + y) * sizeof(TempFileOffsetType);
+#ifdef _MSC_VER
+					_fseeki64(m_tempFile, LastWriteLocation, SEEK_SET);
+#else
+					fseek(m_tempFile, LastWriteLocation, SEEK_SET);
+#endif
+					if (fwrite(&m_tempFileWrittenBytes, sizeof(TempFileOffsetType), 1, m_tempFile) < 1)
+						return false;
+					m_cellBlock[x][y].SetFileOffset(m_tempFileWrittenBytes);
+
+					// seek to end of file where next block of data will be written
+#ifdef _MSC_VER
+					_fseeki64(m_tempFile, 0, SEEK_END);
+#else
+					fseek(m_tempFile, 0, SEEK_END);
+#endif
+
+					// write a blank space for later placement of next file block for this cell
+					if (fwrite(&EmptyOffset, sizeof(TempFileOffsetType), 1, m_tempFile) < 1)
+						return false;
+					m_tempFileWrittenBytes += sizeof(TempFileOffsetType);
+					// write the number of records stored in this section
+					if (fwrite(&RecordsToWrite, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
+						return false;
+					m_tempFileWrittenBytes += sizeof(boost::uint32_t);
+
+					IndexCellData::iterator MapIt = m_cellBlock[x][y].GetFirstRecord();
+					for (boost::uint32_t RecordNum = 0; RecordNum < RecordsToWrite && MapIt != m_cellBlock[x][y].GetEnd(); ++RecordNum, ++MapIt)
+					{
+						// write the point ID
+						boost::uint32_t PointID = MapIt->first;
+						// write the number of consecutive points
+						ConsecPtAccumulator ConsecutivePoints = MapIt->second;
+						if (fwrite(&PointID, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
+							return false;
+						if (fwrite(&ConsecutivePoints, sizeof(ConsecPtAccumulator), 1, m_tempFile) < 1)
+							return false;
+						m_tempFileWrittenBytes += sizeof(boost::uint32_t);
+						m_tempFileWrittenBytes += sizeof(ConsecPtAccumulator);
+					} // for
+					// purge the records for this cell from active memory
+					m_cellBlock[x][y].RemoveMainRecords();
+				} // if
+			} // for y
+		} // for x
+		// necessary for subsequent reads in case fseek isn't called first
+		fflush(m_tempFile);
+		m_pointsInMemory = 0;
+		return true;
+	} // if file
+
+	return false;
+
+} // IndexBinner::PurgePointsToTempFile
+
+bool IndexBinner::LoadCellFromTempFile(IndexCell *CellBlock, boost::uint32_t CurCellX, boost::uint32_t CurCellY)
+{
+
+	boost::uint32_t RecordsToRead;
+	TempFileOffsetType FileOffset;
+	
+	if (m_tempFile)
+	{
+		// load the cell as it was written
+		// read the first offset for this cell
+#ifdef _MSC_VER
+		if (_fseeki64(m_tempFile, (CurCellX * m_index->GetCellsY() + CurCellY) * sizeof (TempFileOffsetType), SEEK_SET))
+#else
+		if (fseek(m_tempFile, (CurCellX * m_index->GetCellsY() + CurCellY) * sizeof (TempFileOffsetType), SEEK_SET))
+#endif
+			return false;
+		if (fread(&FileOffset, sizeof (TempFileOffsetType), 1, m_tempFile) < 1)
+			return false;
+		while (FileOffset > 0)
+		{
+			// jump to the first block for this cell, read the next offset
+#ifdef _MSC_VER
+			if (_fseeki64(m_tempFile, FileOffset, SEEK_SET))
+#else
+			if (fseek(m_tempFile, FileOffset, SEEK_SET))
+#endif
+				return false;
+			if (fread(&FileOffset, sizeof (TempFileOffsetType), 1, m_tempFile) < 1)
+				return false;
+			// read the data for the cell in this block
+			// first is the number of items to read now
+			if (fread(&RecordsToRead, sizeof (boost::uint32_t), 1, m_tempFile) < 1)
+				return false;
+			for (boost::uint32_t RecordNum = 0; RecordNum < RecordsToRead; ++RecordNum)
+			{
+				boost::uint32_t PointID;
+				ConsecPtAccumulator ConsecutivePoints;
+				// read the point ID
+				if (fread(&PointID, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
+					return false;
+				// read the number of consecutive points
+				if (fread(&ConsecutivePoints, sizeof(ConsecPtAccumulator), 1, m_tempFile) < 1)
+					return false;
+				CellBlock->AddPointRecord(PointID, ConsecutivePoints);
+			} // for
+		} // while
+	} // if
+	// records that were never offloaded are still in memory
+	if (! m_cellBlock.empty())
+	{
+		IndexCell& Cell = m_cellBlock[CurCellX][CurCellY];
+		for (IndexCellData::iterator MapIt = Cell.GetFirstRecord(); MapIt != Cell.GetEnd(); ++MapIt)
+			CellBlock->AddPointRecord(MapIt->first, MapIt->second);
+		Cell.RemoveMainRecords();
+	} // if
+	return true;
+
+} // IndexBinner::LoadCellFromTempFile
+
+void IndexBinner::ReleaseCells(void)
+{
+	if (m_tempFile && ! m_pointsInMemory)
+		IndexCellDataBlock().swap(m_cellBlock);
+} // IndexBinner::ReleaseCells
+
+FILE *IndexBinner::OpenTempFile(void)
+{
+
+	m_tempFileStarted = false;
+	m_tempFileWrittenBytes = 0;
+	return (m_tempFile = fopen(m_tempFileName.c_str(), "wb+"));
+    
+} // IndexBinner::OpenTempFile
+
+void IndexBinner::CloseTempFile(void)
+{
+
+	if (m_tempFile)
+	{
+		fclose(m_tempFile);
+		remove(m_tempFileName.c_str());
+	} // if
+	m_tempFile = 0;
+	m_tempFileWrittenBytes = 0;
+    
+} // IndexBinner::CloseTempFile
+
+}} // namespace liblas::detail
@@ -42,303 +42,372 @@
 #include <liblas/liblas.hpp>
 #include <liblas/detail/reader/reader.hpp>
 #include <liblas/detail/reader/cachedreader.hpp>
-#include <liblas/detail/private_utility.hpp>
+#include <liblas/exception.hpp>
 // boost
 #include <boost/cstdint.hpp>
 // std
-#include <fstream>
-#include <istream>
-#include <iostream>
-#include <stdexcept>
+#include <algorithm>
 #include <cstddef> // std::size_t
-#include <cstdlib> // std::free
-#include <cassert>
-
-using namespace boost;
+#include <cstring> // std::memcpy
+#include <sstream>
+#include <stdexcept>
 
 namespace liblas { namespace detail { 
 
+const std::size_t CachedReaderImpl::default_page_size;
+
+CachedReaderImpl::CachedReaderImpl(ReaderIPtr reader, std::size_t page_size, std::size_t budget)
+    : m_reader(reader)
+    , m_page_size(page_size)
+    , m_owned_cache(new SharedPageCache(budget, 1))
+    , m_cache(m_owned_cache.get())
+    , m_file(0)
+    , m_page_number(0)
+    , m_record_length(0)
+    , m_size(0)
+    , m_position(0)
+    , m_block_position(0)
+    , m_next_index(0)
+{
+    Check();
+}
 
-CachedReaderImpl::CachedReaderImpl(std::istream& ifs , std::size_t size)
-    : ReaderImpl(ifs)
-    , m_cache_size(size)
-    , m_cache_start_position(0)
-    , m_cache_read_position(0)
-    , m_cache_initialized(false)
+CachedReaderImpl::CachedReaderImpl(ReaderIPtr reader, std::size_t page_size, 
+                                   SharedPageCache& cache, std::string const& identity)
+    : m_reader(reader)
+    , m_page_size(page_size)
+    , m_cache(&cache)
+    , m_identity(identity)
+    , m_file(0)
+    , m_page_number(0)
+    , m_record_length(0)
+    , m_size(0)
+    , m_position(0)
+    , m_block_position(0)
+    , m_next_index(0)
 {
+    Check();
 }
 
-void CachedReaderImpl::ReadHeader()
+void CachedReaderImpl::Check() const
 {
-    ReaderImpl::ReadHeader();
-    HeaderPtr hptr(new liblas::Header(ReaderImpl::GetHeader()));
-    
-    // If we were given no cache size, try to cache the whole thing
-    if (m_cache_size == 0) {
-        m_cache_size = hptr->GetPointRecordsCount();
-    }
+    if (!m_reader)
+        throw liblas_error("CachedReaderImpl: reader to wrap is void");
 
-    if (m_cache_size > hptr->GetPointRecordsCount()) {
-        m_cache_size = hptr->GetPointRecordsCount();
-    }
-    // // FIXME: Note, vector::resize never shrinks the container and frees memory! Are we aware of this fact here? --mloskot
-    // m_cache.resize(m_cache_size);
-    // 
-    // // Mark all positions as uncached and build up the mask
-    // // to the size of the number of points in the file
-    // boost::uint8_t const uncached_mask = 0;
-    // cache_mask_type(hptr->GetPointRecordsCount(), uncached_mask).swap(m_mask);
-    
-    m_header = hptr;
+    if (0 == m_page_size)
+        throw configuration_error("CachedReaderImpl: page size must be at least 1");
 }
 
-void CachedReaderImpl::CacheData(boost::uint32_t position) 
+void CachedReaderImpl::SetLayout(liblas::Header const& header)
 {
-    cache_mask_type::size_type old_cache_start_position = m_cache_start_position;
-    m_cache_start_position = position;
-
-    cache_mask_type::size_type header_size = static_cast<cache_mask_type::size_type>(m_header->GetPointRecordsCount());
-    cache_mask_type::size_type left_to_cache = (std::min)(m_cache_size, header_size - m_cache_start_position);
+    std::size_t const record_length = header.GetDataRecordLength();
+    std::size_t const size = header.GetPointRecordsCount();
+    bool const changed = record_length != m_record_length || size != m_size;
 
-    cache_mask_type::size_type to_mark = (std::min)(m_cache_size, header_size - old_cache_start_position);
+    m_record_length = record_length;
+    m_size = size;
 
-    for (uint32_t i = 0; i < to_mark; ++i)
+    if (m_owned_cache)
     {
-        m_mask[old_cache_start_position + i] = 0;
+        // Nobody else can use pages of the old layout.
+        if (changed)
+        {
+            m_owned_cache->Clear();
+            m_page.reset();
+        }
+        return;
     }
 
-    // if these aren't equal, we've hopped around with ReadPointAt
-    // and we need to seek to the proper position.
-    if (m_current != position) {
-        CachedReaderImpl::Seek(position);
-        m_current = position;
-    }
-    m_cache_read_position =  position;
+    m_page.reset();
 
-    for (uint32_t i = 0; i < left_to_cache; ++i) 
-    {
-        try {
-            m_mask[m_current] = 1;
-            ReadNextUncachedPoint();
-            m_cache[i] = ReaderImpl::GetPoint();
-        } catch (std::out_of_range&) {
-            // cached to the end
-            break;
-        }
-    }
+    std::ostringstream identity;
+    identity << m_identity << '\n' << size << '\n' << record_length 
+             << '\n' << header.GetDataOffset() << '\n' << m_page_size;
+    m_file = m_cache->GetFileId(identity.str());
 }
 
-void CachedReaderImpl::ReadNextUncachedPoint()
+liblas::Header const& CachedReaderImpl::GetHeader() const
 {
-    if (0 == m_current)
-    {
-        m_ifs.clear();
-        m_ifs.seekg(m_header->GetDataOffset(), std::ios::beg);
-    }
+    return m_reader->GetHeader();
+}
 
-    if (m_current >= m_size ){
-        throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
-    } 
+void CachedReaderImpl::ReadHeader()
+{
+    m_reader->ReadHeader();
 
-    // m_point_reader->read();
-    detail::read_n(m_point->GetData().front(), m_ifs, m_record_size);
-    ++m_current;
-    // *m_point = m_point_reader->GetPoint();
+    // Reader::Reset rereads the header, which should not cost us the 
+    // cache unless the layout of the points actually changed.
+    liblas::Header const& header = m_reader->GetHeader();
+    SetLayout(header);
+    m_point.SetHeader(&header);
 
+    Reset();
+}
 
-    if (!m_transforms.empty())
+void CachedReaderImpl::SetHeader(liblas::Header const& header)
+{
+    m_reader->SetHeader(header);
+
+    liblas::Header const& h = m_reader->GetHeader();
+    SetLayout(h);
+    m_point.SetHeader(&h);
+}
+
+SharedPageCache::PagePtr const& CachedReaderImpl::GetPage(std::size_t page)
+{
+    if (m_page && m_page_number == page)
+        return m_page;
+
+    m_page_number = page;
+    m_page = m_cache->Find(m_file, page);
+    if (m_page)
+        return m_page;
+
+    std::size_t const first = page * m_page_size;
+    std::size_t const count = (std::min)(m_page_size, m_size - first);
+
+    SharedPageCache::PagePtr data(new liblas::PointBuffer);
+    m_reader->Seek(first);
+    m_reader->ReadNextPoints(*data, count);
+
+    // A short page means the file holds fewer points than its header 
+    // claims.  Don't go past what we could actually read.
+    if (data->size() < count)
+        m_size = first + data->size();
+
+    m_cache->Insert(m_file, page, data);
+    m_page = data;
+    return m_page;
+}
+
+void CachedReaderImpl::ReadRecord(std::size_t n)
+{
+    SharedPageCache::PagePtr const& page = GetPage(n / m_page_size);
+
+    std::size_t const i = n % m_page_size;
+    if (i >= page->size())
+        throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+
+    liblas::PointSpan(&GetHeader(), page->GetRecord(i), 1).GetPoint(0, m_point);
+}
+
+std::size_t CachedReaderImpl::CopyRecords(liblas::PointBuffer& buffer, std::size_t n)
+{
+    std::size_t copied = 0;
+    while (copied < n && m_position < m_size)
     {
-        ReaderImpl::TransformPoint(*m_point);
+        SharedPageCache::PagePtr const& page = GetPage(m_position / m_page_size);
+
+        std::size_t const i = m_position % m_page_size;
+        if (i >= page->size())
+            break;
+
+        std::size_t const count = (std::min)(n - copied, page->size() - i);
+        std::size_t const first = buffer.size();
+        buffer.resize(first + count);
+        std::memcpy(buffer.GetRecord(first), page->GetRecord(i), count * m_record_length);
+
+        copied += count;
+        m_position += count;
     }
+    return copied;
+}
+
+bool CachedReaderImpl::CopyBlock()
+{
+    m_block.SetHeader(&GetHeader());
+    m_block.clear();
+    m_block_position = 0;
 
+    std::size_t const first = m_position;
+    std::size_t const got = CopyRecords(m_block, filter_block_size);
+
+    m_block_ids.resize(got);
+    for (std::size_t i = 0; i < got; ++i)
+        m_block_ids[i] = static_cast<boost::uint32_t>(first + i);
+
+    FilterPoints(m_filters, m_block, 0, &m_block_ids);
+    return got > 0;
 }
 
-void CachedReaderImpl::ReadCachedPoint(boost::uint32_t position) {
-    
-    int32_t cache_position = position - m_cache_start_position ;
-
-    // std::cout << "MASK: ";
-    // std::vector<bool>::iterator it;
-    // for (it = m_mask.begin(); it != m_mask.end(); ++it) {
-    //     std::cout << *it << ",";
-    // }
-    // std::cout << std::endl;
-
-    // If our point cache and mask have not yet been initialized, we 
-    // should do so before tyring to read any points.  We don't want to do 
-    // this in ::Reset or ::ReadHeader, as these functions may be called 
-    // multiple times and screw up our assumptions.
-    if (!m_cache_initialized) 
+void CachedReaderImpl::TransformPoint(liblas::Point& p)
+{
+    std::vector<liblas::TransformPtr>::const_iterator ti;
+    for (ti = m_transforms.begin(); ti != m_transforms.end(); ++ti)
     {
-        m_cache = cache_type(m_cache_size);
-    
-        // Mark all positions as uncached and build up the mask
-        // to the size of the number of points in the file
-        boost::uint8_t const uncached_mask = 0;
-        cache_mask_type(m_header->GetPointRecordsCount(), uncached_mask).swap(m_mask);
- 
-        m_cache_initialized = true;
-    }
-    if (m_mask[position] == 1) {
-        m_cache_read_position = position;
-        *m_point =  m_cache[cache_position];
-        return;
-    } else {
-
-        CacheData(position);
-        
-        // At this point, we can't have a negative cache position.
-        // If we do, it's a big error or we'll segfault.
-        cache_position = position - m_cache_start_position ;
-        if (cache_position < 0) {
-            std::ostringstream msg;
-            msg  << "ReadCachedPoint:: cache position: " 
-                 << cache_position 
-                 << " is negative. position or m_cache_start_position is invalid "
-                 << "position: " << position << " m_cache_start_position: "
-                 << m_cache_start_position;
-            throw std::runtime_error(msg.str());
-        }
-            
-        if (m_mask[position] == 1) {
-            if (static_cast<uint32_t>(cache_position) > m_cache.size()) {
-                std::ostringstream msg;
-                msg << "ReadCachedPoint:: cache position: " 
-                    << position 
-                    << " greater than cache size: " << m_cache.size() ;
-                throw std::runtime_error(msg.str());
-            }
-            *m_point = m_cache[cache_position];
-            return;
-        } else {
-            std::ostringstream msg;
-            msg << "ReadCachedPoint:: unable to obtain cached point"
-                << " at position: " << position 
-                << " cache_position was " << cache_position ;
-            std::string out(msg.str());
-            
-            throw std::runtime_error(out);
-        }
+        (*ti)->transform(p);
     }
 }
 
 void CachedReaderImpl::ReadNextPoint()
 {
-    if (m_cache_read_position == m_size )
+    if (!m_filters.empty())
     {
-        throw std::out_of_range("file has no more points to read, end of file reached");
+        // Filter a block of points at a time and hand the survivors out 
+        // one by one, just like ReaderImpl does.
+        while (m_block_position >= m_block.size())
+        {
+            if (!CopyBlock())
+                throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+        }
+
+        m_block.GetPoint(m_block_position, m_point);
+        m_next_index = m_block_ids[m_block_position] + 1;
+        ++m_block_position;
+    }
+    else
+    {
+        if (m_position >= m_size)
+            throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+
+        ReadRecord(m_position);
+        ++m_position;
+        m_next_index = m_position;
     }
-    
-    // PointPtr ptr = ReadCachedPoint(m_cache_read_position, header);
-    ReadCachedPoint(m_cache_read_position);
-    ++m_cache_read_position;
 
-    // Filter the points and continue reading until we either find 
-    // one to keep or throw an exception.
+    if (!m_transforms.empty())
+        TransformPoint(m_point);
+}
 
-    bool bLastPoint = false;
-    if (!FilterPoint(*m_point))
+std::size_t CachedReaderImpl::ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n)
+{
+    buffer.SetHeader(&GetHeader());
+    buffer.clear();
+    buffer.reserve(n);
+
+    // Points already read and filtered come first.  Without filters 
+    // the rest is copied straight into the buffer, with filters whole 
+    // blocks are filtered and their survivors handed out.
+    while (buffer.size() < n)
     {
-        ReadCachedPoint(m_cache_read_position);
-        ++m_cache_read_position;
-
-        while (!FilterPoint(*m_point))
+        if (m_block_position < m_block.size())
+        {
+            DrainBlock(m_block, m_block_position, buffer, n - buffer.size());
+            m_next_index = m_block_ids[m_block_position - 1] + 1;
+        }
+        else if (m_filters.empty())
         {
-            ReadCachedPoint(m_cache_read_position);
-            ++m_cache_read_position;
-            if (m_current == m_size) 
-            {
-                bLastPoint = true;
+            if (0 == CopyRecords(buffer, n - buffer.size()))
                 break;
-            }
+            m_next_index = m_position;
+        }
+        else if (!CopyBlock())
+        {
+            break;
         }
     }
 
-    if (bLastPoint)
-        throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
-    
+    TransformPoints(m_transforms, buffer, m_point);
+
+    return buffer.size();
 }
 
-liblas::Point const& CachedReaderImpl::ReadPointAt(std::size_t n)
+void CachedReaderImpl::CheckPosition(std::size_t n, char const* caller) const
 {
-
-    if (n >= m_size ){
+    if (m_size == n) {
         throw std::out_of_range("file has no more points to read, end of file reached");
-    
     } else if (m_size < n) {
-        std::ostringstream output;
-        output << "ReadPointAt:: Inputted value: " 
-               << n << " is greater than the number of points: " 
-               << m_size;
-        std::string out(output.str());
-        throw std::runtime_error(out);
-    }
-    
-    ReadCachedPoint(n);
-    m_cache_read_position = n;
-    return *m_point;
+        std::ostringstream msg;
+        msg << caller << ":: Inputted value: " << n << " is greater than the number of points: " << m_size;
+        throw std::runtime_error(msg.str());
+    } 
 }
 
-void CachedReaderImpl::Reset()
+liblas::Point const& CachedReaderImpl::ReadPointAt(std::size_t n)
 {
-    if (m_mask.empty())
-    {    
-        ReaderImpl::Reset();
-        return;
-    }
+    CheckPosition(n, "ReadPointAt");
 
-    typedef cache_mask_type::size_type size_type;
-    size_type old_cache_start_position = m_cache_start_position;
-    size_type header_size = static_cast<size_type>(m_header->GetPointRecordsCount());
-    size_type to_mark = (std::min)(m_cache_size, header_size - old_cache_start_position); 
+    m_block.clear();
+    m_block_position = 0;
 
-    for (uint32_t i = 0; i < to_mark; ++i) {
+    ReadRecord(n);
+    m_position = n + 1;
+    m_next_index = m_position;
+
+    if (!m_transforms.empty())
+        TransformPoint(m_point);
+
+    return m_point;
+}
+
+void CachedReaderImpl::ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t /* gap */)
+{
+    // Pages already coalesce the reads, so all we need is to visit the 
+    // ids in order to look each page up once.
+    PointRequest request;
+    std::vector<PointRun> runs;
+    PlanPointRuns(ids, 0, request, runs);
+
+    buffer.SetHeader(&GetHeader());
+    buffer.clear();
+    buffer.resize(ids.size());
+
+    PointRequest::const_iterator ri;
+    for (ri = request.begin(); ri != request.end(); ++ri)
+    {
+        // The header's point count was checked by Reader::ReadPointsAt, 
+        // so an id past m_size is a record the file is missing.
+        if (ri->first >= m_size)
+            throw std::out_of_range("ReadPointsAt: file has no more points to read, end of file reached");
 
-        size_type const mark_pos = m_cache_start_position + i;
-        assert(mark_pos < m_mask.size());
+        SharedPageCache::PagePtr const& page = GetPage(ri->first / m_page_size);
+        std::size_t const i = ri->first % m_page_size;
+        if (i >= page->size())
+            throw std::out_of_range("ReadPointsAt: file has no more points to read, end of file reached");
 
-        m_mask[mark_pos] = 0;
+        std::memcpy(buffer.GetRecord(ri->second), page->GetRecord(i), m_record_length);
     }
 
-    m_cache_start_position = 0;
-    m_cache_read_position = 0;
-    m_cache_initialized = false;
+    m_block.clear();
+    m_block_position = 0;
 
-    ReaderImpl::Reset();
+    TransformPoints(m_transforms, buffer, m_point);
 }
 
 void CachedReaderImpl::Seek(std::size_t n)
 {
+    CheckPosition(n, "Seek");
 
-   if (n < 1) {
-       CachedReaderImpl::Reset();
-   }
-   
-   m_cache_read_position = n;
-   ReaderImpl::Seek(n);
+    m_position = n;
+    m_next_index = n;
+    m_block.clear();
+    m_block_position = 0;
+}
+
+void CachedReaderImpl::Reset()
+{
+    m_position = 0;
+    m_next_index = 0;
+    m_block.clear();
+    m_block_position = 0;
 }
 
 void CachedReaderImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
 {
-    Reset();
-    ReaderImpl::SetFilters(filters);
+    m_filters = filters;
+
+    // The points read ahead went through the old filters.  Go back to 
+    // the first record not handed out yet and filter again from there.
+    if (m_next_index < m_position)
+        m_position = m_next_index;
+
+    m_block.clear();
+    m_block_position = 0;
 }
-std::vector<liblas::FilterPtr>  CachedReaderImpl::GetFilters() const
+
+std::vector<liblas::FilterPtr> CachedReaderImpl::GetFilters() const
 {
-    return ReaderImpl::GetFilters();
+    return m_filters;
 }
 
 void CachedReaderImpl::SetTransforms(std::vector<liblas::TransformPtr> const& transforms)
 {
-    // Setting transforms means the cache is invalid
-    Reset();
-    ReaderImpl::SetTransforms(transforms);
-
+    m_transforms = transforms;
 }
 
-std::vector<liblas::TransformPtr>  CachedReaderImpl::GetTransforms() const
+std::vector<liblas::TransformPtr> CachedReaderImpl::GetTransforms() const
 {
-    return ReaderImpl::GetTransforms();
+    return m_transforms;
 }
-}} // namespace liblas::detail
 
+}} // namespace liblas::detail
@@ -0,0 +1,378 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Parallel LASzip chunk decoder
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifdef HAVE_LASZIP
+
+#include <liblas/liblas.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/reader/chunkdecoder.hpp>
+#include <liblas/detail/zippoint.hpp>
+// laszip
+#include <laszip/laszip.hpp>
+#include <laszip/lasunzipper.hpp>
+// boost
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+#include <sstream>
+#include <stdexcept>
+
+namespace liblas { namespace detail { 
+
+SharedStreamBuffer::SharedStreamBuffer(std::istream& source, boost::mutex& mutex, std::size_t size)
+    : m_source(source)
+    , m_mutex(mutex)
+    , m_buffer(size)
+    , m_offset(0)
+{
+    setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+}
+
+SharedStreamBuffer::int_type SharedStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    std::streamoff const offset = m_offset + (egptr() - eback());
+
+    std::streamsize got = 0;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_source.clear();
+        m_source.seekg(offset, std::ios::beg);
+        m_source.read(&m_buffer[0], static_cast<std::streamsize>(m_buffer.size()));
+        got = m_source.gcount();
+    }
+
+    m_offset = offset;
+    setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + got);
+
+    if (0 == got)
+        return traits_type::eof();
+    return traits_type::to_int_type(*gptr());
+}
+
+SharedStreamBuffer::pos_type SharedStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    std::streamoff target = off;
+    if (dir == std::ios_base::cur)
+    {
+        target += m_offset + (gptr() - eback());
+    } 
+    else if (dir == std::ios_base::end)
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_source.clear();
+        m_source.seekg(0, std::ios::end);
+        target += static_cast<std::streamoff>(m_source.tellg());
+    }
+
+    if (target < 0)
+        return pos_type(off_type(-1));
+
+    // Stay in the buffer if we can, it is usually a short hop.
+    if (target >= m_offset && target <= m_offset + (egptr() - eback()))
+    {
+        setg(eback(), eback() + (target - m_offset), egptr());
+    }
+    else
+    {
+        m_offset = target;
+        setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+    }
+    return pos_type(target);
+}
+
+SharedStreamBuffer::pos_type SharedStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+// Everything one thread needs to decode chunks on its own.
+struct ChunkDecoder::Worker
+{
+    Worker(std::istream& source, boost::mutex& mutex, liblas::Header const& header)
+        : buffer(source, mutex)
+        , stream(&buffer)
+        , point(header.GetDataFormatId(), header.GetVLRs())
+    {
+        stream.seekg(header.GetDataOffset(), std::ios::beg);
+        if (!unzipper.open(stream, point.GetZipper()))
+        {
+            std::ostringstream oss;
+            const char* err = unzipper.get_error();
+            if (err==NULL) err="(unknown error)";
+            oss << "Failed to open LASzip stream: " << std::string(err);
+            throw liblas_error(oss.str());
+        }
+    }
+
+    ~Worker()
+    {
+        unzipper.close();
+    }
+
+    SharedStreamBuffer buffer;
+    std::istream stream;
+    ZipPoint point;
+    LASunzipper unzipper;
+};
+
+ChunkDecoder::ChunkDecoder(std::istream& ifs, liblas::Header const& header, 
+                           std::size_t threads, std::size_t window)
+    : m_header(header)
+    , m_threads(threads)
+    , m_window(window ? window : 2 * threads)
+    , m_size(header.GetPointRecordsCount())
+    , m_chunk_size(0)
+    , m_chunks(0)
+    , m_next(0)
+    , m_wanted(0)
+    , m_stop(false)
+    , m_position(0)
+    , m_skip(0)
+{
+    if (0 == m_threads)
+        throw configuration_error("ChunkDecoder: thread count must be at least 1");
+
+    for (std::size_t i = 0; i < m_threads; ++i)
+        m_workers.push_back(WorkerPtr(new Worker(ifs, m_stream_mutex, header)));
+
+    LASzip const* zip = m_workers.front()->point.GetZipper();
+    if (zip->compressor != LASZIP_COMPRESSOR_POINTWISE_CHUNKED || 0 == zip->chunk_size)
+        throw configuration_error("ChunkDecoder: LASzip stream is not chunked");
+
+    m_chunk_size = zip->chunk_size;
+    m_chunks = (m_size + m_chunk_size - 1) / m_chunk_size;
+}
+
+ChunkDecoder::~ChunkDecoder()
+{
+    Stop();
+}
+
+void ChunkDecoder::Decode(Worker& worker, std::size_t chunk, liblas::PointBuffer& buffer)
+{
+    std::size_t const first = chunk * m_chunk_size;
+    std::size_t const count = (std::min)(m_chunk_size, m_size - first);
+
+    // Seeking to the first point of a chunk jumps straight to it 
+    // through the chunk table without decoding anything.
+    if (!worker.unzipper.seek(static_cast<unsigned int>(first)))
+    {
+        std::ostringstream oss;
+        oss << "Error seeking to compressed chunk " << chunk << ": " << std::string(worker.unzipper.get_error());
+        throw liblas_error(oss.str());
+    }
+
+    assert(worker.point.m_lz_point_size == buffer.GetRecordLength());
+
+    buffer.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        worker.point.SetData(buffer.GetRecord(i));
+        if (!worker.unzipper.read(worker.point.m_lz_point))
+        {
+            std::ostringstream oss;
+            oss << "Error reading compressed point data: " << std::string(worker.unzipper.get_error());
+            throw liblas_error(oss.str());
+        }
+    }
+}
+
+void ChunkDecoder::Run(std::size_t w)
+{
+    Worker& worker = *m_workers[w];
+
+    for (;;)
+    {
+        std::size_t chunk = 0;
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            while (!m_stop && (m_next >= m_chunks || m_next >= m_wanted + m_window))
+                m_cond.wait(lock);
+
+            if (m_stop)
+                return;
+
+            chunk = m_next++;
+        }
+
+        BufferPtr buffer(new liblas::PointBuffer(&m_header, m_chunk_size));
+        std::string error;
+        try
+        {
+            Decode(worker, chunk, *buffer);
+        } catch (std::exception const& e)
+        {
+            error = e.what();
+            if (error.empty())
+                error = "ChunkDecoder: error decoding chunk";
+        }
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (error.empty())
+        {
+            m_ready.insert(std::make_pair(chunk, buffer));
+        } 
+        else if (m_error.empty())
+        {
+            m_error = error;
+        }
+        m_cond.notify_all();
+    }
+}
+
+bool ChunkDecoder::NextChunk()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    m_front.reset();
+    m_position = 0;
+
+    if (m_wanted >= m_chunks)
+        return false;
+
+    if (m_pool.empty())
+    {
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+            m_pool.push_back(ThreadPtr(new boost::thread(boost::bind(&ChunkDecoder::Run, this, i))));
+    }
+
+    std::map<std::size_t, BufferPtr>::iterator i;
+    while ((i = m_ready.find(m_wanted)) == m_ready.end() && m_error.empty())
+        m_cond.wait(lock);
+
+    if (i == m_ready.end())
+        throw liblas_error(m_error);
+
+    m_front = i->second;
+    m_ready.erase(i);
+    ++m_wanted;
+
+    // Room for one more chunk in the window
+    m_cond.notify_all();
+
+    m_position = m_skip;
+    m_skip = 0;
+    return true;
+}
+
+std::size_t ChunkDecoder::Read(liblas::PointBuffer& buffer, std::size_t n)
+{
+    std::size_t const record_length = buffer.GetRecordLength();
+    std::size_t copied = 0;
+    while (copied < n)
+    {
+        if (!m_front || m_position >= m_front->size())
+        {
+            if (!NextChunk())
+                break;
+            continue;
+        }
+
+        std::size_t const count = (std::min)(n - copied, m_front->size() - m_position);
+        std::size_t const first = buffer.size();
+        buffer.resize(first + count);
+        std::memcpy(buffer.GetRecord(first), m_front->GetRecord(m_position), count * record_length);
+
+        m_position += count;
+        copied += count;
+    }
+    return copied;
+}
+
+void ChunkDecoder::Start(std::size_t n)
+{
+    Stop();
+
+    m_ready.clear();
+    m_error.clear();
+    m_front.reset();
+    m_position = 0;
+
+    m_wanted = (std::min)(n / m_chunk_size, m_chunks);
+    m_next = m_wanted;
+    m_skip = n % m_chunk_size;
+}
+
+void ChunkDecoder::Stop()
+{
+    if (m_pool.empty())
+        return;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+
+    for (std::size_t i = 0; i < m_pool.size(); ++i)
+        m_pool[i]->join();
+    m_pool.clear();
+    m_stop = false;
+
+    // Chunks handed to workers but not finished were dropped, so pick 
+    // up again right after what was read.
+    m_next = m_wanted;
+    std::map<std::size_t, BufferPtr>::iterator i = m_ready.begin();
+    while (i != m_ready.end())
+    {
+        if (i->first >= m_wanted + m_window)
+            m_ready.erase(i++);
+        else
+            ++i;
+    }
+    while (m_ready.find(m_next) != m_ready.end())
+        ++m_next;
+}
+
+}} // namespace liblas::detail
+
+#endif // HAVE_LASZIP
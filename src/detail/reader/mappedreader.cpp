@@ -0,0 +1,391 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Memory-mapped LAS reader implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/liblas.hpp>
+#include <liblas/detail/reader/mappedreader.hpp>
+#include <liblas/detail/reader/reader.hpp>
+#include <liblas/detail/private_utility.hpp>
+// boost
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+// std
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+#include <cassert>
+
+namespace liblas { namespace detail { 
+
+MappedReaderImpl::MappedReaderImpl(std::string const& filename)
+    : m_filename(filename)
+    , m_ifs(filename.c_str(), std::ios::in | std::ios::binary)
+    , m_size(0)
+    , m_current(0)
+    , m_header_reader(new reader::Header(m_ifs))
+    , m_header(HeaderPtr())
+    , m_point(PointPtr(new liblas::Point()))
+    , m_filters(0)
+    , m_transforms(0)
+    , m_record_size(0)
+    , bNeedHeaderCheck(false)
+    , m_data(0)
+    , m_block_position(0)
+    , m_next_index(0)
+{
+    if (!m_ifs.is_open())
+    {
+        std::ostringstream msg;
+        msg << "MappedReaderImpl: unable to open file '" << filename << "' for reading";
+        throw std::runtime_error(msg.str());
+    }
+}
+
+MappedReaderImpl::~MappedReaderImpl()
+{
+}
+
+void MappedReaderImpl::Map()
+{
+    using namespace boost::interprocess;
+
+    m_region.reset();
+    m_data = 0;
+    m_size = 0;
+
+    // Never map past the end of the file, even if the header claims 
+    // more points than the file actually holds.
+    m_ifs.clear();
+    m_ifs.seekg(0, std::ios::end);
+    std::streamoff const file_size = m_ifs.tellg();
+    std::streamoff const offset = m_header->GetDataOffset();
+
+    std::size_t available = 0;
+    if (file_size > offset)
+        available = static_cast<std::size_t>(file_size - offset) / m_record_size;
+
+    m_size = static_cast<boost::uint32_t>(
+        (std::min)(available, static_cast<std::size_t>(m_header->GetPointRecordsCount())));
+
+    if (0 == m_size)
+        return;
+
+    try
+    {
+        if (!m_mapping)
+            m_mapping.reset(new file_mapping(m_filename.c_str(), read_only));
+
+        m_region.reset(new mapped_region(*m_mapping, 
+                                         read_only, 
+                                         static_cast<offset_t>(offset), 
+                                         m_size * m_record_size));
+    } catch (interprocess_exception const& e)
+    {
+        std::ostringstream msg;
+        msg << "MappedReaderImpl: unable to map '" << m_filename << "': " << e.what();
+        throw std::runtime_error(msg.str());
+    }
+
+    m_data = static_cast<boost::uint8_t const*>(m_region->get_address());
+}
+
+void MappedReaderImpl::Reset()
+{
+    // The mapping is set up once per header, resetting only 
+    // has to rewind the cursor.
+    m_current = 0;
+    m_next_index = 0;
+    m_block.clear();
+    m_block_position = 0;
+}
+
+void MappedReaderImpl::TransformPoint(liblas::Point& p)
+{    
+    std::vector<liblas::TransformPtr>::const_iterator ti;
+
+    for (ti = m_transforms.begin(); ti != m_transforms.end(); ++ti)
+    {
+        (*ti)->transform(p);
+    }            
+}
+
+void MappedReaderImpl::ReadHeader()
+{
+    // If we're eof, we need to reset the state
+    if (m_ifs.eof())
+        m_ifs.clear();
+    
+    m_header_reader->ReadHeader();
+    m_header = m_header_reader->GetHeader();
+    
+    if (m_header->Compressed())
+        throw configuration_error("Compressed files are not readable with mapped reader");
+
+    m_point->SetHeader(m_header.get());
+    m_record_size = m_header->GetDataRecordLength();
+
+    Map();
+    Reset();
+}
+
+void MappedReaderImpl::SetHeader(liblas::Header const& header) 
+{
+    m_header = HeaderPtr(new liblas::Header(header));
+    m_point->SetHeader(m_header.get());
+}
+
+boost::uint8_t const* MappedReaderImpl::GetRecord(std::size_t n) const
+{
+    assert(n < m_size);
+    return m_data + n * m_record_size;
+}
+
+void MappedReaderImpl::CopyRecord(std::size_t n)
+{
+    if (bNeedHeaderCheck) 
+    {
+        if (!(m_point->GetHeader() == m_header.get()))
+            m_point->SetHeader(m_header.get());
+    }
+
+    std::memcpy(&(m_point->GetData().front()), GetRecord(n), m_record_size);
+}
+
+bool MappedReaderImpl::CopyBlock()
+{
+    m_block.SetHeader(m_header.get());
+    m_block.clear();
+    m_block_position = 0;
+
+    std::size_t const count = (std::min)(filter_block_size, 
+                                         static_cast<std::size_t>(m_size - m_current));
+    if (0 == count)
+        return false;
+
+    m_block.resize(count);
+    std::memcpy(m_block.GetRecord(0), GetRecord(m_current), count * m_record_size);
+
+    m_block_ids.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_block_ids[i] = static_cast<boost::uint32_t>(m_current + i);
+    m_current += static_cast<boost::uint32_t>(count);
+
+    FilterPoints(m_filters, m_block, 0, &m_block_ids);
+    return true;
+}
+
+void MappedReaderImpl::ReadNextPoint()
+{
+    if (!m_filters.empty())
+    {
+        if (bNeedHeaderCheck) 
+        {
+            if (!(m_point->GetHeader() == m_header.get()))
+                m_point->SetHeader(m_header.get());
+        }
+
+        // Filter a block of points at a time and hand the survivors out 
+        // one by one, just like ReaderImpl does.
+        while (m_block_position >= m_block.size())
+        {
+            if (!CopyBlock())
+                throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+        }
+
+        m_block.GetPoint(m_block_position, *m_point);
+        m_next_index = m_block_ids[m_block_position] + 1;
+        ++m_block_position;
+    }
+    else
+    {
+        if (m_current >= m_size)
+            throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+
+        CopyRecord(m_current);
+        ++m_current;
+        m_next_index = m_current;
+    }
+
+    if (!m_transforms.empty())
+        TransformPoint(*m_point);
+}
+
+std::size_t MappedReaderImpl::ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n)
+{
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.reserve(n);
+
+    std::size_t const record_length = buffer.GetRecordLength();
+    assert(record_length == m_record_size);
+
+    // Points already copied and filtered come first.  Without filters 
+    // the rest is copied straight into the buffer, with filters whole 
+    // blocks are filtered and their survivors handed out.
+    while (buffer.size() < n)
+    {
+        if (m_block_position < m_block.size())
+        {
+            DrainBlock(m_block, m_block_position, buffer, n - buffer.size());
+            m_next_index = m_block_ids[m_block_position - 1] + 1;
+        }
+        else if (m_filters.empty())
+        {
+            std::size_t const first = buffer.size();
+            std::size_t const wanted = (std::min)(n - first, 
+                                                  static_cast<std::size_t>(m_size - m_current));
+            if (0 == wanted)
+                break;
+
+            buffer.resize(first + wanted);
+            std::memcpy(buffer.GetRecord(first), GetRecord(m_current), wanted * record_length);
+            m_current += static_cast<boost::uint32_t>(wanted);
+            m_next_index = m_current;
+        }
+        else if (!CopyBlock())
+        {
+            break;
+        }
+    }
+
+    TransformPoints(m_transforms, buffer, *m_point);
+
+    return buffer.size();
+}
+
+liblas::Point const& MappedReaderImpl::ReadPointAt(std::size_t n)
+{
+    if (m_size == n) {
+        throw std::out_of_range("file has no more points to read, end of file reached");
+    } else if (m_size < n) {
+        std::ostringstream msg;
+        msg << "ReadPointAt:: Inputted value: " << n << " is greater than the number of points: " << m_size;
+        throw std::runtime_error(msg.str());
+    } 
+
+    CopyRecord(n);
+
+    if (!m_transforms.empty())
+    {
+        TransformPoint(*m_point);
+    }
+    return *m_point;
+}
+
+void MappedReaderImpl::ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t /* gap */)
+{
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.resize(ids.size());
+
+    // Every record is already in the mapping, so there is nothing to 
+    // coalesce and the points are copied in the order asked for.
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        // The header's point count was checked by Reader::ReadPointsAt, 
+        // so an id past m_size is a record the file is missing.
+        if (ids[i] >= m_size)
+            throw std::out_of_range("ReadPointsAt: file has no more points to read, end of file reached");
+
+        std::memcpy(buffer.GetRecord(i), GetRecord(ids[i]), m_record_size);
+    }
+
+    TransformPoints(m_transforms, buffer, *m_point);
+}
+
+void MappedReaderImpl::Seek(std::size_t n)
+{
+    if (m_size == n) {
+        throw std::out_of_range("file has no more points to read, end of file reached");
+    } else if (m_size < n) {
+        std::ostringstream msg;
+        msg << "Seek:: Inputted value: " << n << " is greater than the number of points: " << m_size;
+        throw std::runtime_error(msg.str());
+    } 
+
+    m_current = static_cast<boost::uint32_t>(n);
+    m_next_index = m_current;
+    m_block.clear();
+    m_block_position = 0;
+}
+
+void MappedReaderImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
+{
+    m_filters = filters;
+
+    // The points copied ahead went through the old filters.  Go back to 
+    // the first record not handed out yet and filter again from there.
+    if (m_next_index < m_current)
+        m_current = m_next_index;
+
+    m_block.clear();
+    m_block_position = 0;
+}
+
+std::vector<liblas::FilterPtr>  MappedReaderImpl::GetFilters() const
+{
+    return m_filters;
+}
+
+void MappedReaderImpl::SetTransforms(std::vector<liblas::TransformPtr> const& transforms)
+{
+    m_transforms = transforms;
+    
+    // Transforms are allowed to change the point, including moving the 
+    // point's HeaderPtr.  We need to check if we need to set that 
+    // back on any subsequent reads.
+    for (std::vector<liblas::TransformPtr>::const_iterator i = transforms.begin(); i != transforms.end(); i++)
+    {
+        if (i->get()->ModifiesHeader())
+            bNeedHeaderCheck = true;
+    }
+}
+
+std::vector<liblas::TransformPtr>  MappedReaderImpl::GetTransforms() const
+{
+    return m_transforms;
+}
+
+}} // namespace liblas::detail
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  LRU cache of point record pages
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/detail/reader/pagecache.hpp>
+
+namespace liblas { namespace detail { 
+
+PageCache::PageCache(std::size_t budget)
+    : m_budget(budget)
+    , m_bytes(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+    , m_served(0)
+{
+}
+
+PageCache::PagePtr PageCache::Find(PageKey const& key)
+{
+    page_map::iterator i = m_pages.find(key);
+    if (i == m_pages.end())
+    {
+        ++m_misses;
+        return PagePtr();
+    }
+
+    ++m_hits;
+    m_served += i->second.bytes;
+    m_lru.splice(m_lru.begin(), m_lru, i->second.lru);
+    return i->second.data;
+}
+
+void PageCache::Insert(PageKey const& key, PagePtr data)
+{
+    page_map::iterator i = m_pages.find(key);
+    if (i != m_pages.end())
+        Erase(i);
+
+    Entry entry;
+    entry.data = data;
+    entry.bytes = data->size() * data->GetRecordLength();
+    entry.lru = m_lru.insert(m_lru.begin(), key);
+
+    m_pages.insert(page_map::value_type(key, entry));
+    m_bytes += entry.bytes;
+
+    Evict();
+}
+
+void PageCache::Clear()
+{
+    m_pages.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+void PageCache::SetBudget(std::size_t budget)
+{
+    m_budget = budget;
+    Evict();
+}
+
+void PageCache::Erase(page_map::iterator i)
+{
+    m_bytes -= i->second.bytes;
+    m_lru.erase(i->second.lru);
+    m_pages.erase(i);
+}
+
+void PageCache::Evict()
+{
+    if (0 == m_budget)
+        return;
+
+    while (m_bytes > m_budget && m_pages.size() > 1)
+    {
+        Erase(m_pages.find(m_lru.back()));
+        ++m_evictions;
+    }
+}
+
+}} // namespace liblas::detail
@@ -0,0 +1,439 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Read-ahead LAS reader implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/detail/reader/prefetchreader.hpp>
+#include <liblas/detail/reader/reader.hpp>
+#include <liblas/exception.hpp>
+// boost
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring> // std::memcpy
+#include <stdexcept>
+
+namespace liblas { namespace detail { 
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+PrefetchReaderImpl::PrefetchReaderImpl(ReaderIPtr reader, std::size_t block_size, std::size_t depth)
+    : m_reader(reader)
+    , m_block_size(block_size)
+    , m_depth(depth)
+    , m_position(0)
+    , m_next_index(0)
+    , m_read_index(0)
+    , m_stop(false)
+    , m_done(false)
+    , m_blocks(0)
+    , m_stalls(0)
+    , m_stall_time(0, 0, 0, 0)
+    , m_idle_time(0, 0, 0, 0)
+{
+    if (!m_reader)
+        throw liblas_error("PrefetchReaderImpl: reader to wrap is void");
+
+    if (0 == m_block_size || 0 == m_depth)
+        throw configuration_error("PrefetchReaderImpl: block size and depth must be at least 1");
+
+    for (std::size_t i = 0; i < m_depth; ++i)
+        m_free.push_back(BlockPtr(new Block));
+
+    // Filters and transforms are ours to apply, so we know which 
+    // records the points we hand out came from.
+    m_filters = m_reader->GetFilters();
+    m_transforms = m_reader->GetTransforms();
+    m_reader->SetFilters(std::vector<liblas::FilterPtr>());
+    m_reader->SetTransforms(std::vector<liblas::TransformPtr>());
+}
+
+PrefetchReaderImpl::~PrefetchReaderImpl()
+{
+    Stop();
+}
+
+void PrefetchReaderImpl::Run()
+{
+    for (;;)
+    {
+        BlockPtr block;
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (m_free.empty() && !m_stop)
+            {
+                ptime const start = microsec_clock::universal_time();
+                while (m_free.empty() && !m_stop)
+                    m_cond.wait(lock);
+                m_idle_time += microsec_clock::universal_time() - start;
+            }
+
+            if (m_stop)
+                return;
+
+            block = m_free.front();
+            m_free.pop_front();
+        }
+
+        std::size_t count = 0;
+        boost::exception_ptr error;
+        try
+        {
+            count = m_reader->ReadNextPoints(block->points, m_block_size);
+
+            block->ids.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+                block->ids[i] = static_cast<boost::uint32_t>(m_read_index + i);
+            m_read_index += static_cast<boost::uint32_t>(count);
+
+            FilterPoints(m_filters, block->points, 0, &block->ids);
+            TransformPoints(m_transforms, block->points, m_scratch);
+        } catch (std::out_of_range const&)
+        {
+            count = 0;
+        } 
+        // current_exception only knows the standard exception types, 
+        // so copy ours as what they are.
+        catch (liblas::invalid_expression const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (liblas::invalid_format const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (liblas::configuration_error const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (liblas::not_yet_implemented const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (liblas::liblas_error const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (liblas::invalid_point_data const& e)
+        {
+            error = boost::copy_exception(e);
+        } catch (...)
+        {
+            error = boost::current_exception();
+        }
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (count > 0 && !error)
+        {
+            // Blocks the filters emptied are read over again
+            if (block->points.empty())
+                m_free.push_back(block);
+            else
+                m_ready.push_back(block);
+            ++m_blocks;
+        } else
+        {
+            m_free.push_back(block);
+            m_error = error;
+            m_done = true;
+        }
+        m_cond.notify_all();
+
+        if (m_done)
+            return;
+    }
+}
+
+void PrefetchReaderImpl::Stop()
+{
+    if (!m_thread)
+        return;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+
+    m_thread->join();
+    m_thread.reset();
+    m_stop = false;
+}
+
+void PrefetchReaderImpl::Discard()
+{
+    assert(!m_thread);
+
+    if (m_front)
+        m_free.push_back(m_front);
+    m_front.reset();
+    m_position = 0;
+
+    while (!m_ready.empty())
+    {
+        m_free.push_back(m_ready.front());
+        m_ready.pop_front();
+    }
+
+    m_done = false;
+    m_error = boost::exception_ptr();
+}
+
+void PrefetchReaderImpl::Reposition()
+{
+    assert(!m_thread);
+
+    if (m_next_index < m_reader->GetHeader().GetPointRecordsCount())
+        m_reader->Seek(m_next_index);
+    else
+        m_done = true;
+}
+
+bool PrefetchReaderImpl::NextBlock()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    if (m_front)
+    {
+        m_free.push_back(m_front);
+        m_front.reset();
+        m_cond.notify_all();
+    }
+    m_position = 0;
+
+    if (!m_thread && !m_done)
+    {
+        m_read_index = m_next_index;
+        m_thread.reset(new boost::thread(&PrefetchReaderImpl::Run, this));
+    }
+
+    if (m_ready.empty() && !m_done)
+    {
+        ++m_stalls;
+        ptime const start = microsec_clock::universal_time();
+        while (m_ready.empty() && !m_done)
+            m_cond.wait(lock);
+        m_stall_time += microsec_clock::universal_time() - start;
+    }
+
+    if (!m_ready.empty())
+    {
+        m_front = m_ready.front();
+        m_ready.pop_front();
+        return true;
+    }
+
+    if (m_error)
+        boost::rethrow_exception(m_error);
+
+    return false;
+}
+
+liblas::Header const& PrefetchReaderImpl::GetHeader() const
+{
+    return m_reader->GetHeader();
+}
+
+void PrefetchReaderImpl::ReadHeader()
+{
+    Stop();
+    Discard();
+    m_reader->ReadHeader();
+    m_point.SetHeader(&m_reader->GetHeader());
+    m_next_index = 0;
+}
+
+void PrefetchReaderImpl::SetHeader(liblas::Header const& header)
+{
+    Stop();
+    Discard();
+    m_reader->SetHeader(header);
+    Reposition();
+}
+
+void PrefetchReaderImpl::ReadNextPoint()
+{
+    while (!m_front || m_position >= m_front->points.size())
+    {
+        if (!NextBlock())
+            throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+    }
+
+    m_front->points.GetPoint(m_position, m_point);
+    m_next_index = m_front->ids[m_position] + 1;
+    ++m_position;
+}
+
+std::size_t PrefetchReaderImpl::ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n)
+{
+    buffer.SetHeader(&m_reader->GetHeader());
+    buffer.clear();
+
+    while (buffer.size() < n)
+    {
+        if (!m_front || m_position >= m_front->points.size())
+        {
+            if (!NextBlock())
+                break;
+        }
+
+        liblas::PointBuffer& points = m_front->points;
+        std::size_t const available = points.size() - m_position;
+
+        if (buffer.empty() && 0 == m_position && available <= n)
+        {
+            // Hand over the whole block and keep the caller's storage 
+            // for the worker to fill next.
+            m_next_index = m_front->ids.back() + 1;
+            buffer.swap(points);
+            points.clear();
+            continue;
+        }
+
+        if (buffer.empty())
+            buffer.SetHeader(points.GetHeader());
+
+        assert(buffer.GetRecordLength() == points.GetRecordLength());
+
+        std::size_t const first = buffer.size();
+        std::size_t const count = (std::min)(available, n - first);
+
+        buffer.resize(first + count);
+        std::memcpy(buffer.GetRecord(first), 
+                    points.GetRecord(m_position), 
+                    count * buffer.GetRecordLength());
+        m_position += count;
+        m_next_index = m_front->ids[m_position - 1] + 1;
+    }
+
+    return buffer.size();
+}
+
+liblas::Point const& PrefetchReaderImpl::ReadPointAt(std::size_t n)
+{
+    Stop();
+    Discard();
+    m_point = m_reader->ReadPointAt(n);
+
+    std::vector<liblas::TransformPtr>::const_iterator ti;
+    for (ti = m_transforms.begin(); ti != m_transforms.end(); ++ti)
+        (*ti)->transform(m_point);
+
+    m_next_index = static_cast<boost::uint32_t>(n + 1);
+    Reposition();
+    return m_point;
+}
+
+void PrefetchReaderImpl::ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap)
+{
+    Stop();
+    Discard();
+    m_reader->ReadPointsAt(ids, buffer, gap);
+    TransformPoints(m_transforms, buffer, m_point);
+
+    if (!ids.empty())
+        m_next_index = *std::max_element(ids.begin(), ids.end()) + 1;
+    Reposition();
+}
+
+void PrefetchReaderImpl::Seek(std::size_t n)
+{
+    Stop();
+    Discard();
+    m_reader->Seek(n);
+    m_next_index = static_cast<boost::uint32_t>(n);
+}
+
+void PrefetchReaderImpl::Reset()
+{
+    Stop();
+    Discard();
+    m_reader->Reset();
+    m_next_index = 0;
+}
+
+void PrefetchReaderImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
+{
+    Stop();
+    Discard();
+    m_filters = filters;
+    Reposition();
+}
+
+std::vector<liblas::FilterPtr> PrefetchReaderImpl::GetFilters() const
+{
+    return m_filters;
+}
+
+void PrefetchReaderImpl::SetTransforms(std::vector<liblas::TransformPtr> const& transforms)
+{
+    Stop();
+    Discard();
+    m_transforms = transforms;
+    Reposition();
+}
+
+std::vector<liblas::TransformPtr> PrefetchReaderImpl::GetTransforms() const
+{
+    return m_transforms;
+}
+
+boost::uint64_t PrefetchReaderImpl::GetBlockCount() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_blocks;
+}
+
+boost::uint64_t PrefetchReaderImpl::GetStallCount() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_stalls;
+}
+
+double PrefetchReaderImpl::GetStallTime() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_stall_time.total_microseconds() / 1000000.0;
+}
+
+double PrefetchReaderImpl::GetIdleTime() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_idle_time.total_microseconds() / 1000000.0;
+}
+
+}} // namespace liblas::detail
@@ -51,12 +51,187 @@
 #include <stdexcept>
 #include <cstddef> // std::size_t
 #include <cstdlib> // std::free
+#include <cstring> // std::memcpy
+#include <algorithm>
 #include <cassert>
 
 using namespace boost;
 
 namespace liblas { namespace detail { 
 
+void FilterPoints(std::vector<liblas::FilterPtr> const& filters,
+                  liblas::PointBuffer& buffer,
+                  std::size_t first,
+                  std::vector<boost::uint32_t>* ids)
+{
+    if (filters.empty())
+        return;
+
+    std::size_t const record_length = buffer.GetRecordLength();
+    liblas::SelectionMask mask;
+
+    // Each filter only sees the survivors of the ones before it, just 
+    // like the point-at-a-time loop did, so stateful filters such as 
+    // ThinFilter count the same points.
+    std::vector<liblas::FilterPtr>::const_iterator fi;
+    for (fi = filters.begin(); fi != filters.end(); ++fi)
+    {
+        if (buffer.size() <= first)
+            break;
+
+        std::size_t const count = buffer.size() - first;
+        liblas::PointSpan span(buffer, first, count);
+        std::size_t const passed = (*fi)->filter_batch(span, mask);
+
+        if (passed == count)
+            continue;
+
+        std::size_t kept = first;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!mask[i])
+                continue;
+
+            if (kept != first + i)
+            {
+                std::memcpy(buffer.GetRecord(kept), buffer.GetRecord(first + i), record_length);
+                if (ids)
+                    (*ids)[kept] = (*ids)[first + i];
+            }
+            ++kept;
+        }
+        buffer.resize(kept);
+        if (ids)
+            ids->resize(kept);
+    }
+}
+
+std::size_t DrainBlock(liblas::PointBuffer const& block,
+                       std::size_t& position,
+                       liblas::PointBuffer& buffer,
+                       std::size_t n)
+{
+    if (position >= block.size())
+        return 0;
+
+    std::size_t const count = (std::min)(n, block.size() - position);
+    std::size_t const first = buffer.size();
+    buffer.resize(first + count);
+    std::memcpy(buffer.GetRecord(first), block.GetRecord(position), 
+                count * block.GetRecordLength());
+    position += count;
+    return count;
+}
+
+void TransformPoints(std::vector<liblas::TransformPtr> const& transforms,
+                     liblas::PointBuffer& buffer,
+                     liblas::Point& scratch)
+{
+    if (transforms.empty() || buffer.empty())
+        return;
+
+    bool bModifiesHeader = false;
+    std::vector<liblas::TransformPtr>::const_iterator ti;
+    for (ti = transforms.begin(); ti != transforms.end(); ++ti)
+    {
+        if ((*ti)->ModifiesHeader())
+            bModifiesHeader = true;
+    }
+
+    // Transforms that move the point onto a new header can change the 
+    // record layout, so those points are collected into a second buffer 
+    // that replaces the original one when we are done.
+    liblas::PointBuffer relaid;
+
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer.GetPoint(i, scratch);
+
+        for (ti = transforms.begin(); ti != transforms.end(); ++ti)
+        {
+            (*ti)->transform(scratch);
+        }
+
+        if (!bModifiesHeader)
+        {
+            buffer.SetPoint(i, scratch);
+            continue;
+        }
+
+        if (relaid.empty())
+        {
+            relaid.SetHeader(scratch.GetHeader());
+            relaid.reserve(buffer.size());
+        }
+        relaid.AddPoint(scratch);
+    }
+
+    if (bModifiesHeader)
+        buffer.swap(relaid);
+}
+
+void PlanPointRuns(std::vector<boost::uint32_t> const& ids,
+                   std::size_t gap,
+                   PointRequest& request,
+                   std::vector<PointRun>& runs)
+{
+    request.clear();
+    request.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        request.push_back(std::make_pair(ids[i], i));
+    }
+
+    // Index queries and chipper blocks mostly hand us sorted ids already.
+    for (std::size_t i = 1; i < request.size(); ++i)
+    {
+        if (request[i].first < request[i - 1].first)
+        {
+            std::sort(request.begin(), request.end());
+            break;
+        }
+    }
+
+    runs.clear();
+    std::size_t i = 0;
+    while (i < request.size())
+    {
+        PointRun run;
+        run.first = request[i].first;
+        run.begin = i;
+
+        std::size_t last = run.first;
+        for (++i; i < request.size(); ++i)
+        {
+            std::size_t const id = request[i].first;
+            // Duplicates are fine, they just copy the same record twice.
+            if (id > last && id - last - 1 > gap)
+                break;
+            last = id;
+        }
+
+        run.count = last - run.first + 1;
+        run.end = i;
+        runs.push_back(run);
+    }
+}
+
+void ScatterPointRun(PointRequest const& request,
+                     PointRun const& run,
+                     liblas::PointBuffer const& records,
+                     liblas::PointBuffer& buffer)
+{
+    std::size_t const record_length = buffer.GetRecordLength();
+    assert(record_length == records.GetRecordLength());
+
+    for (std::size_t i = run.begin; i < run.end; ++i)
+    {
+        std::memcpy(buffer.GetRecord(request[i].second), 
+                    records.GetRecord(request[i].first - run.first), 
+                    record_length);
+    }
+}
+
 ReaderImpl::ReaderImpl(std::istream& ifs)
     : m_ifs(ifs)
     , m_size(0)
@@ -68,6 +243,8 @@ ReaderImpl::ReaderImpl(std::istream& ifs)
     , m_filters(0)
     , m_transforms(0)
     , bNeedHeaderCheck(false)
+    , m_block_position(0)
+    , m_next_index(0)
 {
 
 }
@@ -86,6 +263,10 @@ void ReaderImpl::Reset()
     m_size = m_header->GetPointRecordsCount();
 
     m_record_size = m_header->GetSchema().GetByteSize();
+
+    m_block.clear();
+    m_block_position = 0;
+    m_next_index = 0;
 }
 
 void ReaderImpl::TransformPoint(liblas::Point& p)
@@ -96,8 +277,7 @@ void ReaderImpl::TransformPoint(liblas::Point& p)
 
     for (ti = m_transforms.begin(); ti != m_transforms.end(); ++ti)
     {
-        liblas::TransformPtr transform = *ti;
-        transform->transform(p);
+        (*ti)->transform(p);
     }            
 }
 
@@ -113,8 +293,7 @@ bool ReaderImpl::FilterPoint(liblas::Point const& p)
     std::vector<liblas::FilterPtr>::const_iterator fi;
     for (fi = m_filters.begin(); fi != m_filters.end(); ++fi)
     {
-        liblas::FilterPtr filter = *fi;
-        if (!filter->filter(p))
+        if (!(*fi)->filter(p))
         {
             return false;
         }
@@ -122,7 +301,51 @@ bool ReaderImpl::FilterPoint(liblas::Point const& p)
     return true;
 }
 
+std::size_t ReaderImpl::ReadRecords(liblas::PointBuffer& buffer, std::size_t n)
+{
+    if (0 == m_current)
+    {
+        m_ifs.clear();
+        m_ifs.seekg(m_header->GetDataOffset(), std::ios::beg);
+    }
+
+    std::size_t const first = buffer.size();
+    std::size_t const wanted = (std::min)(n, static_cast<std::size_t>(m_size - m_current));
+
+    if (0 == wanted || !m_ifs)
+        return 0;
+
+    std::size_t const record_length = buffer.GetRecordLength();
+
+    buffer.resize(first + wanted);
+    m_ifs.read(detail::as_buffer(buffer.GetRecord(first)), 
+               static_cast<std::streamsize>(wanted * record_length));
+
+    // A short read means the file holds fewer points than its 
+    // header claims.  Keep the complete records we got.
+    std::size_t const got = static_cast<std::size_t>(m_ifs.gcount()) / record_length;
+    buffer.resize(first + got);
+    m_current += static_cast<boost::uint32_t>(got);
+
+    return got;
+}
+
+bool ReaderImpl::ReadBlock()
+{
+    m_block.SetHeader(m_header.get());
+    m_block.clear();
+    m_block_position = 0;
+
+    boost::uint32_t const first = m_current;
+    std::size_t const got = ReadRecords(m_block, filter_block_size);
+
+    m_block_ids.resize(got);
+    for (std::size_t i = 0; i < got; ++i)
+        m_block_ids[i] = static_cast<boost::uint32_t>(first + i);
 
+    FilterPoints(m_filters, m_block, 0, &m_block_ids);
+    return got > 0;
+}
     
 void ReaderImpl::ReadHeader()
 {
@@ -150,6 +373,34 @@ void ReaderImpl::SetHeader(liblas::Header const& header)
     
 void ReaderImpl::ReadNextPoint()
 {
+    if (bNeedHeaderCheck) 
+    {
+        if (!(m_point->GetHeader() == m_header.get()))
+            m_point->SetHeader(m_header.get());
+    }
+
+    if (!m_filters.empty())
+    {
+        // Filter a block of points at a time and hand the survivors out 
+        // one by one, reading further blocks until we either find one 
+        // to keep or run out of points.
+        while (m_block_position >= m_block.size())
+        {
+            if (!ReadBlock())
+                throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+        }
+
+        m_block.GetPoint(m_block_position, *m_point);
+        m_next_index = m_block_ids[m_block_position] + 1;
+        ++m_block_position;
+
+        if (!m_transforms.empty())
+        {
+            TransformPoint(*m_point);
+        }
+        return;
+    }
+
     if (0 == m_current)
     {
         m_ifs.clear();
@@ -160,16 +411,11 @@ void ReaderImpl::ReadNextPoint()
         throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
     } 
 
-    if (bNeedHeaderCheck) 
-    {
-        if (!(m_point->GetHeader() == m_header.get()))
-            m_point->SetHeader(m_header.get());
-    }
-    
     try
     {
         detail::read_n(m_point->GetData().front(), m_ifs, m_record_size);
         ++m_current;
+        m_next_index = m_current;
         
     } catch (std::runtime_error&)
     {
@@ -178,59 +424,44 @@ void ReaderImpl::ReadNextPoint()
 
     }
 
-    // Filter the points and continue reading until we either find 
-    // one to keep or throw an exception.
-
-    bool bLastPoint = false;
-    
-    if (!m_filters.empty())
-    {
-        if (!FilterPoint(*m_point))
-        {
-
-            try
-            {
-                detail::read_n(m_point->GetData().front(), m_ifs, m_record_size);
-                ++m_current;
-        
-            } catch (std::runtime_error&)
-            {
-                // If the stream is no good anymore, we're done reading points
-                throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
-            }
-
-            while (!FilterPoint(*m_point))
-            {
-
-                try
-                {
-                    detail::read_n(m_point->GetData().front(), m_ifs, m_record_size);
-                    ++m_current;
-        
-                } catch (std::runtime_error&)
-                {
-                    // If the stream is no good anymore, we're done reading points
-                    throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
-                }
-                if (m_current == m_size) 
-                {
-                    bLastPoint = true;
-                    break;
-                }
-            }
-        }
-    }
-
-
     if (!m_transforms.empty())
     {
         TransformPoint(*m_point);
     }
+}
 
-    if (bLastPoint)
-        throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+std::size_t ReaderImpl::ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n)
+{
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.reserve(n);
+
+    // Points already read and filtered come first.  Without filters 
+    // the rest is read straight into the buffer.  With filters we read 
+    // and filter whole blocks, so the reads keep their size however 
+    // few points pass, and hand out the survivors.
+    while (buffer.size() < n)
+    {
+        if (m_block_position < m_block.size())
+        {
+            DrainBlock(m_block, m_block_position, buffer, n - buffer.size());
+            m_next_index = m_block_ids[m_block_position - 1] + 1;
+        }
+        else if (m_filters.empty())
+        {
+            if (0 == ReadRecords(buffer, n - buffer.size()))
+                break;
+            m_next_index = m_current;
+        }
+        else if (!ReadBlock())
+        {
+            break;
+        }
+    }
 
+    TransformPoints(m_transforms, buffer, *m_point);
 
+    return buffer.size();
 }
 
 liblas::Point const& ReaderImpl::ReadPointAt(std::size_t n)
@@ -248,6 +479,10 @@ liblas::Point const& ReaderImpl::ReadPointAt(std::size_t n)
     m_ifs.clear();
     m_ifs.seekg(pos, std::ios::beg);
 
+    m_block.clear();
+    m_block_position = 0;
+    m_next_index = m_current;
+
     if (bNeedHeaderCheck) 
     {
         if (!(m_point->GetHeader() == m_header.get()))
@@ -263,6 +498,35 @@ liblas::Point const& ReaderImpl::ReadPointAt(std::size_t n)
     return *m_point;
 }
 
+void ReaderImpl::ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap)
+{
+    PointRequest request;
+    std::vector<PointRun> runs;
+    PlanPointRuns(ids, gap, request, runs);
+
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.resize(ids.size());
+
+    // One seek and one read per run.  The points in the gaps are read 
+    // and dropped, which is cheaper than seeking past them.
+    liblas::PointBuffer records(m_header.get(), 0);
+    std::vector<PointRun>::const_iterator ri;
+    for (ri = runs.begin(); ri != runs.end(); ++ri)
+    {
+        Seek(ri->first);
+
+        records.clear();
+        if (ReadRecords(records, ri->count) < ri->count)
+            throw std::out_of_range("ReadPointsAt: file has no more points to read, end of file reached");
+
+        ScatterPointRun(request, *ri, records, buffer);
+    }
+    m_next_index = m_current;
+
+    TransformPoints(m_transforms, buffer, *m_point);
+}
+
 void ReaderImpl::Seek(std::size_t n)
 {
     if (m_size == n) {
@@ -279,11 +543,23 @@ void ReaderImpl::Seek(std::size_t n)
     m_ifs.seekg(pos, std::ios::beg);
     
     m_current = n;
+    m_next_index = n;
+
+    m_block.clear();
+    m_block_position = 0;
 }
 
 void ReaderImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
 {
     m_filters = filters;
+
+    // The points read ahead went through the old filters.  Go back to 
+    // the first record not handed out yet and filter again from there.
+    if (m_next_index < m_current)
+        Seek(m_next_index);
+
+    m_block.clear();
+    m_block_position = 0;
 }
 
 std::vector<liblas::FilterPtr>  ReaderImpl::GetFilters() const
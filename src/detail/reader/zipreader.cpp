@@ -43,9 +43,13 @@
 
 #include <liblas/liblas.hpp>
 #include <liblas/detail/reader/zipreader.hpp>
+#include <liblas/detail/reader/reader.hpp>
+#include <liblas/detail/reader/chunkdecoder.hpp>
+#include <liblas/detail/chunksummary.hpp>
 #include <liblas/detail/private_utility.hpp>
 #include <liblas/detail/zippoint.hpp>
 // laszip
+#include <laszip/laszip.hpp>
 #include <laszip/lasunzipper.hpp>
 // boost
 #include <boost/cstdint.hpp>
@@ -56,6 +60,8 @@
 #include <stdexcept>
 #include <cstddef> // std::size_t
 #include <cstdlib> // std::free
+#include <cstring> // std::memcpy
+#include <algorithm>
 #include <cassert>
 
 using namespace boost;
@@ -63,7 +69,7 @@ using namespace boost;
 namespace liblas { namespace detail { 
 
 
-ZipReaderImpl::ZipReaderImpl(std::istream& ifs)
+ZipReaderImpl::ZipReaderImpl(std::istream& ifs, std::size_t threads)
     : m_ifs(ifs)
     , m_size(0)
     , m_current(0)
@@ -72,14 +78,22 @@ ZipReaderImpl::ZipReaderImpl(std::istream& ifs)
     , m_point(PointPtr(new liblas::Point()))
     , m_filters(0)
     , m_transforms(0)
+    , m_threads(threads)
+    , m_summary_chunk_size(0)
     , bNeedHeaderCheck(false)
     , m_zipReadStartPosition(0)
+    , m_block_position(0)
+    , m_next_index(0)
 {
-    return;
+    if (0 == m_threads)
+        throw configuration_error("ZipReaderImpl: thread count must be at least 1");
 }
 
 ZipReaderImpl::~ZipReaderImpl()
 {
+    // The decoder's threads read from the stream, stop them first.
+    m_decoder.reset();
+
     if (m_unzipper)
     {
         m_unzipper->close();
@@ -93,6 +107,8 @@ ZipReaderImpl::~ZipReaderImpl()
 
 void ZipReaderImpl::Reset()
 {
+    m_decoder.reset();
+
     m_ifs.clear();
     m_ifs.seekg(0);
 
@@ -100,6 +116,9 @@ void ZipReaderImpl::Reset()
     m_current = 0;
     m_size = m_header->GetPointRecordsCount();
 
+    m_block.clear();
+    m_block_position = 0;
+    m_next_index = 0;
 
     if (!m_zipPoint)
     {
@@ -110,6 +129,8 @@ void ZipReaderImpl::Reset()
     
     }
 
+    LoadSummaries();
+
     if (!m_unzipper)
     {
         boost::scoped_ptr<LASunzipper> z(new LASunzipper());
@@ -130,9 +151,98 @@ void ZipReaderImpl::Reset()
             throw liblas_error(oss.str());
         }
     }
+
+    LASzip const* zip = m_zipPoint->GetZipper();
+    if (m_threads > 1 && zip->compressor == LASZIP_COMPRESSOR_POINTWISE_CHUNKED && zip->chunk_size > 0)
+    {
+        boost::scoped_ptr<ChunkDecoder> d(new ChunkDecoder(m_ifs, *m_header, m_threads));
+        m_decoder.swap(d);
+    }
     return;
 }
 
+void ZipReaderImpl::LoadSummaries()
+{
+    m_summaries.clear();
+    m_summary_chunk_size = 0;
+
+    LASzip const* zip = m_zipPoint->GetZipper();
+    if (zip->compressor != LASZIP_COMPRESSOR_POINTWISE_CHUNKED || 0 == zip->chunk_size)
+        return;
+
+    std::vector<VariableRecord> const& vlrs = m_header->GetVLRs();
+    std::vector<VariableRecord>::const_iterator i;
+    for (i = vlrs.begin(); i != vlrs.end(); ++i)
+    {
+        ChunkSummaryLocation location;
+        if (!ReadChunkSummaryVLR(*i, location))
+            continue;
+
+        // Summaries that do not line up with the chunks, of a file that 
+        // was not closed properly say, are no use to us.
+        std::size_t const chunks = (m_size + zip->chunk_size - 1) / zip->chunk_size;
+        if (location.chunk_size != zip->chunk_size || location.count != chunks || 0 == location.offset)
+            return;
+
+        m_ifs.clear();
+        m_ifs.seekg(static_cast<std::streamoff>(location.offset), std::ios::beg);
+        if (ReadChunkSummaries(m_ifs, location.count, m_summaries))
+            m_summary_chunk_size = zip->chunk_size;
+        else
+            m_summaries.clear();
+        m_ifs.clear();
+        return;
+    }
+}
+
+std::size_t ZipReaderImpl::SkipChunks(std::size_t n)
+{
+    if (m_summaries.empty() || m_filters.empty() || m_current >= m_size)
+        return n;
+
+    std::size_t const chunk_size = m_summary_chunk_size;
+    std::size_t next = m_current;
+    while (next < m_size && next % chunk_size == 0)
+    {
+        // A chunk can go if one of the filters rejects all of it.  The 
+        // filters ahead of that one would have seen its points, so we 
+        // stop looking at a ThinFilter, which counts every point.
+        ChunkSummary const& summary = m_summaries[next / chunk_size];
+        bool skip = false;
+        std::vector<liblas::FilterPtr>::const_iterator f;
+        for (f = m_filters.begin(); f != m_filters.end() && !skip; ++f)
+        {
+            if (dynamic_cast<liblas::ThinFilter*>(f->get()))
+                break;
+            skip = !(*f)->filter_summary(summary, *m_header);
+        }
+
+        if (!skip)
+            break;
+        next += chunk_size;
+    }
+
+    if (next >= m_size)
+    {
+        if (m_decoder)
+            m_decoder->Stop();
+        m_current = m_size;
+        return 0;
+    }
+
+    if (next != m_current)
+    {
+        // The points skipped were never handed out
+        boost::uint32_t const next_index = m_next_index;
+        Seek(next);
+        m_next_index = next_index;
+    }
+
+    // Stop at the end of the chunk to look at the next one first
+    std::size_t const end = (m_current / chunk_size + 1) * chunk_size;
+    return (std::min)(n, end - m_current);
+}
+
 void ZipReaderImpl::TransformPoint(liblas::Point& p)
 {    
 
@@ -141,8 +251,7 @@ void ZipReaderImpl::TransformPoint(liblas::Point& p)
 
     for (ti = m_transforms.begin(); ti != m_transforms.end(); ++ti)
     {
-        liblas::TransformPtr transform = *ti;
-        transform->transform(p);
+        (*ti)->transform(p);
     }            
 }
 
@@ -158,8 +267,7 @@ bool ZipReaderImpl::FilterPoint(liblas::Point const& p)
     std::vector<liblas::FilterPtr>::const_iterator fi;
     for (fi = m_filters.begin(); fi != m_filters.end(); ++fi)
     {
-        liblas::FilterPtr filter = *fi;
-        if (!filter->filter(p))
+        if (!(*fi)->filter(p))
         {
             return false;
         }
@@ -171,6 +279,8 @@ bool ZipReaderImpl::FilterPoint(liblas::Point const& p)
     
 void ZipReaderImpl::ReadHeader()
 {
+    m_decoder.reset();
+
     // If we're eof, we need to reset the state
     if (m_ifs.eof())
         m_ifs.clear();
@@ -190,7 +300,7 @@ void ZipReaderImpl::SetHeader(liblas::Header const& header)
     m_header = HeaderPtr(new liblas::Header(header));
 }
     
-void ZipReaderImpl::ReadIdiom()
+void ZipReaderImpl::DecodeNext()
 {
     bool ok = false;
 
@@ -203,72 +313,154 @@ void ZipReaderImpl::ReadIdiom()
         throw liblas_error(oss.str());
     }
 
-    {
-        std::vector<boost::uint8_t>& data = m_point->GetData();
+    ++m_current;
+}
 
-        unsigned int size = m_zipPoint->m_lz_point_size;
-        assert(size == data.size());
-        
-        unsigned char* p = m_zipPoint->m_lz_point_data.get();
-        data.assign(p, p+size);
+void ZipReaderImpl::ReadIdiom()
+{
+    PointData& data = m_point->GetData();
+    assert(m_zipPoint->m_lz_point_size == data.size());
 
-        ++m_current;
-    }
+    // Decode straight into the point's record.
+    m_zipPoint->SetData(data.data());
+    DecodeNext();
 
     return;
 }
 
-void ZipReaderImpl::ReadNextPoint()
+std::size_t ZipReaderImpl::DecodeRecords(liblas::PointBuffer& buffer, std::size_t n)
 {
+    if (m_decoder)
+    {
+        std::size_t const wanted = (std::min)(n, static_cast<std::size_t>(m_size - m_current));
+        std::size_t const got = m_decoder->Read(buffer, wanted);
+        m_current += static_cast<boost::uint32_t>(got);
+        return got;
+    }
+
     if (0 == m_current)
     {
         m_ifs.clear();
         m_ifs.seekg(m_zipReadStartPosition, std::ios::beg);
     }
 
-    if (m_current >= m_size ){
-        throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
-    } 
+    std::size_t const first = buffer.size();
+    std::size_t const wanted = (std::min)(n, static_cast<std::size_t>(m_size - m_current));
+
+    assert(m_zipPoint->m_lz_point_size == buffer.GetRecordLength());
+
+    buffer.resize(first + wanted);
+    for (std::size_t i = 0; i < wanted; ++i)
+    {
+        m_zipPoint->SetData(buffer.GetRecord(first + i));
+        DecodeNext();
+    }
+
+    return wanted;
+}
+
+bool ZipReaderImpl::DecodeBlock()
+{
+    m_block.SetHeader(m_header.get());
+    m_block.clear();
+    m_block_position = 0;
+
+    std::size_t const wanted = SkipChunks(filter_block_size);
+    boost::uint32_t const first = m_current;
+    std::size_t const got = DecodeRecords(m_block, wanted);
 
+    m_block_ids.resize(got);
+    for (std::size_t i = 0; i < got; ++i)
+        m_block_ids[i] = static_cast<boost::uint32_t>(first + i);
+
+    FilterPoints(m_filters, m_block, 0, &m_block_ids);
+    return got > 0;
+}
+
+void ZipReaderImpl::ReadNextPoint()
+{
     if (bNeedHeaderCheck) 
     {
         if (!(m_point->GetHeader() == m_header.get()))
             m_point->SetHeader(m_header.get());
     }
-    
-    ReadIdiom();
-
-    // Filter the points and continue reading until we either find 
-    // one to keep or throw an exception.
 
-    bool bLastPoint = false;
-    if (!FilterPoint(*m_point))
+    if (!m_filters.empty() || m_decoder)
     {
-        ReadIdiom();
+        // Filter a block of points at a time and hand the survivors out 
+        // one by one, decoding further blocks until we either find one 
+        // to keep or run out of points.  The chunk decoder hands out 
+        // blocks too, so we go this way without filters as well.
+        while (m_block_position >= m_block.size())
+        {
+            if (!DecodeBlock())
+                throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+        }
 
-        while (!FilterPoint(*m_point))
+        m_block.GetPoint(m_block_position, *m_point);
+        m_next_index = m_block_ids[m_block_position] + 1;
+        ++m_block_position;
+
+        if (!m_transforms.empty())
         {
-            ReadIdiom();
-            if (m_current == m_size) 
-            {
-                bLastPoint = true;
-                break;
-            }
+            TransformPoint(*m_point);
         }
+        return;
     }
 
-    if (!m_transforms.empty())
+    if (0 == m_current)
     {
-        TransformPoint(*m_point);
+        m_ifs.clear();
+        m_ifs.seekg(m_zipReadStartPosition, std::ios::beg);
     }
 
-    if (bLastPoint)
+    if (m_current >= m_size ){
         throw std::out_of_range("ReadNextPoint: file has no more points to read, end of file reached");
+    } 
 
+    ReadIdiom();
+    m_next_index = m_current;
 
+    if (!m_transforms.empty())
+    {
+        TransformPoint(*m_point);
+    }
 }
 
 
+std::size_t ZipReaderImpl::ReadNextPoints(liblas::PointBuffer& buffer, std::size_t n)
+{
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.reserve(n);
+
+    // Points already decoded and filtered come first.  Without filters 
+    // the rest is decoded straight into the buffer, with filters whole 
+    // blocks are filtered and their survivors handed out.
+    while (buffer.size() < n)
+    {
+        if (m_block_position < m_block.size())
+        {
+            DrainBlock(m_block, m_block_position, buffer, n - buffer.size());
+            m_next_index = m_block_ids[m_block_position - 1] + 1;
+        }
+        else if (m_filters.empty())
+        {
+            if (0 == DecodeRecords(buffer, n - buffer.size()))
+                break;
+            m_next_index = m_current;
+        }
+        else if (!DecodeBlock())
+        {
+            break;
+        }
+    }
+
+    TransformPoints(m_transforms, buffer, *m_point);
+
+    return buffer.size();
+}
+
 liblas::Point const& ZipReaderImpl::ReadPointAt(std::size_t n)
 {
     Seek(n);
@@ -279,6 +471,40 @@ liblas::Point const& ZipReaderImpl::ReadPointAt(std::size_t n)
 }
 
 
+void ZipReaderImpl::ReadPointsAt(std::vector<boost::uint32_t> const& ids, liblas::PointBuffer& buffer, std::size_t gap)
+{
+    PointRequest request;
+    std::vector<PointRun> runs;
+    PlanPointRuns(ids, gap, request, runs);
+
+    buffer.SetHeader(m_header.get());
+    buffer.clear();
+    buffer.resize(ids.size());
+
+    // The runs come in ascending order, and the unzipper decodes its way 
+    // forward when asked to seek further into the chunk it is in, so 
+    // every chunk we need is decompressed once.
+    liblas::PointBuffer records(m_header.get(), 0);
+    std::vector<PointRun>::const_iterator ri;
+    for (ri = runs.begin(); ri != runs.end(); ++ri)
+    {
+        if (ri->first != m_current)
+            Seek(ri->first);
+
+        records.clear();
+        if (DecodeRecords(records, ri->count) < ri->count)
+            throw std::out_of_range("ReadPointsAt: file has no more points to read, end of file reached");
+
+        ScatterPointRun(request, *ri, records, buffer);
+    }
+
+    m_block.clear();
+    m_block_position = 0;
+    m_next_index = m_current;
+
+    TransformPoints(m_transforms, buffer, *m_point);
+}
+
 void ZipReaderImpl::Seek(std::size_t n)
 {
     if (m_size == n) {
@@ -289,16 +515,34 @@ void ZipReaderImpl::Seek(std::size_t n)
         throw std::runtime_error(msg.str());
     } 
 
-    m_ifs.clear();
-
-    m_unzipper->seek(n);
+    if (m_decoder)
+    {
+        m_decoder->Start(n);
+    }
+    else
+    {
+        m_ifs.clear();
+        m_unzipper->seek(n);
+    }
 
     m_current = n;
+    m_next_index = n;
+
+    m_block.clear();
+    m_block_position = 0;
 }
 
 void ZipReaderImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
 {
     m_filters = filters;
+
+    // The points read ahead went through the old filters.  Go back to 
+    // the first record not handed out yet and filter again from there.
+    if (m_next_index < m_current)
+        Seek(m_next_index);
+
+    m_block.clear();
+    m_block_position = 0;
 }
 std::vector<liblas::FilterPtr>  ZipReaderImpl::GetFilters() const
 {
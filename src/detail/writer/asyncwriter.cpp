@@ -0,0 +1,335 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Write-behind LAS writer implementation for C++ libLAS
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/detail/writer/asyncwriter.hpp>
+#include <liblas/exception.hpp>
+// boost
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+// std
+#include <cassert>
+#include <cstring> // std::memcpy
+#include <stdexcept>
+
+namespace liblas { namespace detail { 
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+const std::size_t AsyncWriterImpl::default_queue_bytes;
+const std::size_t AsyncWriterImpl::default_block_size;
+
+AsyncWriterImpl::AsyncWriterImpl(WriterIPtr writer, std::size_t queue_bytes, std::size_t block_size)
+    : m_writer(writer)
+    , m_queue_bytes(queue_bytes)
+    , m_block_size(block_size)
+    , m_queued(0)
+    , m_busy(false)
+    , m_stop(false)
+    , m_blocks(0)
+    , m_stalls(0)
+    , m_stall_time(0, 0, 0, 0)
+{
+    if (!m_writer)
+        throw liblas_error("AsyncWriterImpl: writer to wrap is void");
+
+    if (0 == m_queue_bytes || 0 == m_block_size)
+        throw configuration_error("AsyncWriterImpl: queue size and block size must be at least 1");
+}
+
+AsyncWriterImpl::~AsyncWriterImpl()
+{
+    try
+    {
+        Submit();
+    } catch (std::exception const&)
+    {
+        // The worker failed earlier; there is nobody left to tell.
+    }
+
+    Stop();
+}
+
+void AsyncWriterImpl::Run()
+{
+    for (;;)
+    {
+        BufferPtr buffer;
+        bool failed = false;
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            while (m_ready.empty() && !m_stop)
+                m_cond.wait(lock);
+
+            // Only stop once everything queued is written.
+            if (m_ready.empty())
+                return;
+
+            buffer = m_ready.front();
+            m_ready.pop_front();
+            m_busy = true;
+            failed = !m_error.empty();
+        }
+
+        std::string error;
+        if (!failed)
+        {
+            try
+            {
+                m_writer->WritePoints(*buffer);
+            } catch (std::exception const& e)
+            {
+                error = e.what();
+                if (error.empty())
+                    error = "AsyncWriterImpl: error writing behind";
+            }
+        }
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_queued -= buffer->size() * buffer->GetRecordLength();
+        buffer->clear();
+        m_free.push_back(buffer);
+        m_busy = false;
+        if (!failed)
+            ++m_blocks;
+        if (!error.empty())
+            m_error = error;
+        m_cond.notify_all();
+    }
+}
+
+void AsyncWriterImpl::Stop()
+{
+    if (!m_thread)
+        return;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+
+    m_thread->join();
+    m_thread.reset();
+    m_stop = false;
+}
+
+AsyncWriterImpl::BufferPtr AsyncWriterImpl::Acquire()
+{
+    BufferPtr buffer;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (!m_free.empty())
+        {
+            buffer = m_free.front();
+            m_free.pop_front();
+        }
+    }
+
+    if (!buffer)
+        buffer = BufferPtr(new liblas::PointBuffer);
+
+    buffer->SetHeader(&m_writer->GetHeader());
+    buffer->clear();
+    return buffer;
+}
+
+void AsyncWriterImpl::Submit()
+{
+    if (!m_current || m_current->empty())
+        return;
+
+    BufferPtr buffer;
+    buffer.swap(m_current);
+    Enqueue(buffer);
+}
+
+void AsyncWriterImpl::Enqueue(BufferPtr buffer)
+{
+    std::size_t const bytes = buffer->size() * buffer->GetRecordLength();
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    if (!m_thread)
+        m_thread.reset(new boost::thread(&AsyncWriterImpl::Run, this));
+
+    // A block larger than the whole queue still goes through on its own.
+    if (m_queued > 0 && m_queued + bytes > m_queue_bytes && m_error.empty())
+    {
+        ++m_stalls;
+        ptime const start = microsec_clock::universal_time();
+        while (m_queued > 0 && m_queued + bytes > m_queue_bytes && m_error.empty())
+            m_cond.wait(lock);
+        m_stall_time += microsec_clock::universal_time() - start;
+    }
+
+    if (!m_error.empty())
+    {
+        buffer->clear();
+        m_free.push_back(buffer);
+        throw std::runtime_error(m_error);
+    }
+
+    m_ready.push_back(buffer);
+    m_queued += bytes;
+    m_cond.notify_all();
+}
+
+void AsyncWriterImpl::Fence()
+{
+    Submit();
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    while (!m_ready.empty() || m_busy)
+        m_cond.wait(lock);
+
+    if (!m_error.empty())
+        throw std::runtime_error(m_error);
+}
+
+liblas::Header& AsyncWriterImpl::GetHeader() const
+{
+    // The worker updates the point count of the header as it writes, 
+    // so it must be done with the queued blocks before we hand it out.
+    boost::mutex::scoped_lock lock(m_mutex);
+    while (!m_ready.empty() || m_busy)
+        m_cond.wait(lock);
+
+    return m_writer->GetHeader();
+}
+
+void AsyncWriterImpl::WriteHeader()
+{
+    Fence();
+    m_writer->WriteHeader();
+}
+
+void AsyncWriterImpl::SetHeader(liblas::Header const& header)
+{
+    Fence();
+    m_writer->SetHeader(header);
+}
+
+void AsyncWriterImpl::UpdatePointCount(boost::uint32_t count)
+{
+    Fence();
+    m_writer->UpdatePointCount(count);
+}
+
+void AsyncWriterImpl::WritePoint(liblas::Point const& point)
+{
+    if (!m_current)
+    {
+        m_current = Acquire();
+        m_current->reserve(m_block_size);
+    }
+
+    m_current->AddPoint(point);
+
+    if (m_current->size() >= m_block_size)
+        Submit();
+}
+
+void AsyncWriterImpl::WritePoints(liblas::PointBuffer const& buffer)
+{
+    if (buffer.empty())
+        return;
+
+    if (buffer.GetRecordLength() != m_writer->GetHeader().GetDataRecordLength())
+        throw std::invalid_argument("WritePoints: the records of the buffer do not match the header");
+
+    // Points written one at a time before go first.
+    Submit();
+
+    BufferPtr copy = Acquire();
+    copy->resize(buffer.size());
+    std::memcpy(copy->GetRecord(0), buffer.GetRecord(0), buffer.size() * buffer.GetRecordLength());
+    Enqueue(copy);
+}
+
+void AsyncWriterImpl::Flush()
+{
+    Fence();
+    m_writer->Flush();
+}
+
+void AsyncWriterImpl::SetFilters(std::vector<liblas::FilterPtr> const& filters)
+{
+    Fence();
+    m_writer->SetFilters(filters);
+}
+
+std::vector<liblas::FilterPtr> AsyncWriterImpl::GetFilters() const
+{
+    return m_writer->GetFilters();
+}
+
+void AsyncWriterImpl::SetTransforms(std::vector<liblas::TransformPtr> const& transforms)
+{
+    Fence();
+    m_writer->SetTransforms(transforms);
+}
+
+std::vector<liblas::TransformPtr> AsyncWriterImpl::GetTransforms() const
+{
+    return m_writer->GetTransforms();
+}
+
+boost::uint64_t AsyncWriterImpl::GetBlockCount() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_blocks;
+}
+
+boost::uint64_t AsyncWriterImpl::GetStallCount() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_stalls;
+}
+
+double AsyncWriterImpl::GetStallTime() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_stall_time.total_microseconds() / 1000000.0;
+}
+
+}} // namespace liblas::detail
@@ -0,0 +1,662 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Parallel LASzip chunk encoder
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#ifdef HAVE_LASZIP
+
+#include <liblas/liblas.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/private_utility.hpp>
+#include <liblas/detail/writer/chunkencoder.hpp>
+#include <liblas/detail/zippoint.hpp>
+// laszip
+#include <laszip/laszip.hpp>
+#include <laszip/laszipper.hpp>
+// boost
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace liblas { namespace detail { 
+
+namespace {
+
+// The chunk table is arithmetic coded with LASzip's IntegerCompressor.  
+// LASzip does not export its coder, so what follows is a transcription 
+// of the parts of it the chunk table uses.  It has to produce the very 
+// same bytes, so keep it in step with LASzip rather than tidying it up.
+
+boost::uint32_t const min_length = 0x01000000U;
+boost::uint32_t const max_length = 0xFFFFFFFFU;
+
+boost::uint32_t const bit_length_shift = 13;
+boost::uint32_t const bit_max_count = 1U << bit_length_shift;
+
+boost::uint32_t const symbol_length_shift = 15;
+boost::uint32_t const symbol_max_count = 1U << symbol_length_shift;
+
+class BitModel
+{
+public:
+
+    BitModel()
+        : bit_0_count(1)
+        , bit_count(2)
+        , bit_0_prob(1U << (bit_length_shift - 1))
+        , update_cycle(4)
+        , bits_until_update(4)
+    {}
+
+    void Update()
+    {
+        if ((bit_count += update_cycle) > bit_max_count)
+        {
+            bit_count = (bit_count + 1) >> 1;
+            bit_0_count = (bit_0_count + 1) >> 1;
+            if (bit_0_count == bit_count)
+                ++bit_count;
+        }
+
+        boost::uint32_t const scale = 0x80000000U / bit_count;
+        bit_0_prob = (bit_0_count * scale) >> (31 - bit_length_shift);
+
+        update_cycle = (5 * update_cycle) >> 2;
+        if (update_cycle > 64)
+            update_cycle = 64;
+        bits_until_update = update_cycle;
+    }
+
+    boost::uint32_t bit_0_count;
+    boost::uint32_t bit_count;
+    boost::uint32_t bit_0_prob;
+    boost::uint32_t update_cycle;
+    boost::uint32_t bits_until_update;
+};
+
+class SymbolModel
+{
+public:
+
+    explicit SymbolModel(boost::uint32_t symbols)
+        : symbols(symbols)
+        , last_symbol(symbols - 1)
+        , distribution(symbols)
+        , symbol_count(symbols, 1)
+        , total_count(0)
+        , update_cycle(symbols)
+        , symbols_until_update(0)
+    {
+        Update();
+        symbols_until_update = update_cycle = (symbols + 6) >> 1;
+    }
+
+    void Update()
+    {
+        if ((total_count += update_cycle) > symbol_max_count)
+        {
+            total_count = 0;
+            for (boost::uint32_t n = 0; n < symbols; ++n)
+                total_count += (symbol_count[n] = (symbol_count[n] + 1) >> 1);
+        }
+
+        boost::uint32_t sum = 0;
+        boost::uint32_t const scale = 0x80000000U / total_count;
+        for (boost::uint32_t k = 0; k < symbols; ++k)
+        {
+            distribution[k] = (scale * sum) >> (31 - symbol_length_shift);
+            sum += symbol_count[k];
+        }
+
+        update_cycle = (5 * update_cycle) >> 2;
+        boost::uint32_t const max_cycle = (symbols + 6) << 3;
+        if (update_cycle > max_cycle)
+            update_cycle = max_cycle;
+        symbols_until_update = update_cycle;
+    }
+
+    boost::uint32_t symbols;
+    boost::uint32_t last_symbol;
+    std::vector<boost::uint32_t> distribution;
+    std::vector<boost::uint32_t> symbol_count;
+    boost::uint32_t total_count;
+    boost::uint32_t update_cycle;
+    boost::uint32_t symbols_until_update;
+};
+
+class ArithmeticEncoder
+{
+public:
+
+    ArithmeticEncoder() : m_base(0), m_length(max_length) {}
+
+    void EncodeBit(BitModel& m, boost::uint32_t sym)
+    {
+        boost::uint32_t const x = m.bit_0_prob * (m_length >> bit_length_shift);
+        if (sym == 0)
+        {
+            m_length = x;
+            ++m.bit_0_count;
+        }
+        else
+        {
+            boost::uint32_t const init_base = m_base;
+            m_base += x;
+            m_length -= x;
+            if (init_base > m_base)
+                PropagateCarry();
+        }
+
+        if (m_length < min_length)
+            Renormalize();
+        if (--m.bits_until_update == 0)
+            m.Update();
+    }
+
+    void EncodeSymbol(SymbolModel& m, boost::uint32_t sym)
+    {
+        boost::uint32_t x;
+        boost::uint32_t const init_base = m_base;
+        if (sym == m.last_symbol)
+        {
+            x = m.distribution[sym] * (m_length >> symbol_length_shift);
+            m_base += x;
+            m_length -= x;
+        }
+        else
+        {
+            x = m.distribution[sym] * (m_length >>= symbol_length_shift);
+            m_base += x;
+            m_length = m.distribution[sym + 1] * m_length - x;
+        }
+
+        if (init_base > m_base)
+            PropagateCarry();
+        if (m_length < min_length)
+            Renormalize();
+
+        ++m.symbol_count[sym];
+        if (--m.symbols_until_update == 0)
+            m.Update();
+    }
+
+    void WriteBits(boost::uint32_t bits, boost::uint32_t sym)
+    {
+        if (bits > 19)
+        {
+            WriteShort(static_cast<boost::uint16_t>(sym & 0xFFFF));
+            sym = sym >> 16;
+            bits = bits - 16;
+        }
+
+        boost::uint32_t const init_base = m_base;
+        m_base += sym * (m_length >>= bits);
+        if (init_base > m_base)
+            PropagateCarry();
+        if (m_length < min_length)
+            Renormalize();
+    }
+
+    void WriteShort(boost::uint16_t sym)
+    {
+        boost::uint32_t const init_base = m_base;
+        m_base += sym * (m_length >>= 16);
+        if (init_base > m_base)
+            PropagateCarry();
+        if (m_length < min_length)
+            Renormalize();
+    }
+
+    void Done(std::ostream& ofs)
+    {
+        boost::uint32_t const init_base = m_base;
+        bool another_byte = true;
+
+        if (m_length > 2 * min_length)
+        {
+            m_base += min_length;
+            m_length = min_length >> 1;
+        }
+        else
+        {
+            m_base += min_length >> 1;
+            m_length = min_length >> 9;
+            another_byte = false;
+        }
+
+        if (init_base > m_base)
+            PropagateCarry();
+        Renormalize();
+
+        // The decoder reads ahead, so it expects a couple of zero bytes.
+        m_bytes.push_back(0);
+        m_bytes.push_back(0);
+        if (another_byte)
+            m_bytes.push_back(0);
+
+        ofs.write(reinterpret_cast<char const*>(&m_bytes[0]), 
+                  static_cast<std::streamsize>(m_bytes.size()));
+    }
+
+private:
+
+    // LASzip keeps the bytes in a ring buffer that is flushed as it 
+    // fills.  Keeping all of them gives the same output for the few 
+    // bytes a chunk table takes.
+    void PropagateCarry()
+    {
+        std::vector<boost::uint8_t>::reverse_iterator p = m_bytes.rbegin();
+        while (p != m_bytes.rend() && *p == 0xFFU)
+        {
+            *p = 0;
+            ++p;
+        }
+        if (p != m_bytes.rend())
+            ++*p;
+    }
+
+    void Renormalize()
+    {
+        do
+        {
+            m_bytes.push_back(static_cast<boost::uint8_t>(m_base >> 24));
+            m_base <<= 8;
+        } while ((m_length <<= 8) < min_length);
+    }
+
+    boost::uint32_t m_base;
+    boost::uint32_t m_length;
+    std::vector<boost::uint8_t> m_bytes;
+};
+
+// IntegerCompressor(enc, 32, 2) with its default of 8 high bits
+class IntegerCompressor
+{
+public:
+
+    explicit IntegerCompressor(ArithmeticEncoder& enc)
+        : m_enc(enc)
+    {
+        for (std::size_t i = 0; i < contexts; ++i)
+            m_bits.push_back(SymbolModel(corr_bits + 1));
+
+        for (boost::uint32_t i = 1; i <= corr_bits; ++i)
+        {
+            if (i <= bits_high)
+                m_corrector.push_back(SymbolModel(1U << i));
+            else
+                m_corrector.push_back(SymbolModel(1U << bits_high));
+        }
+    }
+
+    void Compress(boost::int32_t pred, boost::int32_t real, std::size_t context)
+    {
+        // With 32 bits there is no range to fold the difference into.
+        boost::int32_t const corr = static_cast<boost::int32_t>(
+            static_cast<boost::uint32_t>(real) - static_cast<boost::uint32_t>(pred));
+        WriteCorrector(corr, m_bits[context]);
+    }
+
+private:
+
+    static const boost::uint32_t corr_bits = 32;
+    static const boost::uint32_t bits_high = 8;
+    static const std::size_t contexts = 2;
+
+    void WriteCorrector(boost::int32_t c, SymbolModel& bits)
+    {
+        // find the tightest interval [ - (2^k - 1) ... + (2^k) ] that 
+        // contains c
+        boost::uint32_t k = 0;
+        boost::uint32_t c1 = (c <= 0 ? 0U - static_cast<boost::uint32_t>(c) 
+                                     : static_cast<boost::uint32_t>(c) - 1);
+        while (c1)
+        {
+            c1 = c1 >> 1;
+            k = k + 1;
+        }
+
+        m_enc.EncodeSymbol(bits, k);
+
+        if (0 == k)
+        {
+            m_enc.EncodeBit(m_corrector_0, static_cast<boost::uint32_t>(c));
+            return;
+        }
+
+        if (k >= 32)
+            return;
+
+        // translate c into [0 ... 2^k - 1]
+        boost::uint32_t u = static_cast<boost::uint32_t>(c);
+        if (c < 0)
+            u += (1U << k) - 1;
+        else
+            u -= 1;
+
+        if (k <= bits_high)
+        {
+            m_enc.EncodeSymbol(m_corrector[k - 1], u);
+        }
+        else
+        {
+            boost::uint32_t const k1 = k - bits_high;
+            boost::uint32_t const low = u & ((1U << k1) - 1);
+            m_enc.EncodeSymbol(m_corrector[k - 1], u >> k1);
+            m_enc.WriteBits(k1, low);
+        }
+    }
+
+    ArithmeticEncoder& m_enc;
+    std::vector<SymbolModel> m_bits;
+    BitModel m_corrector_0;
+    std::vector<SymbolModel> m_corrector;
+};
+
+} // namespace
+
+void WriteChunkTable(std::ostream& ofs, std::vector<boost::uint32_t> const& chunk_bytes)
+{
+    boost::uint32_t const version = 0;
+    boost::uint32_t const count = static_cast<boost::uint32_t>(chunk_bytes.size());
+    detail::write_n(ofs, version, sizeof(version));
+    detail::write_n(ofs, count, sizeof(count));
+
+    if (chunk_bytes.empty())
+        return;
+
+    ArithmeticEncoder enc;
+    IntegerCompressor ic(enc);
+    for (std::size_t i = 0; i < chunk_bytes.size(); ++i)
+    {
+        boost::uint32_t const pred = i ? chunk_bytes[i - 1] : 0;
+        ic.Compress(static_cast<boost::int32_t>(pred), static_cast<boost::int32_t>(chunk_bytes[i]), 1);
+    }
+    enc.Done(ofs);
+}
+
+ChunkEncoder::ChunkEncoder(std::ostream& ofs, liblas::Header const& header, 
+                           std::size_t threads, std::size_t window)
+    : m_ofs(ofs)
+    , m_header(header)
+    , m_threads(threads)
+    , m_window(window ? window : 2 * threads)
+    , m_chunk_size(0)
+    , m_start(0)
+    , m_submitted(0)
+    , m_written(0)
+    , m_stop(false)
+    , m_closed(false)
+{
+    if (0 == m_threads)
+        throw configuration_error("ChunkEncoder: thread count must be at least 1");
+
+    for (std::size_t i = 0; i < m_threads; ++i)
+        m_points.push_back(ZipPointPtr(new ZipPoint(header.GetDataFormatId(), header.GetVLRs())));
+
+    LASzip const* zip = m_points.front()->GetZipper();
+    if (zip->compressor != LASZIP_COMPRESSOR_POINTWISE_CHUNKED || 0 == zip->chunk_size)
+        throw configuration_error("ChunkEncoder: LASzip stream is not chunked");
+    m_chunk_size = zip->chunk_size;
+
+    // Room for the offset of the chunk table, which Close fills in.
+    m_start = static_cast<std::streamoff>(m_ofs.tellp());
+    boost::int64_t const unknown = -1;
+    detail::write_n(m_ofs, unknown, sizeof(unknown));
+
+    for (std::size_t i = 0; i < m_threads; ++i)
+        m_pool.push_back(ThreadPtr(new boost::thread(boost::bind(&ChunkEncoder::Run, this, i))));
+}
+
+ChunkEncoder::~ChunkEncoder()
+{
+    Stop();
+}
+
+void ChunkEncoder::Compress(ZipPoint& point, liblas::PointBuffer const& points, std::string& chunk)
+{
+    // A chunk compressed on its own comes out the same as in the middle 
+    // of a stream, framed by the offset of a chunk table and the table.
+    std::ostringstream oss(std::ios::out | std::ios::binary);
+    LASzipper zipper;
+    if (!zipper.open(oss, point.GetZipper()))
+    {
+        std::ostringstream msg;
+        msg << "Error opening LASzipper: " << std::string(point.GetZipper()->get_error());
+        throw liblas_error(msg.str());
+    }
+
+    assert(point.m_lz_point_size == points.GetRecordLength());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        // LASzipper only reads through the item pointers.
+        point.SetData(const_cast<boost::uint8_t*>(points.GetRecord(i)));
+        if (!zipper.write(point.m_lz_point))
+        {
+            std::ostringstream msg;
+            msg << "Error writing compressed point data: " << std::string(zipper.get_error());
+            throw liblas_error(msg.str());
+        }
+    }
+    zipper.close();
+
+    std::string const framed = oss.str();
+    boost::int64_t table = 0;
+    if (framed.size() >= sizeof(table))
+        std::memcpy(&table, framed.data(), sizeof(table));
+    LIBLAS_SWAP_BYTES(table);
+
+    if (table < static_cast<boost::int64_t>(sizeof(table)) || table > static_cast<boost::int64_t>(framed.size()))
+        throw liblas_error("ChunkEncoder: LASzipper did not write a chunk table");
+
+    chunk.assign(framed, sizeof(table), static_cast<std::size_t>(table) - sizeof(table));
+}
+
+void ChunkEncoder::Run(std::size_t w)
+{
+    ZipPoint& point = *m_points[w];
+
+    for (;;)
+    {
+        Job job;
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            while (!m_stop && m_jobs.empty())
+                m_cond.wait(lock);
+
+            if (m_stop)
+                return;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        std::string chunk;
+        std::string error;
+        try
+        {
+            Compress(point, *job.second, chunk);
+        } catch (std::exception const& e)
+        {
+            error = e.what();
+            if (error.empty())
+                error = "ChunkEncoder: error compressing chunk";
+        }
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (error.empty())
+        {
+            m_compressed[job.first].swap(chunk);
+        } 
+        else if (m_error.empty())
+        {
+            m_error = error;
+        }
+        m_cond.notify_all();
+    }
+}
+
+bool ChunkEncoder::WriteReady(boost::mutex::scoped_lock& lock)
+{
+    if (!m_error.empty())
+        throw liblas_error(m_error);
+
+    std::map<std::size_t, std::string>::iterator i = m_compressed.find(m_written);
+    if (i == m_compressed.end())
+        return false;
+
+    std::string chunk;
+    chunk.swap(i->second);
+    m_compressed.erase(i);
+
+    // Workers carry on while we write.
+    lock.unlock();
+    m_ofs.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    lock.lock();
+
+    m_chunk_bytes.push_back(static_cast<boost::uint32_t>(chunk.size()));
+    ++m_written;
+    return true;
+}
+
+void ChunkEncoder::Submit()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    m_jobs.push_back(Job(m_submitted, m_current));
+    ++m_submitted;
+    m_current.reset();
+    m_cond.notify_all();
+
+    // Back-pressure: write what is done, and wait while the window 
+    // is full.
+    for (;;)
+    {
+        if (WriteReady(lock))
+            continue;
+        if (m_submitted - m_written < m_window)
+            break;
+        m_cond.wait(lock);
+    }
+}
+
+void ChunkEncoder::Write(liblas::PointData const& data)
+{
+    assert(data.size() >= m_header.GetDataRecordLength());
+    Write(data.data(), 1);
+}
+
+void ChunkEncoder::Write(boost::uint8_t const* data, std::size_t count)
+{
+    if (m_closed)
+        throw liblas_error("ChunkEncoder: writing to a closed encoder");
+
+    while (count > 0)
+    {
+        if (!m_current)
+            m_current = BufferPtr(new liblas::PointBuffer(&m_header, m_chunk_size));
+
+        std::size_t const n = m_current->size();
+        std::size_t const length = m_current->GetRecordLength();
+        std::size_t const take = (std::min)(count, m_chunk_size - n);
+        m_current->resize(n + take);
+        std::memcpy(m_current->GetRecord(n), data, take * length);
+        data += take * length;
+        count -= take;
+
+        if (m_current->size() == m_chunk_size)
+            Submit();
+    }
+}
+
+void ChunkEncoder::Close()
+{
+    if (m_closed)
+        return;
+    m_closed = true;
+
+    if (m_current && !m_current->empty())
+        Submit();
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        while (m_written < m_submitted)
+        {
+            if (!WriteReady(lock))
+                m_cond.wait(lock);
+        }
+    }
+    Stop();
+
+    boost::int64_t const table = static_cast<boost::int64_t>(m_ofs.tellp());
+    WriteChunkTable(m_ofs, m_chunk_bytes);
+    std::streamoff const end = static_cast<std::streamoff>(m_ofs.tellp());
+
+    m_ofs.seekp(m_start, std::ios::beg);
+    detail::write_n(m_ofs, table, sizeof(table));
+    m_ofs.seekp(end, std::ios::beg);
+}
+
+void ChunkEncoder::Stop()
+{
+    if (m_pool.empty())
+        return;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+
+    for (std::size_t i = 0; i < m_pool.size(); ++i)
+        m_pool[i]->join();
+    m_pool.clear();
+}
+
+}} // namespace liblas::detail
+
+#endif // HAVE_LASZIP
@@ -39,10 +39,12 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
+#include <liblas/exception.hpp>
 #include <liblas/header.hpp>
 #include <liblas/point.hpp>
 #include <liblas/spatialreference.hpp>
 #include <liblas/detail/writer/header.hpp>
+#include <liblas/detail/chunksummary.hpp>
 #include <liblas/detail/private_utility.hpp>
 #include <liblas/detail/zippoint.hpp>
 // boost
@@ -68,7 +70,10 @@ Header::Header(std::ostream& ofs, boost::uint32_t& count, liblas::Header const&
     : m_ofs(ofs)
     , m_header(header)
     , m_pointCount(count)
+    , m_chunk_summary_size(0)
+    , m_append(false)
 {
+    m_returns.assign(0);
 }
 
 void Header::write()
@@ -122,6 +127,10 @@ void Header::write()
             m_pointCount = m_header.GetPointRecordsCount();
         }
 
+        // The existing points were not summarized by us.
+        m_chunk_summary_size = 0;
+        m_append = m_pointCount > 0;
+
         // Position to the beginning of the file to start writing the header
         m_ofs.seekp(0, ios::beg);
 
@@ -154,6 +163,17 @@ void Header::write()
             VariableRecord v;
             zpd.ConstructVLR(v);
             m_header.AddVLR(v);
+
+            // Summaries copied from another file do not describe our 
+            // chunks.  Ours are only known once all points are in, so 
+            // the VLR written now only says how big the chunks are.
+            m_header.DeleteVLRs("liblas", chunk_summary_record_id);
+            if (m_chunk_summary_size > 0)
+            {
+                ChunkSummaryLocation location;
+                location.chunk_size = m_chunk_summary_size;
+                m_header.AddVLR(MakeChunkSummaryVLR(location));
+            }
 #else
             throw configuration_error("LASzip compression support not enabled in this libLAS configuration.");
 #endif
@@ -161,6 +181,7 @@ void Header::write()
         else
         {
             m_header.DeleteVLRs("laszip encoded", 22204);
+            m_header.DeleteVLRs("liblas", chunk_summary_record_id);
         }
         
         int32_t existing_padding = m_header.GetDataOffset() - 
@@ -341,6 +362,141 @@ void Header::write()
     
 }
 
+void Header::append()
+{
+    ios::off_type const length = m_header.GetDataRecordLength();
+    ios::off_type const count = m_header.GetPointRecordsCount();
+    ios::off_type const end_of_points = m_header.GetDataOffset() + count * length;
+
+    // Anything past the points the header counts was left by an 
+    // append that did not finish, and is written over.
+    m_ofs.seekp(0, ios::end);
+    ios::off_type const end = static_cast<ios::off_type>(m_ofs.tellp());
+    if (end < end_of_points)
+    {
+        std::ostringstream oss;
+        oss << "The header says the file holds " << count << " points, "
+            << "which end at " << end_of_points << ", past the end of the file at " 
+            << end << ".  Points cannot be appended to it.";
+        throw liblas::invalid_format(oss.str());
+    }
+
+    m_pointCount = static_cast<uint32_t>(count);
+    m_chunk_summary_size = 0;
+    m_append = m_pointCount > 0;
+
+    m_ofs.seekp(end_of_points, ios::beg);
+}
+
+void Header::AddPoints(boost::uint8_t const* data, std::size_t count, std::size_t length)
+{
+    SummarizePoints(data, count, length, m_bounds, m_returns);
+}
+
+void Header::SummarizePoints(boost::uint8_t const* data, std::size_t count, std::size_t length, 
+                             ChunkSummary& bounds, boost::array<boost::uint32_t, 5>& returns)
+{
+    for (std::size_t i = 0; i < count; ++i, data += length)
+    {
+        bounds.Add(data, false);
+
+        // The return number is in the low three bits of the flags
+        unsigned int const r = data[14] & 0x07;
+        if (r >= 1 && r <= returns.size())
+            ++returns[r - 1];
+    }
+}
+
+void Header::AddSummary(ChunkSummary const& bounds, boost::array<boost::uint32_t, 5> const& returns)
+{
+    m_bounds.Merge(bounds);
+    for (std::size_t i = 0; i < m_returns.size(); ++i)
+        m_returns[i] += returns[i];
+}
+
+void Header::WriteSummary(liblas::Header& header, boost::uint32_t count)
+{
+    uint32_t pbr[5] = { 0 };
+    std::copy(m_returns.begin(), m_returns.end(), pbr);
+
+    if (m_append)
+    {
+        std::vector<uint32_t> const& old = m_header.GetPointRecordsByReturnCount();
+        for (std::size_t i = 0; i < 5 && i < old.size(); ++i)
+            pbr[i] += old[i];
+    }
+
+    double mins[3];
+    double maxs[3];
+    bool const has_bounds = !m_bounds.empty();
+    if (has_bounds)
+    {
+        double const scales[3] = { header.GetScaleX(), header.GetScaleY(), header.GetScaleZ() };
+        double const offsets[3] = { header.GetOffsetX(), header.GetOffsetY(), header.GetOffsetZ() };
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            mins[i] = m_bounds.min[i] * scales[i] + offsets[i];
+            maxs[i] = m_bounds.max[i] * scales[i] + offsets[i];
+        }
+
+        if (m_append)
+        {
+            double const old_mins[3] = { m_header.GetMinX(), m_header.GetMinY(), m_header.GetMinZ() };
+            double const old_maxs[3] = { m_header.GetMaxX(), m_header.GetMaxY(), m_header.GetMaxZ() };
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                mins[i] = (std::min)(mins[i], old_mins[i]);
+                maxs[i] = (std::max)(maxs[i], old_maxs[i]);
+            }
+        }
+
+        header.SetMin(mins[0], mins[1], mins[2]);
+        header.SetMax(maxs[0], maxs[1], maxs[2]);
+    }
+
+    header.SetPointRecordsCount(count);
+    for (uint32_t i = 0; i < 5; ++i)
+        header.SetPointRecordsByReturnCount(i, pbr[i]);
+
+    if (!m_ofs.good())
+        return;
+
+    std::streamoff const orig_pos = m_ofs.tellp();
+
+    // The points have to be in the file before the header counts them.
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
+
+    // 26-31. Max/Min X, Y, Z follow the scale factors and offsets.  
+    // Widening them first keeps the old points inside the bounds.
+    std::streamsize const count_pos = 107;
+    std::streamsize const bounds_pos = count_pos + 6 * sizeof(uint32_t) + 6 * sizeof(double);
+    if (has_bounds)
+    {
+        m_ofs.seekp(bounds_pos, ios::beg);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            detail::write_n(m_ofs, maxs[i], sizeof(double));
+            detail::write_n(m_ofs, mins[i], sizeof(double));
+        }
+        m_ofs.flush();
+        detail::check_stream_state(m_ofs);
+    }
+
+    // 18-19. Number of point records and number of points by return, 
+    // in a single write so the header never counts more returns than 
+    // points.
+    uint32_t counts[6] = { count, pbr[0], pbr[1], pbr[2], pbr[3], pbr[4] };
+    for (std::size_t i = 0; i < 6; ++i)
+        LIBLAS_SWAP_BYTES(counts[i]);
+    m_ofs.seekp(count_pos, ios::beg);
+    m_ofs.write(detail::as_bytes(counts), sizeof(counts));
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
+
+    m_ofs.seekp(orig_pos, ios::beg);
+}
+
 void Header::WriteVLRs() 
 {
 
@@ -50,6 +50,7 @@
 // std
 #include <cmath>
 #include <sstream> 
+#include <stdexcept>
 
 using namespace boost;
 
@@ -89,7 +90,7 @@ void Point::setup()
 void Point::write(const liblas::Point& point)
 {
     
-    std::vector<boost::uint8_t> const& data = point.GetData();    
+    PointData const& data = point.GetData();
     detail::write_n(m_ofs, data.front(), m_header->GetDataRecordLength());
     
     m_pointCount++;
@@ -121,5 +122,19 @@ void Point::write(const liblas::Point& point)
     // }
 }
 
+void Point::write(liblas::PointBuffer const& buffer)
+{
+    if (buffer.empty())
+        return;
+
+    if (buffer.GetRecordLength() != m_header->GetDataRecordLength())
+        throw std::invalid_argument("WritePoints: the records of the buffer do not match the header");
+
+    std::streamsize const size = static_cast<std::streamsize>(buffer.size() * buffer.GetRecordLength());
+    detail::write_n(m_ofs, *buffer.GetRecord(0), size);
+
+    m_pointCount += static_cast<boost::uint32_t>(buffer.size());
+}
+
 
 }}} // namespace liblas::detail::reader
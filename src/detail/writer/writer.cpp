@@ -59,6 +59,17 @@ WriterImpl::WriterImpl(std::ostream& ofs) :
     , m_header_writer(HeaderWriterPtr())
     , m_header(HeaderPtr())
     , m_pointCount(0)
+    , m_appending(false)
+{
+}
+
+WriterImpl::WriterImpl(std::ostream& ofs, liblas::Header const& existing) :
+    m_ofs(ofs)
+    , m_point_writer(PointWriterPtr( ))
+    , m_header_writer(HeaderWriterPtr())
+    , m_header(HeaderPtr(new liblas::Header(existing)))
+    , m_pointCount(0)
+    , m_appending(true)
 {
 }
 
@@ -66,6 +77,12 @@ WriterImpl::WriterImpl(std::ostream& ofs) :
 void WriterImpl::WriteHeader()
 {
     m_header_writer = HeaderWriterPtr(new writer::Header(m_ofs, m_pointCount, *m_header) );
+
+    if (m_appending)
+    {
+        m_header_writer->append();
+        return;
+    }
     
     m_header_writer->write();
     
@@ -93,7 +110,25 @@ void WriterImpl::WritePoint(liblas::Point const& point)
         m_point_writer = PointWriterPtr(new writer::Point(m_ofs, m_pointCount, m_header));
     } 
     m_point_writer->write(point);
+    if (m_header_writer)
+        m_header_writer->AddPoints(&point.GetData().front(), 1, m_header->GetDataRecordLength());
+
+}
 
+void WriterImpl::WritePoints(liblas::PointBuffer const& buffer)
+{
+    if (m_point_writer.get() == 0) {
+        m_point_writer = PointWriterPtr(new writer::Point(m_ofs, m_pointCount, m_header));
+    } 
+    m_point_writer->write(buffer);
+    if (m_header_writer && !buffer.empty())
+        m_header_writer->AddPoints(buffer.GetRecord(0), buffer.size(), buffer.GetRecordLength());
+}
+
+void WriterImpl::Flush()
+{
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
 }
 
 WriterImpl::~WriterImpl()
@@ -102,7 +137,17 @@ WriterImpl::~WriterImpl()
     // care if we weren't able to write it.
     try
     {
-        UpdatePointCount(0);
+        // A file we were to append to is not touched unless we got 
+        // as far as finding its end.
+        if (m_appending && !m_header_writer)
+            return;
+
+        // The count goes last, so the header of a file being appended 
+        // to only takes in the new points once everything else is in.
+        if (m_header_writer)
+            m_header_writer->WriteSummary(*m_header, m_pointCount);
+        else
+            UpdatePointCount(0);
         
     } catch (std::runtime_error const&)
     {
@@ -135,6 +180,30 @@ liblas::Header& WriterImpl::GetHeader() const
 }
 void WriterImpl::SetHeader(liblas::Header const& header)
 {
+    if (m_appending)
+    {
+        // The file keeps its own header, the new points only have 
+        // to be stored the same way as those already in it.
+        liblas::Header const& existing = *m_header;
+        if (header.GetDataFormatId() != existing.GetDataFormatId() || 
+            header.GetDataRecordLength() != existing.GetDataRecordLength() ||
+            !(header.GetSchema() == existing.GetSchema()))
+        {
+            throw invalid_format("Cannot append points whose format or schema differ from those of the file");
+        }
+
+        if (header.GetScaleX() != existing.GetScaleX() || 
+            header.GetScaleY() != existing.GetScaleY() || 
+            header.GetScaleZ() != existing.GetScaleZ() ||
+            header.GetOffsetX() != existing.GetOffsetX() || 
+            header.GetOffsetY() != existing.GetOffsetY() || 
+            header.GetOffsetZ() != existing.GetOffsetZ())
+        {
+            throw invalid_format("Cannot append points whose scale or offset differ from those of the file");
+        }
+        return;
+    }
+
     m_header = HeaderPtr(new liblas::Header(header));
 }
 
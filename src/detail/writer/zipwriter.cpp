@@ -43,6 +43,8 @@
 
 #include <liblas/liblas.hpp>
 #include <liblas/detail/writer/zipwriter.hpp>
+#include <liblas/detail/writer/chunkencoder.hpp>
+#include <liblas/detail/chunksummary.hpp>
 #include <liblas/detail/writer/header.hpp>
 #include <liblas/detail/writer/point.hpp>
 #include <liblas/detail/private_utility.hpp>
@@ -59,13 +61,17 @@
 
 namespace liblas { namespace detail { 
 
-ZipWriterImpl::ZipWriterImpl(std::ostream& ofs) :
+ZipWriterImpl::ZipWriterImpl(std::ostream& ofs, std::size_t threads, bool summarize) :
     m_ofs(ofs), 
     //m_point_writer(PointWriterPtr( )), 
     m_header_writer(HeaderWriterPtr()), 
     m_pointCount(0),
+    m_threads(threads),
+    m_summarize(summarize),
+    m_summary_position(0),
     m_zipper(NULL),
-    m_zipPoint(NULL)
+    m_zipPoint(NULL),
+    m_encoder(NULL)
 {
     return;
 }
@@ -73,13 +79,43 @@ ZipWriterImpl::ZipWriterImpl(std::ostream& ofs) :
 
 void ZipWriterImpl::WriteHeader()
 {
+    // Streams that are not chunked have to be compressed in one go.
+    LASzip const* zip = m_zipPoint->GetZipper();
+    bool const chunked = zip->compressor == LASZIP_COMPRESSOR_POINTWISE_CHUNKED && zip->chunk_size > 0;
+
+    m_summaries.clear();
+    m_summary_position = 0;
+
     m_header_writer = HeaderWriterPtr(new writer::Header(m_ofs, m_pointCount, *m_header) );
+    if (m_summarize && chunked)
+        m_header_writer->SetChunkSummarySize(zip->chunk_size);
     
     m_header_writer->write();
     
     m_header = HeaderPtr(new liblas::Header(m_header_writer->GetHeader()));
 
-    if (!m_zipper)
+    if (m_header_writer->GetChunkSummarySize() > 0)
+    {
+        std::streamoff position = m_header->GetHeaderSize();
+        std::vector<VariableRecord> const& vlrs = m_header->GetVLRs();
+        for (std::vector<VariableRecord>::const_iterator i = vlrs.begin(); i != vlrs.end(); ++i)
+        {
+            if (IsChunkSummaryVLR(*i))
+            {
+                m_summary_position = position + i->GetTotalSize() - i->GetRecordLength();
+                break;
+            }
+            position += i->GetTotalSize();
+        }
+    }
+
+    if (m_threads > 1 && chunked && !m_zipper && !m_encoder)
+    {
+        boost::scoped_ptr<ChunkEncoder> e(new ChunkEncoder(m_ofs, *m_header, m_threads));
+        m_encoder.swap(e);
+    }
+
+    if (!m_zipper && !m_encoder)
     {
         boost::scoped_ptr<LASzipper> z(new LASzipper());
         m_zipper.swap(z);
@@ -97,6 +133,24 @@ void ZipWriterImpl::WriteHeader()
     
 }
 
+void ZipWriterImpl::WriteSummaries()
+{
+    m_ofs.seekp(0, std::ios::end);
+
+    ChunkSummaryLocation location;
+    location.chunk_size = m_zipPoint->GetZipper()->chunk_size;
+    location.count = static_cast<boost::uint32_t>(m_summaries.size());
+    location.offset = static_cast<boost::uint64_t>(m_ofs.tellp());
+
+    WriteChunkSummaries(m_ofs, m_summaries);
+    std::streamoff const end = m_ofs.tellp();
+
+    m_ofs.seekp(m_summary_position + chunk_summary_count_position, std::ios::beg);
+    detail::write_n(m_ofs, location.count, sizeof(location.count));
+    detail::write_n(m_ofs, location.offset, sizeof(location.offset));
+    m_ofs.seekp(end, std::ios::beg);
+}
+
 void ZipWriterImpl::UpdatePointCount(boost::uint32_t count)
 {
     std::streamoff orig_pos = m_ofs.tellp();
@@ -119,15 +173,28 @@ void ZipWriterImpl::WritePoint(liblas::Point const& point)
 {
 
     bool ok = false;
-    const std::vector<boost::uint8_t>* data = &point.GetData();
-    assert(data->size() == m_zipPoint->m_lz_point_size);
+    const PointData* data = &point.GetData();
+
+    if (data->size() < m_zipPoint->m_lz_point_size)
+        throw std::invalid_argument("WritePoint: the point is shorter than the records of the header");
 
-    for (unsigned int i=0; i<m_zipPoint->m_lz_point_size; i++)
+    if (m_summary_position)
+        Summarize(data->data(), m_pointCount);
+    if (m_header_writer)
+        m_header_writer->AddPoints(data->data(), 1, m_zipPoint->m_lz_point_size);
+
+    if (m_encoder)
     {
-        m_zipPoint->m_lz_point_data[i] = data->at(i);
-        //printf("%d %d\n", v[i], i);
+        m_encoder->Write(data->data(), 1);
+        ++m_pointCount;
+        m_header->SetPointRecordsCount(m_pointCount);
+        return;
     }
 
+    // LASzipper only reads through the item pointers, so it can read 
+    // the point's own record.
+    m_zipPoint->SetData(const_cast<boost::uint8_t*>(data->data()));
+
     ok = m_zipper->write(m_zipPoint->m_lz_point);
 
     if (!ok)
@@ -140,6 +207,65 @@ void ZipWriterImpl::WritePoint(liblas::Point const& point)
     m_header->SetPointRecordsCount(m_pointCount);
 }
 
+void ZipWriterImpl::WritePoints(liblas::PointBuffer const& buffer)
+{
+    if (buffer.empty())
+        return;
+
+    if (buffer.GetRecordLength() != m_zipPoint->m_lz_point_size)
+        throw std::invalid_argument("WritePoints: the records of the buffer do not match the header");
+
+    std::size_t const n = buffer.size();
+    std::size_t const length = buffer.GetRecordLength();
+    boost::uint8_t const* records = buffer.GetRecord(0);
+
+    if (m_summary_position)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            Summarize(records + i * length, m_pointCount + i);
+    }
+    if (m_header_writer)
+        m_header_writer->AddPoints(records, n, length);
+
+    if (m_encoder)
+    {
+        m_encoder->Write(records, n);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            m_zipPoint->SetData(const_cast<boost::uint8_t*>(records + i * length));
+            if (!m_zipper->write(m_zipPoint->m_lz_point))
+            {
+                std::ostringstream oss;
+                oss << "Error writing compressed point data: " << std::string(m_zipper->get_error());
+                throw liblas_error(oss.str());
+            }
+        }
+    }
+
+    m_pointCount += static_cast<boost::uint32_t>(n);
+    m_header->SetPointRecordsCount(m_pointCount);
+}
+
+void ZipWriterImpl::Flush()
+{
+    // Points of the chunk being compressed stay with the compressor 
+    // until it is full.
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
+}
+
+void ZipWriterImpl::Summarize(boost::uint8_t const* data, std::size_t index)
+{
+    std::size_t const chunk_size = m_zipPoint->GetZipper()->chunk_size;
+    if (index % chunk_size == 0)
+        m_summaries.push_back(ChunkSummary());
+    PointFormatName const f = m_header->GetDataFormatId();
+    m_summaries.back().Add(data, f == ePointFormat1 || f == ePointFormat3);
+}
+
 ZipWriterImpl::~ZipWriterImpl()
 {
     // Try to update the point count on our way out, but we don't really
@@ -147,13 +273,35 @@ ZipWriterImpl::~ZipWriterImpl()
 
     try
     {
-        UpdatePointCount(0);
+        if (m_encoder)
+            m_encoder->Close();
+
+        if (m_summary_position)
+        {
+            // The summaries go after the chunk table, which LASzipper 
+            // only writes when it is closed.
+            if (m_zipper)
+                m_zipper->close();
+            WriteSummaries();
+        }
+    } catch (std::exception const&)
+    {
+        // ignore?
+    }
+
+    try
+    {
+        if (m_header_writer)
+            m_header_writer->WriteSummary(*m_header, m_pointCount);
+        else
+            UpdatePointCount(0);
     } catch (std::runtime_error const&)
     {
         // ignore?
     }
 
 
+    m_encoder.reset();
     m_zipper.reset();
     m_zipPoint.reset();
 
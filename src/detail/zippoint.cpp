@@ -166,6 +166,19 @@ void ZipPoint::ConstructItems()
     return;
 }
 
+void ZipPoint::SetData(boost::uint8_t* data)
+{
+    if (NULL == data)
+        data = m_lz_point_data.get();
+
+    unsigned int point_offset = 0;
+    for (unsigned i = 0; i < m_zip->num_items; i++)
+    {
+        m_lz_point[i] = data + point_offset;
+        point_offset += m_zip->items[i].size;
+    }
+}
+
 
 void ZipPoint::ConstructVLR(VariableRecord& v) const
 {
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Typed access to point record dimensions
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/dimensionaccessor.hpp>
+#include <liblas/exception.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <sstream>
+
+namespace liblas { namespace detail {
+
+DimensionLayout::DimensionLayout(Dimension const& dim)
+    : kind(eUInt8)
+    , byte_offset(dim.GetByteOffset())
+    , byte_size(0)
+    , shift(0)
+    , mask(0xFF)
+{
+    std::size_t const bits = dim.GetBitSize();
+    std::size_t const bit_offset = dim.GetBitOffset();
+
+    if (bits % 8 != 0 || bit_offset != 0)
+    {
+        if (bit_offset + bits > 8)
+        {
+            std::ostringstream msg;
+            msg << "Dimension '" << dim.GetName() << "' of " << bits 
+                << " bits at bit offset " << bit_offset 
+                << " spans a byte boundary and cannot be accessed";
+            throw liblas_error(msg.str());
+        }
+
+        kind = eBits;
+        byte_size = 1;
+        shift = static_cast<unsigned int>(bit_offset);
+        mask = static_cast<boost::uint8_t>((1u << bits) - 1);
+        return;
+    }
+
+    byte_size = bits / 8;
+    if (byte_size > 8)
+    {
+        std::ostringstream msg;
+        msg << "Dimension '" << dim.GetName() << "' of " << bits 
+            << " bits is too wide to be accessed as a number";
+        throw liblas_error(msg.str());
+    }
+
+    bool const is_float = dim.IsNumeric() && !dim.IsInteger();
+    bool const is_signed = dim.IsSigned();
+
+    switch (byte_size)
+    {
+        case 1:
+            kind = is_signed ? eInt8 : eUInt8;
+            break;
+        case 2:
+            kind = is_signed ? eInt16 : eUInt16;
+            break;
+        case 4:
+            kind = is_float ? eFloat : is_signed ? eInt32 : eUInt32;
+            break;
+        case 8:
+            kind = is_float ? eDouble : is_signed ? eInt64 : eUInt64;
+            break;
+        default:
+            kind = is_signed ? eSigned : eUnsigned;
+            break;
+    }
+}
+
+boost::uint64_t load_unsigned(boost::uint8_t const* data, std::size_t size)
+{
+    boost::uint64_t value = 0;
+    for (std::size_t i = size; i > 0; --i)
+        value = (value << 8) | data[i - 1];
+    return value;
+}
+
+boost::int64_t load_signed(boost::uint8_t const* data, std::size_t size)
+{
+    boost::uint64_t value = load_unsigned(data, size);
+
+    // sign extend from the top bit of the stored bytes
+    std::size_t const bits = size * 8;
+    if (bits < 64 && (value >> (bits - 1)) & 1)
+        value |= ~boost::uint64_t(0) << bits;
+
+    return static_cast<boost::int64_t>(value);
+}
+
+void store_integer(boost::uint8_t* data, std::size_t size, boost::uint64_t value)
+{
+    for (std::size_t i = 0; i < size; ++i, value >>= 8)
+        data[i] = static_cast<boost::uint8_t>(value & 0xFF);
+}
+
+}} // namespace liblas::detail
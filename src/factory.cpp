@@ -44,6 +44,9 @@
 #include <liblas/detail/reader/reader.hpp>
 #include <liblas/detail/reader/zipreader.hpp>
 #include <liblas/detail/reader/cachedreader.hpp>
+#include <liblas/detail/reader/mappedreader.hpp>
+#include <liblas/detail/reader/prefetchreader.hpp>
+#include <liblas/detail/writer/asyncwriter.hpp>
 #include <liblas/detail/writer/writer.hpp>
 #include <liblas/detail/writer/zipwriter.hpp>
 #include <liblas/utility.hpp>
@@ -71,7 +74,10 @@ Reader ReaderFactory::CreateWithImpl(ReaderIPtr r)
     return reader;
 }
 
-Reader ReaderFactory::CreateCached(std::istream& stream, boost::uint32_t cache_size)
+namespace {
+
+// makes a ReaderImpl or a ZipReaderImpl, depending on header type
+ReaderIPtr CreateImplWithStream(std::istream& stream, std::size_t decode_threads = 1)
 {
     detail::HeaderReaderPtr h(new detail::reader::Header(stream));
     h->ReadHeader();
@@ -79,30 +85,69 @@ Reader ReaderFactory::CreateCached(std::istream& stream, boost::uint32_t cache_s
 
     if (header->Compressed())
     {
-        throw configuration_error("Compressed files are not readable with cached reader");
+#ifdef HAVE_LASZIP
+        return ReaderIPtr(new detail::ZipReaderImpl(stream, decode_threads) );
+#else
+        boost::ignore_unused_variable_warning(decode_threads);
+        throw configuration_error("Compression support not enabled in liblas configuration");
+#endif
     }
 
-    ReaderIPtr r = ReaderIPtr(new detail::CachedReaderImpl(stream, cache_size) );
-    return liblas::Reader(r);
+    return ReaderIPtr(new detail::ReaderImpl(stream) );
 }
 
-Reader ReaderFactory::CreateWithStream(std::istream& stream)
+} // namespace
+
+Reader ReaderFactory::CreateCached(std::istream& stream, boost::uint32_t cache_size)
 {
     detail::HeaderReaderPtr h(new detail::reader::Header(stream));
     h->ReadHeader();
     HeaderPtr header = h->GetHeader();
 
-    if (header->Compressed())
-    {
-#ifdef HAVE_LASZIP
-        ReaderIPtr r = ReaderIPtr(new detail::ZipReaderImpl(stream) );
-        return liblas::Reader(r);
-#else
-        throw configuration_error("Compression support not enabled in liblas configuration");
-#endif
-    }
+    std::size_t page_size = detail::CachedReaderImpl::default_page_size;
+    if (cache_size > 0 && cache_size < page_size)
+        page_size = cache_size;
+
+    std::size_t const budget = static_cast<std::size_t>(cache_size) * header->GetDataRecordLength();
+
+    ReaderIPtr r = ReaderIPtr(new detail::CachedReaderImpl(CreateImplWithStream(stream), page_size, budget) );
+    return liblas::Reader(r);
+}
+
+Reader ReaderFactory::CreateCached(std::istream& stream, std::string const& identity, SharedPageCache& cache)
+{
+    ReaderIPtr r = ReaderIPtr(new detail::CachedReaderImpl(CreateImplWithStream(stream), 
+                                                           detail::CachedReaderImpl::default_page_size, 
+                                                           cache, identity) );
+    return liblas::Reader(r);
+}
+
+Reader ReaderFactory::CreateMapped(std::string const& filename)
+{
+    // MappedReaderImpl::ReadHeader refuses compressed files with 
+    // a configuration_error when the Reader initializes it.
+    ReaderIPtr r = ReaderIPtr(new detail::MappedReaderImpl(filename) );
+    return liblas::Reader(r);
+}
+
+Reader ReaderFactory::CreateWithStream(std::istream& stream)
+{
+    ReaderIPtr r = CreateImplWithStream(stream);
+    return liblas::Reader(r);
+}
+
+Reader ReaderFactory::CreateWithStream(std::istream& stream, std::size_t decode_threads)
+{
+    if (0 == decode_threads)
+        throw configuration_error("ReaderFactory: decode thread count must be at least 1");
 
-    ReaderIPtr r = ReaderIPtr(new detail::ReaderImpl(stream) );
+    ReaderIPtr r = CreateImplWithStream(stream, decode_threads);
+    return liblas::Reader(r);
+}
+
+Reader ReaderFactory::CreatePrefetched(std::istream& stream, std::size_t block_size, std::size_t depth)
+{
+    ReaderIPtr r = ReaderIPtr(new detail::PrefetchReaderImpl(CreateImplWithStream(stream), block_size, depth) );
     return liblas::Reader(r);
 }
 
@@ -130,6 +175,51 @@ WriterIPtr WriterFactory::CreateWithStream(std::ostream& stream, Header const& h
     return w;
 }
 
+WriterIPtr WriterFactory::CreateWithStream(std::ostream& stream, 
+                                           Header const& header, 
+                                           std::size_t encode_threads, 
+                                           bool chunk_summaries)
+{
+    if (0 == encode_threads)
+        throw configuration_error("WriterFactory: encode thread count must be at least 1");
+
+    if (header.Compressed())
+    {
+#ifdef HAVE_LASZIP
+        WriterIPtr w  = WriterIPtr(new detail::ZipWriterImpl(stream, encode_threads, chunk_summaries));
+        return w;
+#else
+    boost::ignore_unused_variable_warning(stream);
+    boost::ignore_unused_variable_warning(chunk_summaries);
+    throw configuration_error("Compression support not enabled in libLAS configuration");
+#endif
+    }
+
+    WriterIPtr w  = WriterIPtr(new detail::WriterImpl(stream));
+    return w;
+}
+
+WriterIPtr WriterFactory::CreateAsync(WriterIPtr writer, std::size_t queue_bytes)
+{
+    WriterIPtr w = WriterIPtr(new detail::AsyncWriterImpl(writer, queue_bytes));
+    return w;
+}
+
+WriterIPtr WriterFactory::CreateAppend(std::iostream& stream, Header const& header)
+{
+    detail::reader::Header reader(stream);
+    reader.ReadHeader();
+    liblas::Header const& existing = *reader.GetHeader();
+
+    if (existing.Compressed())
+        throw configuration_error("Points cannot be appended to compressed files");
+
+    WriterIPtr w = WriterIPtr(new detail::WriterImpl(stream, existing));
+    w->SetHeader(header);
+    w->WriteHeader();
+    return w;
+}
+
 
 static bool streq_insensitive(const std::string& p, const std::string& q)
 {
@@ -41,19 +41,124 @@
 
 #include <liblas/filter.hpp>
 #include <liblas/classification.hpp>
+#include <liblas/pointbuffer.hpp>
+#include <liblas/detail/binary.hpp>
+#include <liblas/detail/expression.hpp>
+#include <liblas/detail/private_utility.hpp>
 // boost
+#include <boost/array.hpp>
 #include <boost/cstdint.hpp>
 // std
+#include <cmath>
+#include <limits>
 #include <vector>
 
 using namespace boost;
 
 namespace liblas { 
 
+namespace {
+
+inline boost::uint16_t load_u16(boost::uint8_t const* data)
+{
+    detail::binary::endian_value<boost::uint16_t> value;
+    value.load<detail::binary::little_endian_tag>(data);
+    return value;
+}
+
+// Runs a 256-entry lookup table over the byte at offset pos of every
+// record of the span.
+std::size_t lookup_batch(PointSpan const& points,
+                         std::size_t pos,
+                         boost::array<boost::uint8_t, 256> const& table,
+                         SelectionMask& mask)
+{
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    if (0 == count)
+        return 0;
+
+    std::size_t const stride = points.GetRecordLength();
+    boost::uint8_t const* data = points.GetRecord(0) + pos;
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+    {
+        boost::uint8_t const keep = table[*data];
+        mask[i] = keep;
+        kept += keep;
+    }
+    return kept;
+}
+
+} // namespace
+
+std::size_t FilterI::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    mask.resize(points.size());
+
+    std::size_t kept = 0;
+
+    Point p;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        points.GetPoint(i, p);
+        mask[i] = filter(p) ? 1 : 0;
+        kept += mask[i];
+    }
+    return kept;
+}
+
+bool FilterI::filter_summary(ChunkSummary const& summary, Header const& header)
+{
+    boost::ignore_unused_variable_warning(summary);
+    boost::ignore_unused_variable_warning(header);
+    return true;
+}
+
 ClassificationFilter::ClassificationFilter( std::vector<liblas::Classification> classes )
     : FilterI(eInclusion)
     , m_classes(classes) 
+    , m_table_type(eInclusion)
+    , m_table_ready(false)
+{
+}
+
+void ClassificationFilter::PrepareTable()
+{
+    // The result only depends on the classification byte, so evaluate 
+    // filter() once per possible value and look the records up.
+    if (!m_table_ready || m_table_type != GetType())
+    {
+        Point p;
+        for (std::size_t b = 0; b < m_table.size(); ++b)
+        {
+            p.SetClassification(Classification(static_cast<boost::uint8_t>(b)));
+            m_table[b] = filter(p) ? 1 : 0;
+        }
+        m_table_type = GetType();
+        m_table_ready = true;
+    }
+}
+
+std::size_t ClassificationFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    PrepareTable();
+    return lookup_batch(points, 15, m_table, mask);
+}
+
+bool ClassificationFilter::filter_summary(ChunkSummary const& summary, Header const& header)
 {
+    boost::ignore_unused_variable_warning(header);
+
+    PrepareTable();
+    for (std::size_t b = 0; b < m_table.size(); ++b)
+    {
+        if (m_table[b] && summary.classifications.test(b))
+            return true;
+    }
+    return false;
 }
 
 bool ClassificationFilter::filter(const Point& p)
@@ -78,29 +183,212 @@ bool ClassificationFilter::filter(const Point& p)
     return output;
 }
 
-BoundsFilter::BoundsFilter( double minx, double miny, double maxx, double maxy ) : FilterI(eInclusion)
+namespace {
+
+// Finds the smallest and largest raw values v for which 
+// minimum <= v * scale + offset <= maximum, computed the same way 
+// Point::GetX does so raw and scaled comparisons always agree.  
+// Returns false if no raw value qualifies.
+bool raw_range(double minimum, double maximum, double scale, double offset,
+               boost::int32_t& raw_min, boost::int32_t& raw_max)
+{
+    boost::int64_t const lowest = (std::numeric_limits<boost::int32_t>::min)();
+    boost::int64_t const highest = (std::numeric_limits<boost::int32_t>::max)();
+
+    double lo = std::ceil((minimum - offset) / scale);
+    double hi = std::floor((maximum - offset) / scale);
+
+    if (!(lo <= hi + 1.0))
+        return false;
+
+    lo = (std::max)(lo, static_cast<double>(lowest));
+    hi = (std::min)(hi, static_cast<double>(highest));
+    if (lo > static_cast<double>(highest) || hi < static_cast<double>(lowest))
+        return false;
+
+    boost::int64_t l = static_cast<boost::int64_t>(lo);
+    boost::int64_t h = static_cast<boost::int64_t>(hi);
+
+    // Nudge the estimates to absorb rounding in the division above
+    while (l > lowest && static_cast<double>(l - 1) * scale + offset >= minimum)
+        --l;
+    while (l <= highest && static_cast<double>(l) * scale + offset < minimum)
+        ++l;
+    while (h < highest && static_cast<double>(h + 1) * scale + offset <= maximum)
+        ++h;
+    while (h >= lowest && static_cast<double>(h) * scale + offset > maximum)
+        --h;
+
+    if (l > h)
+        return false;
+
+    raw_min = static_cast<boost::int32_t>(l);
+    raw_max = static_cast<boost::int32_t>(h);
+    return true;
+}
+
+inline boost::int32_t load_raw(boost::uint8_t const* data)
+{
+    liblas::detail::binary::endian_value<boost::int32_t> value;
+    value.load<liblas::detail::binary::little_endian_tag>(data);
+    return value;
+}
+
+} // namespace
+
+BoundsFilter::BoundsFilter( double minx, double miny, double maxx, double maxy ) 
+    : FilterI(eInclusion)
+    , m_header(0)
+    , m_raw(false)
 {
     bounds = Bounds<double>(minx, miny, maxx, maxy);
 }
 
-BoundsFilter::BoundsFilter( double minx, double miny, double minz, double maxx, double maxy, double maxz ) : FilterI(eInclusion)
+BoundsFilter::BoundsFilter( double minx, double miny, double minz, double maxx, double maxy, double maxz ) 
+    : FilterI(eInclusion)
+    , m_header(0)
+    , m_raw(false)
 {
     bounds = Bounds<double>(minx, miny, minz, maxx, maxy, maxz);
 }
 
-BoundsFilter::BoundsFilter( Bounds<double> const& b) : FilterI(eInclusion)
+BoundsFilter::BoundsFilter( Bounds<double> const& b) 
+    : FilterI(eInclusion)
+    , m_header(0)
+    , m_raw(false)
 {
     bounds = b;
 }
+
+bool BoundsFilter::Prepare(Header const* header)
+{
+    if (header == m_header &&
+        header->GetScaleX() == m_scale[0] && header->GetOffsetX() == m_offset[0] &&
+        header->GetScaleY() == m_scale[1] && header->GetOffsetY() == m_offset[1] &&
+        header->GetScaleZ() == m_scale[2] && header->GetOffsetZ() == m_offset[2])
+    {
+        return m_raw;
+    }
+
+    m_header = header;
+    m_scale[0] = header->GetScaleX();
+    m_scale[1] = header->GetScaleY();
+    m_scale[2] = header->GetScaleZ();
+    m_offset[0] = header->GetOffsetX();
+    m_offset[1] = header->GetOffsetY();
+    m_offset[2] = header->GetOffsetZ();
+
+    m_raw = m_scale[0] > 0.0 && m_scale[1] > 0.0 && m_scale[2] > 0.0;
+    if (!m_raw)
+        return false;
+
+    // If our z bounds has no length, we keep any z value.
+    bool const use_z = bounds.dimension() > 2 && 
+                       !detail::compare_distance((bounds.max)(2) - (bounds.min)(2), 0.0);
+    std::size_t const dimensions = use_z ? 3 : 2;
+
+    m_raw_min[2] = (std::numeric_limits<boost::int32_t>::min)();
+    m_raw_max[2] = (std::numeric_limits<boost::int32_t>::max)();
+
+    for (std::size_t i = 0; i < dimensions; ++i)
+    {
+        if (!raw_range((bounds.min)(i), (bounds.max)(i), m_scale[i], m_offset[i], 
+                       m_raw_min[i], m_raw_max[i]))
+        {
+            // Nothing can be inside, make every comparison fail
+            m_raw_min[i] = (std::numeric_limits<boost::int32_t>::max)();
+            m_raw_max[i] = (std::numeric_limits<boost::int32_t>::min)();
+        }
+    }
+
+    return true;
+}
+
 bool BoundsFilter::filter(const Point& p)
 {
-    return bounds.contains(p);
+    if (!Prepare(p.GetHeader()))
+        return bounds.contains(p);
+
+    boost::int32_t const x = p.GetRawX();
+    boost::int32_t const y = p.GetRawY();
+    boost::int32_t const z = p.GetRawZ();
+
+    return x >= m_raw_min[0] && x <= m_raw_max[0] &&
+           y >= m_raw_min[1] && y <= m_raw_max[1] &&
+           z >= m_raw_min[2] && z <= m_raw_max[2];
     // lasinfo --extent 630000.00 4834500.00 46.83 630300 4834600.00 150.00 TO_core_las_zoom.las
     
     // lasinfo --minx 630000.00 --miny 4834500.00 --minz 46.83 --maxx 630300 --maxy 4834600.00 --maxz 150.00 TO_core_las_zoom.las
 
 }
 
+std::size_t BoundsFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    if (0 == count)
+        return 0;
+
+    std::size_t kept = 0;
+
+    if (!Prepare(points.GetHeader()))
+    {
+        Point p;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.GetPoint(i, p);
+            mask[i] = bounds.contains(p) ? 1 : 0;
+            kept += mask[i];
+        }
+        return kept;
+    }
+
+    boost::int32_t const minx = m_raw_min[0];
+    boost::int32_t const maxx = m_raw_max[0];
+    boost::int32_t const miny = m_raw_min[1];
+    boost::int32_t const maxy = m_raw_max[1];
+    boost::int32_t const minz = m_raw_min[2];
+    boost::int32_t const maxz = m_raw_max[2];
+
+    std::size_t const stride = points.GetRecordLength();
+    boost::uint8_t const* data = points.GetRecord(0);
+
+    // No branches in the loop body, every record costs the same
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+    {
+        boost::int32_t const x = load_raw(data);
+        boost::int32_t const y = load_raw(data + 4);
+        boost::int32_t const z = load_raw(data + 8);
+
+        boost::uint8_t const inside = static_cast<boost::uint8_t>(
+            (x >= minx) & (x <= maxx) & 
+            (y >= miny) & (y <= maxy) & 
+            (z >= minz) & (z <= maxz));
+
+        mask[i] = inside;
+        kept += inside;
+    }
+
+    return kept;
+}
+
+bool BoundsFilter::filter_summary(ChunkSummary const& summary, Header const& header)
+{
+    if (summary.empty())
+        return false;
+
+    if (!Prepare(&header))
+        return true;
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (summary.max[i] < m_raw_min[i] || summary.min[i] > m_raw_max[i])
+            return false;
+    }
+    return true;
+}
+
 
 
 ThinFilter::ThinFilter( uint32_t thin ) :
@@ -133,13 +421,56 @@ bool ThinFilter::filter(const liblas::Point& p)
     return output;
 }
 
+std::size_t ThinFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        boost::uint8_t keep = 0;
+        if (thin_amount == thin_count)
+        {
+            keep = 1;
+            thin_count = 0;
+        }
+        thin_count = thin_count + 1;
+
+        mask[i] = keep;
+        kept += keep;
+    }
+    return kept;
+}
+
 
 ReturnFilter::ReturnFilter( return_list_type returns, bool last_only )
     : FilterI(eInclusion)
     , m_returns(returns), last_only(last_only)
+    , m_table_type(eInclusion)
+    , m_table_ready(false)
 {
 }
 
+std::size_t ReturnFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    // Return number and number of returns both live in the scan flags 
+    // byte, so filter() is evaluated once per possible value.
+    if (!m_table_ready || m_table_type != GetType())
+    {
+        Point p;
+        for (std::size_t b = 0; b < m_table.size(); ++b)
+        {
+            p.SetScanFlags(static_cast<boost::uint8_t>(b));
+            m_table[b] = filter(p) ? 1 : 0;
+        }
+        m_table_type = GetType();
+        m_table_ready = true;
+    }
+
+    return lookup_batch(points, 14, m_table, mask);
+}
+
 bool ReturnFilter::filter(const Point& p)
 {
 
@@ -175,8 +506,28 @@ bool ReturnFilter::filter(const Point& p)
 
 ValidationFilter::ValidationFilter() :
  liblas::FilterI(eInclusion)
+ , m_table_type(eInclusion)
 {
+    PrepareTables();
+}
 
+void ValidationFilter::PrepareTables()
+{
+    // Validity depends on the scan flags byte and the scan angle byte 
+    // only; tabulate filter() over each and combine the two lookups.
+    Point p;
+    for (std::size_t b = 0; b < m_flags.size(); ++b)
+    {
+        p.SetScanFlags(static_cast<boost::uint8_t>(b));
+        m_flags[b] = filter(p) ? 1 : 0;
+    }
+    p.SetScanFlags(0);
+    for (std::size_t b = 0; b < m_angles.size(); ++b)
+    {
+        p.SetScanAngleRank(static_cast<boost::int8_t>(b));
+        m_angles[b] = filter(p) ? 1 : 0;
+    }
+    m_table_type = GetType();
 }
 
 
@@ -196,6 +547,32 @@ bool ValidationFilter::filter(const liblas::Point& p)
     return output;
 }
 
+std::size_t ValidationFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    // The tables are built in the constructor, and only again if the 
+    // filter type was changed since.
+    if (m_table_type != GetType())
+        PrepareTables();
+
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    if (0 == count)
+        return 0;
+
+    std::size_t const stride = points.GetRecordLength();
+    boost::uint8_t const* data = points.GetRecord(0);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+    {
+        boost::uint8_t const keep = m_flags[data[14]] & m_angles[data[16]];
+        mask[i] = keep;
+        kept += keep;
+    }
+    return kept;
+}
+
 
 ColorFilter::ColorFilter(liblas::Color const& low, liblas::Color const& high) :
  liblas::FilterI(eInclusion), m_low(low), m_high(high)
@@ -250,4 +627,105 @@ bool ColorFilter::filter(const liblas::Point& p)
     return DoExclude();
 }
 
+std::size_t ColorFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    std::size_t const count = points.size();
+    mask.resize(count);
+
+    if (0 == count)
+        return 0;
+
+    // Formats without color report black for every point, see 
+    // Point::GetColor.
+    PointFormatName const f = points.GetHeader()->GetDataFormatId();
+    bool const has_color = !(f == ePointFormat0 || f == ePointFormat1);
+    std::size_t const pos = (f == ePointFormat3) ? 28 : 20;
+
+    Color::value_type const low_red = m_low.GetRed();
+    Color::value_type const low_green = m_low.GetGreen();
+    Color::value_type const low_blue = m_low.GetBlue();
+    Color::value_type const high_red = m_high.GetRed();
+    Color::value_type const high_green = m_high.GetGreen();
+    Color::value_type const high_blue = m_high.GetBlue();
+
+    boost::uint8_t const inside_value = DoExclude() ? 1 : 0;
+
+    std::size_t const stride = points.GetRecordLength();
+    boost::uint8_t const* data = points.GetRecord(0);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+    {
+        Color::value_type red = 0;
+        Color::value_type green = 0;
+        Color::value_type blue = 0;
+        if (has_color)
+        {
+            red = load_u16(data + pos);
+            green = load_u16(data + pos + 2);
+            blue = load_u16(data + pos + 4);
+        }
+
+        bool const inside = 
+            red >= low_red && red <= high_red &&
+            blue >= low_blue && blue <= high_blue &&
+            green >= low_green && green <= high_green;
+
+        boost::uint8_t const keep = inside ? inside_value : !inside_value;
+        mask[i] = keep;
+        kept += keep;
+    }
+    return kept;
+}
+
+ExpressionFilter::ExpressionFilter(std::string const& expression)
+    : FilterI(eInclusion)
+    , m_program(new detail::expression::Program(expression))
+{
+}
+
+ExpressionFilter::~ExpressionFilter()
+{
+}
+
+std::string const& ExpressionFilter::GetExpression() const
+{
+    return m_program->GetText();
+}
+
+bool ExpressionFilter::filter(const Point& p)
+{
+    PointSpan span(p.GetHeader(), &p.GetData().front(), 1);
+    bool const match = m_program->Evaluate(span, m_single) > 0;
+    return match == (GetType() == eInclusion);
+}
+
+std::size_t ExpressionFilter::filter_batch(PointSpan const& points, SelectionMask& mask)
+{
+    std::size_t const matches = m_program->Evaluate(points, mask);
+
+    if (GetType() == eInclusion)
+        return matches;
+
+    for (SelectionMask::iterator i = mask.begin(); i != mask.end(); ++i)
+        *i ^= 1;
+    return mask.size() - matches;
+}
+
+bool ExpressionFilter::filter_summary(ChunkSummary const& summary, Header const& header)
+{
+    bool can_hold = true;
+    bool can_fail = true;
+    try
+    {
+        m_program->EvaluateSummary(&header, summary, can_hold, can_fail);
+    } catch (liblas::invalid_expression const&)
+    {
+        // Leave it to filter_batch to report
+        return true;
+    }
+
+    return GetType() == eInclusion ? can_hold : can_fail;
+}
+
 } // namespace liblas
@@ -41,9 +41,17 @@
 
 #include <liblas/index.hpp>
 #include <liblas/writer.hpp>
+#include <liblas/pointbuffer.hpp>
 #include <liblas/detail/index/indexoutput.hpp>
 #include <liblas/detail/index/indexcell.hpp>
+#include <liblas/detail/index/indexbinner.hpp>
 #include <liblas/detail/writer/writer.hpp>
+// boost
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+// std
+#include <algorithm>
 
 namespace liblas
 {
@@ -94,6 +102,10 @@ bool Index::Prep(IndexData const& ParamSrc)
 		m_maxMemoryUsage = LIBLAS_INDEX_MAXMEMDEFAULT;
 	if (m_maxMemoryUsage < LIBLAS_INDEX_MINMEMDEFAULT)
 		m_maxMemoryUsage = LIBLAS_INDEX_MINMEMDEFAULT;
+	if (ParamSrc.m_buildThreads > 0)
+		m_buildThreads = ParamSrc.m_buildThreads;
+	else
+		m_buildThreads = (std::max)(boost::thread::hardware_concurrency(), 1U);
 	m_indexBuilt = IndexInit();
 	return (m_indexBuilt);
 	
@@ -106,7 +118,6 @@ void Index::SetValues(void)
 	m_idxreader = 0;
     m_ofs = 0;
   	m_readerCreated = false;
-	m_tempFile = 0;
 	m_outputFile = 0;
     m_debugOutputLevel = 0;
     m_tempFileName = "";
@@ -121,10 +132,10 @@ void Index::SetValues(void)
 	m_forceNewIndex = false;
 	m_DataVLR_ID = 43;
 	m_maxMemoryUsage = LIBLAS_INDEX_MAXMEMDEFAULT;
+	m_buildThreads = 1;
     m_rangeX = m_rangeY = m_rangeZ = m_cellSizeZ = m_cellSizeX = m_cellSizeY = 
 		m_pointRecordsCount = m_maxMemoryUsage = m_cellsX = m_cellsY = m_cellsZ = m_totalCells = 0;
-    m_tempFileWrittenBytes = 0;
-	m_indexBuilt = m_tempFileStarted = m_readerCreated = false;
+	m_indexBuilt = m_readerCreated = false;
 } // Index::SetValues
 
 Index::~Index(void)
@@ -1100,6 +1111,11 @@ bool Index::BuildIndex(void)
 	// we'll create a vector of that many entities
 	
 	try {
+		// sort the points into cells, each binner holding the points of its own threads
+		IndexBinnerList Binners;
+		if (! BinPoints(Binners))
+			return false;
+
 		// a one dimensional array to represent cell matrix
 		IndexCellRow IndexCellsY(m_cellsY);
 		// a two dimensional array
@@ -1109,54 +1125,27 @@ bool Index::BuildIndex(void)
 		// for Z bounds debugging
 		boost::uint32_t ZRangeSum = 0;
 		boost::uint32_t PointSum = 0;
-		// read each point in the file
-		// figure out what cell in X and Y
-		// test to see if it is the same as the last cell
-		boost::uint32_t LastCellX = static_cast<boost::uint32_t>(~0), LastCellY = static_cast<boost::uint32_t>(~0);
 		liblas::detail::ElevRange ZRange;
-		boost::uint32_t PointID = 0;
-		boost::uint32_t LastPointID = 0;
 		boost::uint32_t PtsIndexed = 0;
-		boost::uint32_t PointsInMemory = 0, MaxPointsInMemory;
-		MaxPointsInMemory = m_maxMemoryUsage / sizeof(liblas::detail::IndexCell);
-		// ReadNextPoint() throws a std::out_of_range error when it hits end of range so don't 
-		// get excited when you see it in the debug output
-		while (m_reader->ReadNextPoint())
+
+		// combine the point counts and Z bounds of every binner's cells, the point records stay with the binners
+		for (IndexBinnerList::iterator BinIt = Binners.begin(); BinIt != Binners.end(); ++BinIt)
 		{
-			boost::uint32_t CurCellX, CurCellY;
-			// analyze the point to determine its cell ID
-			Point const& CurPt = m_reader->GetPoint();
-			if (IdentifyCell(CurPt, CurCellX, CurCellY))
+			for (boost::uint32_t x = 0; x < m_cellsX; ++x)
 			{
-				// if same cell as last point, attempt to increment the count of consecutive points for the cell
-				// otherwise add a new point, first checking to see if the memory allocated to this process is full
-				if (! (CurCellX == LastCellX && CurCellY == LastCellY &&
-					IndexCellBlock[CurCellX][CurCellY].IncrementPointRecord(LastPointID)))
+				for (boost::uint32_t y = 0; y < m_cellsY; ++y)
 				{
-					// if memory allocated to this process is full, write all the point data to a temp file
-					if (m_tempFileName.size() && PointsInMemory >= MaxPointsInMemory)
+					liblas::detail::IndexCell const& BinnedCell = (*BinIt)->GetCell(x, y);
+					if (BinnedCell.GetNumPoints())
 					{
-						if (! PurgePointsToTempFile(IndexCellBlock))
-							return (FileError("Index::BuildIndex"));
-						PointsInMemory = 0;
+						IndexCellBlock[x][y].SetNumPoints(IndexCellBlock[x][y].GetNumPoints() + BinnedCell.GetNumPoints());
+						IndexCellBlock[x][y].UpdateZBounds(BinnedCell.GetMinZ());
+						IndexCellBlock[x][y].UpdateZBounds(BinnedCell.GetMaxZ());
 					} // if
-					IndexCellBlock[CurCellX][CurCellY].AddPointRecord(PointID);
-					LastPointID = PointID;
-					LastCellX = CurCellX;
-					LastCellY = CurCellY;
-					++PointsInMemory;
-				} // else
-			// update Z cell bounds
-			IndexCellBlock[CurCellX][CurCellY].UpdateZBounds(CurPt.GetZ());
-			} // if
-		++PointID;
-		} // while
-		// write remaining points to temp file
-		if (m_tempFileName.size())
-		{
-			if (! PurgePointsToTempFile(IndexCellBlock))
-				return (FileError("Index::BuildIndex"));
-		} // if using temp file
+				} // for y
+			} // for x
+			(*BinIt)->ReleaseCells();
+		} // for
 
 		// print some statistics to the console
 		if (m_debugOutputLevel > 2)
@@ -1168,7 +1157,7 @@ bool Index::BuildIndex(void)
 		} // if
 
 		// Here's where it gets fun
-		// Read the binned data from the temp file, one cell at a time
+		// Read the binned data from the temp files, one cell at a time
 		// Store the data in Variable records section of the LAS file
 		// If a cell contains too many points, subdivide the cell and save sub-cells within the cell structure
 		// If Z-binning is desired, define the bounds of each Z zone and subdivide sort each cell's points into Z bins
@@ -1182,7 +1171,7 @@ bool Index::BuildIndex(void)
 				{
 					if (m_debugOutputLevel > 3)
 						fprintf(m_debugger, "reloading %d %d\n", x, y);
-					if (LoadCellFromTempFile(&IndexCellBlock[x][y], x, y))
+					if (LoadCellFromTempFile(Binners, &IndexCellBlock[x][y], x, y))
 					{
 						ZRange = IndexCellBlock[x][y].GetZRange();
 						// if Z-binning is specified, create Z sub-cells first
@@ -1271,7 +1260,7 @@ bool Index::BuildIndex(void)
 				} // for y
 			} // for x
 			// done with this baby
-			CloseTempFile();
+			Binners.clear();
 			if (! IndexOut.FinalizeOutput())
 				return (FileError("Index::BuildIndex"));
 			if (m_debugOutputLevel)
@@ -1301,7 +1290,6 @@ bool Index::BuildIndex(void)
 		} // if
 	} // try
 	catch (std::bad_alloc) {
-		CloseTempFile();
 		return (MemoryError("Index::BuildIndex"));
 	} // catch
 	
@@ -1387,177 +1375,98 @@ bool Index::IdentifySubCell(Point const& CurPt, boost::uint32_t x, boost::uint32
 
 } // Index::IdentifySubCell
 
-bool Index::PurgePointsToTempFile(IndexCellDataBlock& CellBlock)
+bool Index::BinPoints(IndexBinnerList& Binners)
 {
-	if (m_tempFile || OpenTempFile())
+	// each binner is allowed an equal share of the memory
+	boost::uint32_t MaxPointsInMemory = m_maxMemoryUsage / sizeof(liblas::detail::IndexCell) / m_buildThreads;
+	// a slice is the run of points binned by one binner at a time
+	std::size_t const PointsPerSlice = 65536;
+
+	for (boost::uint32_t i = 0; i < m_buildThreads; ++i)
 	{
-		liblas::detail::TempFileOffsetType EmptyOffset = 0;	// this might not be large enough
-		
-		if (! m_tempFileStarted)
+		std::string TempFileName = m_tempFileName;
+		if (i > 0 && TempFileName.size())
+			TempFileName += "-" + boost::lexical_cast<std::string>(i);
+		Binners.push_back(boost::shared_ptr<liblas::detail::IndexBinner>(
+			new liblas::detail::IndexBinner(this, TempFileName, MaxPointsInMemory)));
+	} // for
+
+	// read the points a block at a time. Each binner is given one contiguous slice of the block
+	// and the binners run on their own threads while the next block is read
+	std::size_t const BlockSize = PointsPerSlice * Binners.size();
+	PointBuffer Block, NextBlock;
+	boost::uint32_t PointID = 0;
+	std::size_t PointsRead = m_reader->ReadNextPoints(Block, BlockSize);
+	while (PointsRead)
+	{
+		boost::thread_group Threads;
+		std::size_t const SliceSize = (PointsRead + Binners.size() - 1) / Binners.size();
+		for (std::size_t i = 0; i < Binners.size() && i * SliceSize < PointsRead; ++i)
 		{
-			// there is some setup of the temp file to be done first
-			// write out a block of file offsets the size of the number of cells
-			for (boost::uint32_t i = 0; i < m_totalCells; ++i)
-			{
-				if (fwrite(&EmptyOffset, sizeof(liblas::detail::TempFileOffsetType), 1, m_tempFile) < 1)
-				{
-					return (FileError("Index::PurgePointsToTempFile"));
-				} // if error
-			} // for
-			m_tempFileWrittenBytes = m_totalCells * sizeof(liblas::detail::TempFileOffsetType);
-			m_tempFileStarted = true;
-		} // if
-		for (boost::uint32_t x = 0; x < m_cellsX; ++x)
+			std::size_t const First = i * SliceSize;
+			PointSpan Slice(Block, First, (std::min)(SliceSize, PointsRead - First));
+			if (Binners.size() > 1)
+				Threads.create_thread(boost::bind(&liblas::detail::IndexBinner::BinPoints, Binners[i].get(), 
+					Slice, static_cast<boost::uint32_t>(PointID + First)));
+			else
+				Binners[i]->BinPoints(Slice, static_cast<boost::uint32_t>(PointID + First));
+		} // for
+		PointID += static_cast<boost::uint32_t>(PointsRead);
+		try {
+			PointsRead = m_reader->ReadNextPoints(NextBlock, BlockSize);
+		} // try
+		catch (...) {
+			// the binners still refer to Block
+			Threads.join_all();
+			throw;
+		} // catch
+		Threads.join_all();
+		Block.swap(NextBlock);
+		for (IndexBinnerList::iterator BinIt = Binners.begin(); BinIt != Binners.end(); ++BinIt)
 		{
-			for (boost::uint32_t y = 0; y < m_cellsY; ++y)
-			{
-				boost::uint32_t RecordsToWrite = CellBlock[x][y].GetNumRecords();
-				if (RecordsToWrite)
-				{
-					// write the current file location in the cell block header
-					// if cell block header is 0 write the current file location in the file header
-					// otherwise write the current file location at the file location specified in the 
-					// cell block header
-					liblas::detail::TempFileOffsetType LastWriteLocation = CellBlock[x][y].GetFileOffset();
-					if (LastWriteLocation == 0)
-						LastWriteLocation = (x * m_cellsY + y) * sizeof(liblas::detail::TempFileOffsetType);
-#ifdef _MSC_VER
-					_fseeki64(m_tempFile, LastWriteLocation, SEEK_SET);
-#else
-					fseek(m_tempFile, LastWriteLocation, SEEK_SET);
-#endif
-					if (fwrite(&m_tempFileWrittenBytes, sizeof(liblas::detail::TempFileOffsetType), 1, m_tempFile) < 1)
-						return (FileError("Index::PurgePointsToTempFile"));
-					CellBlock[x][y].SetFileOffset(m_tempFileWrittenBytes);
-
-					// seek to end of file where next block of data will be written
-#ifdef _MSC_VER
-					_fseeki64(m_tempFile, 0, SEEK_END);
-#else
-					fseek(m_tempFile, 0, SEEK_END);
-#endif
-
-					// write a blank space for later placement of next file block for this cell
-					if (fwrite(&EmptyOffset, sizeof(liblas::detail::TempFileOffsetType), 1, m_tempFile) < 1)
-						return (FileError("Index::PurgePointsToTempFile"));
-					m_tempFileWrittenBytes += sizeof(liblas::detail::TempFileOffsetType);
-					// write the number of records stored in this section
-					if (fwrite(&RecordsToWrite, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
-						return (FileError("Index::PurgePointsToTempFile"));
-					m_tempFileWrittenBytes += sizeof(boost::uint32_t);
-
-					liblas::detail::IndexCellData::iterator MapIt = CellBlock[x][y].GetFirstRecord();
-					for (boost::uint32_t RecordNum = 0; RecordNum < RecordsToWrite && MapIt != CellBlock[x][y].GetEnd(); ++RecordNum, ++MapIt)
-					{
-						// write the point ID
-						boost::uint32_t PointID = MapIt->first;
-						// write the number of consecutive points
-						liblas::detail::ConsecPtAccumulator ConsecutivePoints = MapIt->second;
-						if (fwrite(&PointID, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
-							return (FileError("Index::PurgePointsToTempFile"));
-						if (fwrite(&ConsecutivePoints, sizeof(liblas::detail::ConsecPtAccumulator), 1, m_tempFile) < 1)
-							return (FileError("Index::PurgePointsToTempFile"));
-						m_tempFileWrittenBytes += sizeof(boost::uint32_t);
-						m_tempFileWrittenBytes += sizeof(liblas::detail::ConsecPtAccumulator);
-					} // for
-					// purge the records for this cell from active memory
-					CellBlock[x][y].RemoveMainRecords();
-				} // if
-			} // for y
-		} // for x
-		// necessary for subsequent reads in case fseek isn't called first
-		fflush(m_tempFile);
-		return true;
-	} // if file
+			if ((*BinIt)->OutOfMemory())
+				return (MemoryError("Index::BinPoints"));
+			if ((*BinIt)->Failed())
+				return (FileError("Index::BinPoints"));
+		} // for
+	} // while
 
-	return (FileError("Index::PurgePointsToTempFile"));
+	// write remaining points to temp files
+	if (m_tempFileName.size())
+	{
+		for (IndexBinnerList::iterator BinIt = Binners.begin(); BinIt != Binners.end(); ++BinIt)
+		{
+			if (! (*BinIt)->PurgePointsToTempFile())
+				return (FileError("Index::BinPoints"));
+		} // for
+	} // if using temp file
+	return true;
 
-} // Index::PurgePointsToTempFile
+} // Index::BinPoints
 
-bool Index::LoadCellFromTempFile(liblas::detail::IndexCell *CellBlock, 
+bool Index::LoadCellFromTempFile(IndexBinnerList const& Binners, liblas::detail::IndexCell *CellBlock, 
 	boost::uint32_t CurCellX, boost::uint32_t CurCellY)
 {
 
-	boost::uint32_t RecordsToRead, FormerNumPts, NewNumPts = 0;
-	liblas::detail::TempFileOffsetType FileOffset;
+	boost::uint32_t FormerNumPts, NewNumPts = 0;
 	
 	FormerNumPts = CellBlock->GetNumPoints();
 	CellBlock->SetNumPoints(0);
 	
-	// load the cell as it was written
-	// read the first offset for this cell
-
-#ifdef _MSC_VER
-	if (_fseeki64(m_tempFile, (CurCellX * m_cellsY + CurCellY) * sizeof (liblas::detail::TempFileOffsetType), SEEK_SET))
-#else
-	if (fseek(m_tempFile, (CurCellX * m_cellsY + CurCellY) * sizeof (liblas::detail::TempFileOffsetType), SEEK_SET))
-#endif
-		return (FileError("Index::LoadCellFromTempFile"));
-	if (fread(&FileOffset, sizeof (liblas::detail::TempFileOffsetType), 1, m_tempFile) < 1)
-		return (FileError("Index::LoadCellFromTempFile"));
-	while (FileOffset > 0)
+	// collect the records for this cell from every binner
+	for (IndexBinnerList::const_iterator BinIt = Binners.begin(); BinIt != Binners.end(); ++BinIt)
 	{
-		// jump to the first block for this cell, read the next offset
-
-#ifdef _MSC_VER
-		if (_fseeki64(m_tempFile, FileOffset, SEEK_SET))
-#else
-		if (fseek(m_tempFile, FileOffset, SEEK_SET))
-#endif
-
-			return (FileError("Index::LoadCellFromTempFile"));
-		if (fread(&FileOffset, sizeof (liblas::detail::TempFileOffsetType), 1, m_tempFile) < 1)
+		if (! (*BinIt)->LoadCellFromTempFile(CellBlock, CurCellX, CurCellY))
 			return (FileError("Index::LoadCellFromTempFile"));
-		// read the data for the cell in this block
-		// first is the number of items to read now
-		if (fread(&RecordsToRead, sizeof (boost::uint32_t), 1, m_tempFile) < 1)
-			return (FileError("Index::LoadCellFromTempFile"));
-		for (boost::uint32_t RecordNum = 0; RecordNum < RecordsToRead; ++RecordNum)
-		{
-			boost::uint32_t PointID;
-			liblas::detail::ConsecPtAccumulator ConsecutivePoints;
-			// read the point ID
-			if (fread(&PointID, sizeof(boost::uint32_t), 1, m_tempFile) < 1)
-				return (FileError("Index::LoadCellFromTempFile"));
-			// read the number of consecutive points
-			if (fread(&ConsecutivePoints, sizeof(liblas::detail::ConsecPtAccumulator), 1, m_tempFile) < 1)
-				return (FileError("Index::LoadCellFromTempFile"));
-			CellBlock->AddPointRecord(PointID, ConsecutivePoints);
-		} // for
-	} // while
+	} // for
 	// check to see that we got the number of points back that we started with
 	NewNumPts = CellBlock->GetNumPoints();
 	if (NewNumPts != FormerNumPts)
-	{
-		CloseTempFile();
 		return (PointCountError("Index::LoadCellFromTempFile"));
-	} // if
 	return (true);
 
 } // Index::LoadCellFromTempFile
 
-FILE *Index::OpenTempFile(void)
-{
-
-	m_tempFileStarted = 0;
-	m_tempFileWrittenBytes = 0;
-	return (m_tempFile = fopen(m_tempFileName.c_str(), "wb+"));
-    
-} // Index::OpenTempFile
-
-void Index::CloseTempFile(void)
-{
-
-	if (m_tempFile)
-	{
-		fclose(m_tempFile);
-		remove(m_tempFileName.c_str());
-	} // if
-	m_tempFile = 0;
-	m_tempFileWrittenBytes = 0;
-    
-} // Index::CloseTempFile
-
 bool Index::SaveIndexInLASFile(void)
 {
 	try {
@@ -1599,7 +1508,6 @@ bool Index::SaveIndexInStandAloneFile(void)
 bool Index::FileError(const char *Reporter)
 {
 
-	CloseTempFile();
 	if (m_debugOutputLevel)
 		fprintf(m_debugger, "File i/o error, %s\n", Reporter);
 	return false;
@@ -1769,6 +1677,7 @@ IndexData::IndexData(Index const& index)
 		m_maxMemoryUsage = LIBLAS_INDEX_MAXMEMDEFAULT;
 	if (m_maxMemoryUsage < LIBLAS_INDEX_MINMEMDEFAULT)
 		m_maxMemoryUsage = LIBLAS_INDEX_MINMEMDEFAULT;
+	m_buildThreads = index.GetBuildThreads();
 	m_indexValid = index.IndexReady();
 } // IndexData::IndexData
 
@@ -1798,6 +1707,7 @@ void IndexData::Copy(IndexData const& other)
 		m_indexDate = other.m_indexDate;
 		m_cellSizeZ = other.m_cellSizeZ;
 		m_maxMemoryUsage = other.m_maxMemoryUsage;
+		m_buildThreads = other.m_buildThreads;
 		m_debugOutputLevel = other.m_debugOutputLevel;
 		m_readOnly = other.m_readOnly;
 		m_writestandaloneindex = other.m_writestandaloneindex;
@@ -1840,6 +1750,7 @@ void IndexData::SetValues(void)
 	m_indexDate = 0;
 	m_cellSizeZ = 0.0;
 	m_maxMemoryUsage = 0;
+	m_buildThreads = 1;
 	m_debugOutputLevel = 0;
 	m_readOnly = false;
 	m_writestandaloneindex = false;
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Preallocated memory-mapped LAS writer
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/mappedwriter.hpp>
+#include <liblas/chunksummary.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/private_utility.hpp>
+#include <liblas/detail/writer/header.hpp>
+// boost
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+// std
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+
+namespace liblas {
+
+MappedWriter::MappedWriter(std::string const& filename, Header const& header, boost::uint32_t count)
+    : m_filename(filename)
+    , m_header(header)
+    , m_count(count)
+    , m_written(0)
+    , m_record_size(header.GetDataRecordLength())
+    , m_data(0)
+{
+    using namespace boost::interprocess;
+
+    if (m_header.Compressed())
+        throw configuration_error("Compressed files are not writable with mapped writer");
+
+    // Truncate so the header writer does not take us for appending
+    m_ofs.open(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_ofs.is_open())
+    {
+        std::ostringstream msg;
+        msg << "MappedWriter: unable to open file '" << filename << "' for writing";
+        throw std::runtime_error(msg.str());
+    }
+
+    m_header.SetPointRecordsCount(m_count);
+    m_header_writer.reset(new detail::writer::Header(m_ofs, m_written, m_header));
+    m_header_writer->write();
+    m_header = m_header_writer->GetHeader();
+
+    if (0 == m_count)
+        return;
+
+    // Size the file once by writing its last byte
+    std::streamoff const offset = m_header.GetDataOffset();
+    std::streamoff const size = static_cast<std::streamoff>(m_count) * m_record_size;
+    m_ofs.seekp(offset + size - 1, std::ios::beg);
+    m_ofs.put(0);
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
+
+    try
+    {
+        m_mapping.reset(new file_mapping(m_filename.c_str(), read_write));
+        m_region.reset(new mapped_region(*m_mapping, 
+                                         read_write, 
+                                         static_cast<offset_t>(offset), 
+                                         static_cast<std::size_t>(size)));
+    } catch (interprocess_exception const& e)
+    {
+        std::ostringstream msg;
+        msg << "MappedWriter: unable to map '" << m_filename << "': " << e.what();
+        throw std::runtime_error(msg.str());
+    }
+
+    m_data = static_cast<boost::uint8_t*>(m_region->get_address());
+}
+
+MappedWriter::~MappedWriter()
+{
+    try
+    {
+        Close();
+    } catch (std::runtime_error const&)
+    {
+    }
+}
+
+boost::uint8_t* MappedWriter::GetRecords(std::size_t index, std::size_t count)
+{
+    if (!m_header_writer)
+        throw std::runtime_error("MappedWriter: the writer has been closed");
+
+    if (index > m_count || count > m_count - index)
+    {
+        std::ostringstream msg;
+        msg << "MappedWriter: records " << index << " to " << index + count 
+            << " run past the number of points: " << m_count;
+        throw std::out_of_range(msg.str());
+    }
+
+    return m_data + index * m_record_size;
+}
+
+void MappedWriter::WritePoint(std::size_t index, Point const& point)
+{
+    if (point.GetData().size() < m_record_size)
+        throw std::invalid_argument("WritePoint: the point is shorter than the records of the header");
+
+    boost::uint8_t* record = GetRecords(index, 1);
+    std::memcpy(record, &point.GetData().front(), m_record_size);
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_header_writer->AddPoints(record, 1, m_record_size);
+}
+
+void MappedWriter::WritePoints(std::size_t index, PointBuffer const& buffer)
+{
+    if (buffer.empty())
+        return;
+
+    if (buffer.GetRecordLength() != m_record_size)
+        throw std::invalid_argument("WritePoints: the records of the buffer do not match the header");
+
+    boost::uint8_t* records = GetRecords(index, buffer.size());
+    std::memcpy(records, buffer.GetRecord(0), buffer.size() * m_record_size);
+
+    // Summarize outside the lock so the writing threads only meet 
+    // for the merge.
+    ChunkSummary bounds;
+    boost::array<boost::uint32_t, 5> returns;
+    returns.assign(0);
+    detail::writer::Header::SummarizePoints(buffer.GetRecord(0), buffer.size(), m_record_size, 
+                                            bounds, returns);
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_header_writer->AddSummary(bounds, returns);
+}
+
+void MappedWriter::Close()
+{
+    if (!m_header_writer)
+        return;
+
+    if (m_region)
+    {
+        m_region->flush();
+        m_region.reset();
+        m_mapping.reset();
+        m_data = 0;
+    }
+
+    m_header_writer->WriteSummary(m_header, m_count);
+    m_header_writer.reset();
+
+    m_ofs.flush();
+    detail::check_stream_state(m_ofs);
+    m_ofs.close();
+}
+
+} // namespace liblas
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Multithreaded reading of disjoint point ranges
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/parallelreader.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/reader/header.hpp>
+#include <liblas/detail/reader/reader.hpp>
+// boost
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+// std
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace liblas {
+
+namespace {
+
+// State shared by the threads of one ForEachBatch call
+struct BatchState
+{
+    BatchState() : failed(false) {}
+
+    boost::mutex mutex;
+    std::string error;
+    bool failed;
+
+    bool Failed()
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        return failed;
+    }
+
+    void Fail(std::string const& message)
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if (!failed)
+        {
+            failed = true;
+            error = message.empty() ? std::string("ParallelReader: read failed") : message;
+        }
+    }
+};
+
+void OpenStream(std::ifstream& ifs, std::string const& filename)
+{
+    ifs.open(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+    {
+        std::ostringstream msg;
+        msg << "ParallelReader: unable to open file '" << filename << "' for reading";
+        throw std::runtime_error(msg.str());
+    }
+}
+
+void ReadRange(std::string const& filename,
+               Header const* header,
+               std::size_t thread,
+               std::size_t first,
+               std::size_t count,
+               std::size_t batch_size,
+               ParallelReader::IndexedBatchCallback const& callback,
+               BatchState& state)
+{
+    try
+    {
+        std::ifstream ifs;
+        OpenStream(ifs, filename);
+
+        detail::ReaderImpl reader(ifs);
+        reader.ReadHeader();
+        reader.Seek(first);
+
+        PointBuffer batch;
+        std::size_t index = first;
+        std::size_t remaining = count;
+        while (remaining > 0 && !state.Failed())
+        {
+            std::size_t const n = reader.ReadNextPoints(batch, (std::min)(batch_size, remaining));
+            if (0 == n)
+                break;
+            remaining -= n;
+
+            // Same layout, but a header that outlives this thread
+            batch.SetHeader(header);
+            callback(thread, index, batch);
+            index += n;
+        }
+    } catch (std::exception const& e)
+    {
+        state.Fail(e.what());
+    } catch (...)
+    {
+        state.Fail("ParallelReader: unknown error");
+    }
+}
+
+// Drops the index for callers of ForEachBatch
+void CallWithoutIndex(ParallelReader::BatchCallback const& callback,
+                      std::size_t thread,
+                      std::size_t /* index */,
+                      PointBuffer const& batch)
+{
+    callback(thread, batch);
+}
+
+} // namespace
+
+ParallelReader::ParallelReader(std::string const& filename, std::size_t nthreads)
+    : m_filename(filename)
+    , m_threads(nthreads)
+    , m_batch_size(4096)
+    , m_count(0)
+{
+    if (0 == m_threads)
+        throw configuration_error("ParallelReader: at least one thread is required");
+
+    std::ifstream ifs;
+    OpenStream(ifs, m_filename);
+
+    detail::reader::Header reader(ifs);
+    reader.ReadHeader();
+    m_header = *reader.GetHeader();
+
+    if (m_header.Compressed())
+        throw configuration_error("Compressed files are not readable with parallel reader");
+
+    // Never hand out ranges past the end of the file, even if the 
+    // header claims more points than the file actually holds.
+    ifs.clear();
+    ifs.seekg(0, std::ios::end);
+    std::streamoff const file_size = ifs.tellg();
+    std::streamoff const offset = m_header.GetDataOffset();
+
+    std::size_t available = 0;
+    if (file_size > offset)
+        available = static_cast<std::size_t>(file_size - offset) / m_header.GetDataRecordLength();
+
+    m_count = (std::min)(available, static_cast<std::size_t>(m_header.GetPointRecordsCount()));
+}
+
+void ParallelReader::SetBatchSize(std::size_t size)
+{
+    if (0 == size)
+        throw configuration_error("ParallelReader: batch size must be at least 1");
+    m_batch_size = size;
+}
+
+void ParallelReader::ForEachBatch(BatchCallback const& callback)
+{
+    ForEachBatchAt(boost::bind(&CallWithoutIndex, boost::cref(callback), _1, _2, _3));
+}
+
+void ParallelReader::ForEachBatchAt(IndexedBatchCallback const& callback)
+{
+    BatchState state;
+    std::size_t const per_thread = (m_count + m_threads - 1) / m_threads;
+
+    boost::thread_group threads;
+    for (std::size_t i = 0; i < m_threads; ++i)
+    {
+        std::size_t const first = i * per_thread;
+        if (first >= m_count)
+            break;
+
+        std::size_t const count = (std::min)(per_thread, m_count - first);
+        threads.create_thread(boost::bind(&ReadRange, 
+                                          boost::cref(m_filename),
+                                          &m_header,
+                                          i, first, count, m_batch_size,
+                                          boost::cref(callback),
+                                          boost::ref(state)));
+    }
+    threads.join_all();
+
+    if (state.failed)
+        throw std::runtime_error(state.error);
+}
+
+} // namespace liblas
@@ -40,24 +40,29 @@
  ****************************************************************************/
 
 #include <liblas/point.hpp>
+#include <liblas/dimensionaccessor.hpp>
 #include <liblas/header.hpp>
 #include <liblas/schema.hpp>
+#include <liblas/schemaconverter.hpp>
 #include <liblas/exception.hpp>
 #include <liblas/detail/binary.hpp>
 #include <liblas/detail/pointrecord.hpp>
 // boost
 #include <boost/array.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/tss.hpp>
 #include <liblas/external/property_tree/ptree.hpp>
 
 // std
 #include <cstring>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <iosfwd>
 #include <algorithm>
-#include <numeric>
+#include <functional>
 
 using namespace boost;
 
@@ -69,7 +74,6 @@ Point::Point()
     , m_default_header(DefaultHeader::get())
     
 {
-    m_data.resize(ePointSize3);
     m_data.assign(ePointSize3, 0);
 }
 
@@ -78,7 +82,6 @@ Point::Point(Header const* hdr)
      m_header(hdr)
     , m_default_header(DefaultHeader::get())
 {
-    m_data.resize(ePointSize3);
     m_data.assign(ePointSize3, 0);
 }
 
@@ -101,6 +104,12 @@ Point& Point::operator=(Point const& rhs)
     return *this;
 }
 
+void Point::swap(Point& other)
+{
+    m_data.swap(other.m_data);
+    std::swap(m_header, other.m_header);
+}
+
 void Point::SetCoordinates(double const& x, double const& y, double const& z)
 {
     SetX(x);
@@ -191,6 +200,46 @@ bool Point::IsValid() const
     return true;
 }
 
+namespace {
+
+// The converter used by the last Point::SetHeader call on this thread.  
+// Points are usually moved between the same two headers over and over, 
+// so the conversion plan is only rebuilt when the headers change.  The 
+// addresses alone are not enough, as a header can be freed and another 
+// one allocated in its place, so Matches compares the schemas as well.
+struct ConverterCache
+{
+    ConverterCache() : source(0), target(0) {}
+
+    Header const* source;
+    Header const* target;
+    boost::scoped_ptr<SchemaConverter> converter;
+};
+
+boost::thread_specific_ptr<ConverterCache> converter_cache;
+
+SchemaConverter const& GetConverter(Header const& source, Header const& target)
+{
+    ConverterCache* cache = converter_cache.get();
+    if (!cache)
+    {
+        cache = new ConverterCache;
+        converter_cache.reset(cache);
+    }
+
+    if (cache->source != &source || cache->target != &target || 
+        !cache->converter->Matches(source, target))
+    {
+        cache->converter.reset(new SchemaConverter(source, target));
+        cache->source = &source;
+        cache->target = &target;
+    }
+
+    return *cache->converter;
+}
+
+} // namespace
+
 void Point::SetHeader(Header const* header)
 {
 
@@ -203,101 +252,43 @@ void Point::SetHeader(Header const* header)
     // one we were given.
     if (!m_header) m_header = header;
 
+    boost::uint16_t const wanted_length = header->GetDataRecordLength();
+
     // This is hopefully faster than copying everything if we don't have 
     // any data set and nothing to worry about.
-    const liblas::Schema* schema;
-    boost::uint16_t wanted_length = header->GetDataRecordLength();
-    schema = &(header->GetSchema());
-    boost::uint32_t sum = std::accumulate(m_data.begin(), m_data.end(), 0);
-    
-    if (!sum) {
-        std::vector<boost::uint8_t> data;
-        data.resize(wanted_length);
-        data.assign(wanted_length, 0);
-        m_data = data;
+    PointData::const_iterator const nonzero = 
+        std::find_if(m_data.begin(), m_data.end(), 
+                     std::bind2nd(std::not_equal_to<boost::uint8_t>(), 0));
+    if (nonzero == m_data.end()) {
+        m_data.assign(wanted_length, 0);
         m_header = header;
         return;
     }
-    
-    bool bApplyNewScaling = true;
-    
-
-    
-    if (detail::compare_distance(header->GetScaleX(), m_header->GetScaleX()) &&
-        detail::compare_distance(header->GetScaleY(), m_header->GetScaleY()) &&
-        detail::compare_distance(header->GetScaleZ(), m_header->GetScaleZ()) &&
-        detail::compare_distance(header->GetOffsetX(), m_header->GetOffsetX()) &&
-        detail::compare_distance(header->GetOffsetY(), m_header->GetOffsetY()) &&
-        detail::compare_distance(header->GetOffsetZ(), m_header->GetOffsetZ()))
-        bApplyNewScaling = false;
-    else
-        bApplyNewScaling = true;
-
-
-    
-    if (wanted_length != m_data.size())
-    {
-        // Manually copy everything but the header ptr
-        // We can't just copy the raw data because its 
-        // layout is likely changing as a result of the 
-        // schema change.
-        Point p(*this);
-        m_header = header;
-
-        std::vector<boost::uint8_t> data;
-        data.resize(wanted_length);
-        data.assign(wanted_length, 0);
-        m_data = data;
-        m_header = header;
-    
-        SetX(p.GetX());
-        SetY(p.GetY());
-        SetZ(p.GetZ());
-        
-        SetIntensity(p.GetIntensity());
-        SetScanFlags(p.GetScanFlags());
-        SetClassification(p.GetClassification());
-        SetScanAngleRank(p.GetScanAngleRank());
-        SetUserData(p.GetUserData());
-        SetPointSourceID(p.GetPointSourceID());
-        
-        boost::optional< Dimension const& > t = schema->GetDimension("Time");
-        if (t)
-            SetTime(p.GetTime());
 
-        boost::optional< Dimension const& > c = schema->GetDimension("Red");
-        if (c)
-            SetColor(p.GetColor());
-
-        // FIXME: copy other custom dimensions here?  resetting the 
-        // headerptr can be catastrophic in a lot of cases.  
-    } 
-
-
-    // The header's scale/offset can change the raw storage of xyz.  
-    // SetHeader can result in a rescaling of the data.
-    double x;
-    double y;
-    double z;
-
-    if (bApplyNewScaling)
+    if (header == m_header)
     {
-        x = GetX();
-        y = GetY();
-        z = GetZ();        
+        // Same layout, so only the length of the data can be off.
+        if (wanted_length != m_data.size())
+            m_data.resize(wanted_length);
+        return;
     }
 
-    m_header = header;
+    // The new header may have a different layout, including custom 
+    // dimensions, and a different scale/offset for xyz.  Dimensions are 
+    // carried over by name and anything the old layout did not have 
+    // is zeroed.
+    SchemaConverter const& converter = GetConverter(*m_header, *header);
+    if (m_data.size() < converter.GetSourceRecordLength())
+        m_data.resize(converter.GetSourceRecordLength());
 
-    if (bApplyNewScaling)
-    {
-        SetX(x);
-        SetY(y);
-        SetZ(z);
-    }    
+    PointData data;
+    data.resize(wanted_length);
+    converter.Convert(&m_data.front(), &data.front(), 1);
 
-    
+    m_data.swap(data);
+    m_header = header;
 }
+
 Header const* Point::GetHeader() const
 {
     if (m_header) return m_header; else return &m_default_header;
@@ -952,7 +943,7 @@ void Point::SetColor(Color const& value)
     intToBits<boost::uint16_t>(value.GetBlue(), m_data, blue_pos);
 }
 
-std::vector<boost::uint8_t>::size_type Point::GetDimensionBytePosition(std::size_t dim_pos) const
+PointData::size_type Point::GetDimensionBytePosition(std::size_t dim_pos) const
 {
     boost::optional<Dimension const&> d;
     d = m_header->GetSchema().GetDimension(dim_pos);
@@ -968,10 +959,47 @@ std::vector<boost::uint8_t>::size_type Point::GetDimensionBytePosition(std::size
 
 boost::any Point::GetValue(Dimension const& d) const
 {
-    boost::any output;
-    boost::ignore_unused_variable_warning(d);
+    typedef detail::DimensionLayout layout_type;
+    layout_type const layout(d);
 
-    return output;
+    if (layout.byte_offset + layout.GetExtent() > m_data.size())
+    {
+        std::ostringstream msg;
+        msg << "GetValue: dimension '" << d.GetName() 
+            << "' lies outside of the point record";
+        throw std::out_of_range(msg.str());
+    }
+
+    boost::uint8_t const* data = &m_data.front();
+
+    switch (layout.kind)
+    {
+        case layout_type::eUInt8:
+        case layout_type::eBits:
+            return boost::any(DimensionAccessor<boost::uint8_t>(d).Get(data));
+        case layout_type::eInt8:
+            return boost::any(DimensionAccessor<boost::int8_t>(d).Get(data));
+        case layout_type::eUInt16:
+            return boost::any(DimensionAccessor<boost::uint16_t>(d).Get(data));
+        case layout_type::eInt16:
+            return boost::any(DimensionAccessor<boost::int16_t>(d).Get(data));
+        case layout_type::eUInt32:
+            return boost::any(DimensionAccessor<boost::uint32_t>(d).Get(data));
+        case layout_type::eInt32:
+            return boost::any(DimensionAccessor<boost::int32_t>(d).Get(data));
+        case layout_type::eUInt64:
+        case layout_type::eUnsigned:
+            return boost::any(DimensionAccessor<boost::uint64_t>(d).Get(data));
+        case layout_type::eInt64:
+        case layout_type::eSigned:
+            return boost::any(DimensionAccessor<boost::int64_t>(d).Get(data));
+        case layout_type::eFloat:
+            return boost::any(DimensionAccessor<float>(d).Get(data));
+        case layout_type::eDouble:
+            return boost::any(DimensionAccessor<double>(d).Get(data));
+    }
+
+    return boost::any();
 }
 
 } // namespace liblas
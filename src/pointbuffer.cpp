@@ -0,0 +1,231 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Contiguous buffer of LAS point records
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/pointbuffer.hpp>
+#include <liblas/header.hpp>
+#include <liblas/exception.hpp>
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring> // std::memcpy, std::memset
+
+namespace liblas {
+
+PointBuffer::PointBuffer()
+    : m_header(0)
+    , m_record_length(ePointSize3)
+    , m_size(0)
+{
+}
+
+PointBuffer::PointBuffer(Header const* header, std::size_t capacity)
+    : m_header(0)
+    , m_record_length(ePointSize3)
+    , m_size(0)
+{
+    SetHeader(header);
+    reserve(capacity);
+}
+
+PointBuffer::PointBuffer(PointBuffer const& other)
+    : m_data(other.m_data)
+    , m_header(other.m_header)
+    , m_record_length(other.m_record_length)
+    , m_size(other.m_size)
+{
+}
+
+PointBuffer& PointBuffer::operator=(PointBuffer const& rhs)
+{
+    if (&rhs != this)
+    {
+        m_data = rhs.m_data;
+        m_header = rhs.m_header;
+        m_record_length = rhs.m_record_length;
+        m_size = rhs.m_size;
+    }
+    return *this;
+}
+
+void PointBuffer::SetHeader(Header const* header)
+{
+    if (!header)
+    {
+        throw liblas_error("header reference for PointBuffer::SetHeader is void");
+    }
+
+    std::size_t const old_capacity = capacity();
+
+    m_header = header;
+    m_record_length = header->GetDataRecordLength();
+
+    // Keep the number of records we can hold stable across layout changes
+    reserve(old_capacity);
+    if (m_size > capacity())
+        m_size = capacity();
+}
+
+Header const* PointBuffer::GetHeader() const
+{
+    return m_header;
+}
+
+std::size_t PointBuffer::capacity() const
+{
+    return m_record_length ? m_data.size() / m_record_length : 0;
+}
+
+void PointBuffer::reserve(std::size_t n)
+{
+    if (n * m_record_length > m_data.size())
+        m_data.resize(n * m_record_length);
+}
+
+void PointBuffer::resize(std::size_t n)
+{
+    if (n > capacity())
+    {
+        // Grow geometrically so repeated AddPoint calls stay cheap
+        reserve((std::max)(n, 2 * capacity()));
+    }
+
+    if (n > m_size)
+    {
+        std::memset(GetRecord(m_size), 0, (n - m_size) * m_record_length);
+    }
+    m_size = n;
+}
+
+void PointBuffer::swap(PointBuffer& other)
+{
+    m_data.swap(other.m_data);
+    std::swap(m_header, other.m_header);
+    std::swap(m_record_length, other.m_record_length);
+    std::swap(m_size, other.m_size);
+}
+
+namespace {
+
+void copy_record(Header const* header, boost::uint8_t const* record, 
+                 std::size_t record_length, Point& p)
+{
+    PointData& data = p.GetData();
+    
+    if (p.GetHeader() != header && header)
+    {
+        // Zero the point first so SetHeader only resizes the data 
+        // instead of rescaling and copying values we are about to 
+        // overwrite anyway.
+        data.assign(data.size(), 0);
+        p.SetHeader(header);
+    }
+
+    if (data.size() != record_length)
+        data.resize(record_length);
+
+    std::memcpy(&data[0], record, record_length);
+}
+
+} // namespace
+
+void PointBuffer::GetPoint(std::size_t i, Point& p) const
+{
+    assert(i < m_size);
+
+    copy_record(m_header, GetRecord(i), m_record_length, p);
+}
+
+void PointBuffer::SetPoint(std::size_t i, Point const& p)
+{
+    assert(i < m_size);
+
+    PointData const& data = p.GetData();
+    std::size_t const n = (std::min)(data.size(), m_record_length);
+
+    boost::uint8_t* record = GetRecord(i);
+    std::memcpy(record, &data[0], n);
+    if (n < m_record_length)
+        std::memset(record + n, 0, m_record_length - n);
+}
+
+void PointBuffer::AddPoint(Point const& p)
+{
+    resize(m_size + 1);
+    SetPoint(m_size - 1, p);
+}
+
+PointSpan::PointSpan(PointBuffer const& buffer)
+    : m_header(buffer.GetHeader())
+    , m_data(buffer.empty() ? 0 : buffer.GetRecord(0))
+    , m_record_length(buffer.GetRecordLength())
+    , m_size(buffer.size())
+{
+}
+
+PointSpan::PointSpan(PointBuffer const& buffer, std::size_t first, std::size_t count)
+    : m_header(buffer.GetHeader())
+    , m_data(count ? buffer.GetRecord(first) : 0)
+    , m_record_length(buffer.GetRecordLength())
+    , m_size(count)
+{
+    assert(first + count <= buffer.size());
+}
+
+PointSpan::PointSpan(Header const* header, boost::uint8_t const* data, std::size_t count)
+    : m_header(header)
+    , m_data(data)
+    , m_record_length(header ? header->GetDataRecordLength() : 0)
+    , m_size(count)
+{
+    if (!header)
+    {
+        throw liblas_error("header reference for PointSpan is void");
+    }
+}
+
+void PointSpan::GetPoint(std::size_t i, Point& p) const
+{
+    assert(i < m_size);
+
+    copy_record(m_header, GetRecord(i), m_record_length, p);
+}
+
+} // namespace liblas
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Point record bytes with inline storage
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/pointdata.hpp>
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace liblas {
+
+PointData::PointData()
+    : m_begin(m_inline)
+    , m_size(0)
+    , m_capacity(inline_capacity)
+{
+}
+
+PointData::PointData(size_type n, value_type value)
+    : m_begin(m_inline)
+    , m_size(0)
+    , m_capacity(inline_capacity)
+{
+    assign(n, value);
+}
+
+PointData::PointData(std::vector<value_type> const& data)
+    : m_begin(m_inline)
+    , m_size(0)
+    , m_capacity(inline_capacity)
+{
+    assign(data.begin(), data.end());
+}
+
+PointData::PointData(PointData const& other)
+    : m_begin(m_inline)
+    , m_size(0)
+    , m_capacity(inline_capacity)
+{
+    Reserve(other.m_size, false);
+    if (other.m_size)
+        std::memcpy(m_begin, other.m_begin, other.m_size);
+    m_size = other.m_size;
+}
+
+PointData& PointData::operator=(PointData const& rhs)
+{
+    if (&rhs != this)
+    {
+        Reserve(rhs.m_size, false);
+        if (rhs.m_size)
+            std::memcpy(m_begin, rhs.m_begin, rhs.m_size);
+        m_size = rhs.m_size;
+    }
+    return *this;
+}
+
+PointData::~PointData()
+{
+    if (IsHeapAllocated())
+        delete [] m_begin;
+}
+
+PointData::reference PointData::at(size_type i)
+{
+    if (i >= m_size)
+        throw std::out_of_range("point data subscript out of range");
+    return m_begin[i];
+}
+
+PointData::const_reference PointData::at(size_type i) const
+{
+    if (i >= m_size)
+        throw std::out_of_range("point data subscript out of range");
+    return m_begin[i];
+}
+
+void PointData::resize(size_type n, value_type value)
+{
+    Reserve(n, true);
+    if (n > m_size)
+        std::memset(m_begin + m_size, value, n - m_size);
+    m_size = n;
+}
+
+void PointData::assign(size_type n, value_type value)
+{
+    Reserve(n, false);
+    if (n)
+        std::memset(m_begin, value, n);
+    m_size = n;
+}
+
+void PointData::swap(PointData& other)
+{
+    if (&other == this)
+        return;
+
+    if (IsHeapAllocated() && other.IsHeapAllocated())
+    {
+        std::swap(m_begin, other.m_begin);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        return;
+    }
+
+    if (!IsHeapAllocated() && !other.IsHeapAllocated())
+    {
+        value_type temp[inline_capacity];
+        std::memcpy(temp, m_inline, m_size);
+        std::memcpy(m_inline, other.m_inline, other.m_size);
+        std::memcpy(other.m_inline, temp, m_size);
+        std::swap(m_size, other.m_size);
+        return;
+    }
+
+    // One side is inline and the other on the heap: the heap buffer 
+    // moves over and the inline bytes are copied across.
+    PointData& heap = IsHeapAllocated() ? *this : other;
+    PointData& local = IsHeapAllocated() ? other : *this;
+
+    value_type* buffer = heap.m_begin;
+    size_type const size = heap.m_size;
+    size_type const capacity = heap.m_capacity;
+
+    std::memcpy(heap.m_inline, local.m_inline, local.m_size);
+    heap.m_begin = heap.m_inline;
+    heap.m_size = local.m_size;
+    heap.m_capacity = inline_capacity;
+
+    local.m_begin = buffer;
+    local.m_size = size;
+    local.m_capacity = capacity;
+}
+
+bool PointData::operator==(PointData const& other) const
+{
+    return m_size == other.m_size && 
+           (m_size == 0 || std::memcmp(m_begin, other.m_begin, m_size) == 0);
+}
+
+std::vector<PointData::value_type> PointData::ToVector() const
+{
+    return std::vector<value_type>(begin(), end());
+}
+
+void PointData::Reserve(size_type n, bool keep)
+{
+    if (n <= m_capacity)
+        return;
+
+    value_type* buffer = new value_type[n];
+    if (keep && m_size)
+        std::memcpy(buffer, m_begin, m_size);
+
+    if (IsHeapAllocated())
+        delete [] m_begin;
+
+    m_begin = buffer;
+    m_capacity = n;
+}
+
+} // namespace liblas
@@ -0,0 +1,358 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Columnar table of LAS point dimensions
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <liblas/pointtable.hpp>
+#include <liblas/header.hpp>
+#include <liblas/point.hpp>
+#include <liblas/reader.hpp>
+#include <liblas/writer.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/binary.hpp>
+#include <liblas/detail/private_utility.hpp>
+// std
+#include <algorithm>
+#include <cassert>
+#include <cstring> // std::memset
+#include <sstream>
+
+namespace liblas {
+
+namespace {
+
+// Standard record layout shared by point formats 0-3
+std::size_t const x_pos = 0;
+std::size_t const y_pos = 4;
+std::size_t const z_pos = 8;
+std::size_t const intensity_pos = 12;
+std::size_t const flags_pos = 14;
+std::size_t const classification_pos = 15;
+std::size_t const scan_angle_pos = 16;
+std::size_t const user_data_pos = 17;
+std::size_t const point_source_id_pos = 18;
+std::size_t const time_pos = 20;
+
+template <typename T>
+void decode_column(boost::uint8_t const* data, std::size_t stride, std::size_t count, T* out)
+{
+    using namespace liblas::detail::binary;
+
+    for (std::size_t i = 0; i < count; ++i, data += stride)
+    {
+        endian_value<T> value;
+        value.template load<little_endian_tag>(data);
+        out[i] = value;
+    }
+}
+
+template <typename T>
+void encode_value(T const& v, boost::uint8_t* record)
+{
+    using namespace liblas::detail::binary;
+
+    endian_value<T> value(v);
+    value.template store<little_endian_tag>(record);
+}
+
+void scale_column(boost::int32_t const* raw, double scale, double offset, std::size_t count, double* out)
+{
+    // Kept free of anything but arithmetic so the compiler can vectorize it
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = raw[i] * scale + offset;
+}
+
+} // namespace
+
+PointTable::PointTable()
+    : m_header(0)
+    , m_has_time(false)
+    , m_has_color(false)
+    , m_color_offset(0)
+{
+}
+
+PointTable::PointTable(Header const* header)
+    : m_header(0)
+    , m_has_time(false)
+    , m_has_color(false)
+    , m_color_offset(0)
+{
+    SetHeader(header);
+}
+
+void PointTable::SetHeader(Header const* header)
+{
+    if (!header)
+    {
+        throw liblas_error("header reference for PointTable::SetHeader is void");
+    }
+
+    clear();
+
+    m_header = header;
+
+    PointFormatName const f = header->GetDataFormatId();
+    m_has_time = (f == ePointFormat1 || f == ePointFormat3);
+    m_has_color = (f == ePointFormat2 || f == ePointFormat3);
+    m_color_offset = (f == ePointFormat3) ? time_pos + 8 : time_pos;
+}
+
+void PointTable::CheckHeader(Header const* header)
+{
+    if (!m_header)
+    {
+        SetHeader(header);
+        return;
+    }
+
+    if (header == m_header)
+        return;
+
+    if (header->GetDataFormatId() != m_header->GetDataFormatId() ||
+        !detail::compare_distance(header->GetScaleX(), m_header->GetScaleX()) ||
+        !detail::compare_distance(header->GetScaleY(), m_header->GetScaleY()) ||
+        !detail::compare_distance(header->GetScaleZ(), m_header->GetScaleZ()) ||
+        !detail::compare_distance(header->GetOffsetX(), m_header->GetOffsetX()) ||
+        !detail::compare_distance(header->GetOffsetY(), m_header->GetOffsetY()) ||
+        !detail::compare_distance(header->GetOffsetZ(), m_header->GetOffsetZ()))
+    {
+        std::ostringstream msg;
+        msg << "PointTable: points with format " << header->GetDataFormatId() 
+            << " and different scaling cannot be added to a table of format " 
+            << m_header->GetDataFormatId();
+        throw liblas_error(msg.str());
+    }
+}
+
+void PointTable::clear()
+{
+    Resize(0);
+}
+
+void PointTable::reserve(std::size_t n)
+{
+    m_raw_x.reserve(n);
+    m_raw_y.reserve(n);
+    m_raw_z.reserve(n);
+    m_x.reserve(n);
+    m_y.reserve(n);
+    m_z.reserve(n);
+    m_intensity.reserve(n);
+    m_flags.reserve(n);
+    m_classification.reserve(n);
+    m_scan_angle.reserve(n);
+    m_user_data.reserve(n);
+    m_point_source_id.reserve(n);
+
+    if (m_has_time)
+        m_time.reserve(n);
+
+    if (m_has_color)
+    {
+        m_red.reserve(n);
+        m_green.reserve(n);
+        m_blue.reserve(n);
+    }
+}
+
+void PointTable::Resize(std::size_t n)
+{
+    m_raw_x.resize(n);
+    m_raw_y.resize(n);
+    m_raw_z.resize(n);
+    m_x.resize(n);
+    m_y.resize(n);
+    m_z.resize(n);
+    m_intensity.resize(n);
+    m_flags.resize(n);
+    m_classification.resize(n);
+    m_scan_angle.resize(n);
+    m_user_data.resize(n);
+    m_point_source_id.resize(n);
+
+    m_time.resize(m_has_time ? n : 0);
+
+    std::size_t const ncolor = m_has_color ? n : 0;
+    m_red.resize(ncolor);
+    m_green.resize(ncolor);
+    m_blue.resize(ncolor);
+}
+
+void PointTable::Decode(boost::uint8_t const* data, std::size_t stride, 
+                        std::size_t first, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    decode_column(data + x_pos, stride, count, &m_raw_x[first]);
+    decode_column(data + y_pos, stride, count, &m_raw_y[first]);
+    decode_column(data + z_pos, stride, count, &m_raw_z[first]);
+    decode_column(data + intensity_pos, stride, count, &m_intensity[first]);
+    decode_column(data + flags_pos, stride, count, &m_flags[first]);
+    decode_column(data + classification_pos, stride, count, &m_classification[first]);
+    decode_column(data + scan_angle_pos, stride, count, &m_scan_angle[first]);
+    decode_column(data + user_data_pos, stride, count, &m_user_data[first]);
+    decode_column(data + point_source_id_pos, stride, count, &m_point_source_id[first]);
+
+    if (m_has_time)
+        decode_column(data + time_pos, stride, count, &m_time[first]);
+
+    if (m_has_color)
+    {
+        decode_column(data + m_color_offset, stride, count, &m_red[first]);
+        decode_column(data + m_color_offset + 2, stride, count, &m_green[first]);
+        decode_column(data + m_color_offset + 4, stride, count, &m_blue[first]);
+    }
+
+    Scale(first);
+}
+
+void PointTable::Scale(std::size_t first)
+{
+    std::size_t const count = size() - first;
+    if (count == 0)
+        return;
+
+    scale_column(&m_raw_x[first], m_header->GetScaleX(), m_header->GetOffsetX(), count, &m_x[first]);
+    scale_column(&m_raw_y[first], m_header->GetScaleY(), m_header->GetOffsetY(), count, &m_y[first]);
+    scale_column(&m_raw_z[first], m_header->GetScaleZ(), m_header->GetOffsetZ(), count, &m_z[first]);
+}
+
+void PointTable::EncodeRow(std::size_t i, boost::uint8_t* record) const
+{
+    assert(i < size());
+
+    encode_value(m_raw_x[i], record + x_pos);
+    encode_value(m_raw_y[i], record + y_pos);
+    encode_value(m_raw_z[i], record + z_pos);
+    encode_value(m_intensity[i], record + intensity_pos);
+    encode_value(m_flags[i], record + flags_pos);
+    encode_value(m_classification[i], record + classification_pos);
+    encode_value(m_scan_angle[i], record + scan_angle_pos);
+    encode_value(m_user_data[i], record + user_data_pos);
+    encode_value(m_point_source_id[i], record + point_source_id_pos);
+
+    if (m_has_time)
+        encode_value(m_time[i], record + time_pos);
+
+    if (m_has_color)
+    {
+        encode_value(m_red[i], record + m_color_offset);
+        encode_value(m_green[i], record + m_color_offset + 2);
+        encode_value(m_blue[i], record + m_color_offset + 4);
+    }
+}
+
+void PointTable::Append(PointBuffer const& buffer)
+{
+    if (buffer.empty())
+        return;
+
+    CheckHeader(buffer.GetHeader());
+
+    std::size_t const first = size();
+    Resize(first + buffer.size());
+    Decode(buffer.GetRecord(0), buffer.GetRecordLength(), first, buffer.size());
+}
+
+std::size_t PointTable::Read(Reader& reader, std::size_t n)
+{
+    std::size_t const count = reader.ReadNextPoints(m_buffer, n);
+    Append(m_buffer);
+    return count;
+}
+
+void PointTable::Encode(PointBuffer& buffer, std::size_t first, std::size_t count) const
+{
+    assert(first + count <= size());
+
+    buffer.SetHeader(m_header);
+    buffer.clear();
+    buffer.resize(count);
+    if (count > 0)
+        std::memset(buffer.GetRecord(0), 0, count * buffer.GetRecordLength());
+
+    for (std::size_t i = 0; i < count; ++i)
+        EncodeRow(first + i, buffer.GetRecord(i));
+}
+
+void PointTable::Write(Writer& writer) const
+{
+    if (empty())
+        return;
+
+    // Encode a block at a time so the records stay in cache and go to 
+    // the writer in one piece.
+    std::size_t const block_size = 65536;
+
+    PointBuffer buffer(m_header, (std::min)(size(), block_size));
+    for (std::size_t first = 0; first < size(); first += block_size)
+    {
+        Encode(buffer, first, (std::min)(block_size, size() - first));
+        writer.WritePoints(buffer);
+    }
+}
+
+void PointTable::GetPoint(std::size_t i, Point& p) const
+{
+    PointData& data = p.GetData();
+
+    if (p.GetHeader() != m_header)
+    {
+        // Zero the point first so SetHeader only resizes the data 
+        // instead of rescaling values we are about to overwrite.
+        data.assign(data.size(), 0);
+        p.SetHeader(m_header);
+    }
+
+    std::memset(&data[0], 0, data.size());
+    EncodeRow(i, &data[0]);
+}
+
+void PointTable::AddPoint(Point const& p)
+{
+    CheckHeader(p.GetHeader());
+
+    std::size_t const first = size();
+    Resize(first + 1);
+    Decode(&p.GetData()[0], p.GetData().size(), first, 1);
+}
+
+} // namespace liblas
@@ -44,6 +44,7 @@
 #include <liblas/reader.hpp>
 #include <liblas/detail/reader/reader.hpp>
 #include <liblas/detail/reader/cachedreader.hpp>
+#include <liblas/detail/reader/prefetchreader.hpp>
 #include <liblas/utility.hpp>
 
 // boost
@@ -123,6 +124,11 @@ bool Reader::ReadNextPoint()
     return false;
 }
 
+std::size_t Reader::ReadNextPoints(PointBuffer& buffer, std::size_t n)
+{
+    return m_pimpl->ReadNextPoints(buffer, n);
+}
+
 bool Reader::ReadPointAt(std::size_t n)
 {
     if (m_pimpl->GetHeader().GetPointRecordsCount() <= n)
@@ -141,6 +147,29 @@ bool Reader::ReadPointAt(std::size_t n)
     return false;
 }
 
+const std::size_t Reader::default_gap;
+
+bool Reader::ReadPointsAt(std::vector<boost::uint32_t> const& ids, PointBuffer& buffer, std::size_t gap)
+{
+    std::size_t const count = m_pimpl->GetHeader().GetPointRecordsCount();
+    std::vector<boost::uint32_t>::const_iterator i;
+    for (i = ids.begin(); i != ids.end(); ++i)
+    {
+        if (*i >= count)
+            throw std::out_of_range("point subscript out of range");
+    }
+
+    try
+    {
+        m_pimpl->ReadPointsAt(ids, buffer, gap);
+        return true;
+    }
+    catch (std::out_of_range const&)
+    {
+    }
+    return false;
+}
+
 bool Reader::Seek(std::size_t n)
 {
     try
@@ -203,5 +232,21 @@ std::vector<liblas::TransformPtr>  Reader::GetTransforms() const
     return m_pimpl->GetTransforms();
 }
 
+PrefetchStats Reader::GetPrefetchStats() const
+{
+    PrefetchStats stats;
+
+    detail::PrefetchReaderImpl const* prefetch = 
+        dynamic_cast<detail::PrefetchReaderImpl const*>(m_pimpl.get());
+    if (prefetch)
+    {
+        stats.blocks = prefetch->GetBlockCount();
+        stats.stalls = prefetch->GetStallCount();
+        stats.stall_time = prefetch->GetStallTime();
+        stats.idle_time = prefetch->GetIdleTime();
+    }
+    return stats;
+}
+
 } // namespace liblas
 
@@ -683,11 +683,12 @@ void Schema::CalculateSizes()
         Dimension t = (*i);
         m_bit_size += t.GetBitSize(); 
 
-        bit_offset = bit_offset + (t.GetBitSize() % 8);
-
+        // The bit offset is where this dimension starts within its byte
         t.SetByteOffset(byte_offset);
         t.SetBitOffset(bit_offset);
         position_index.replace(i, t);
+
+        bit_offset = bit_offset + (t.GetBitSize() % 8);
         
         // We don't increment if this dimension is within the current byte
         if ( bit_offset % 8 == 0)
@@ -0,0 +1,511 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Conversion of point records between schemas
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/schemaconverter.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/private_utility.hpp>
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+namespace liblas {
+
+namespace {
+
+int axis_of(std::string const& name)
+{
+    if (name == "X") return 0;
+    if (name == "Y") return 1;
+    if (name == "Z") return 2;
+    return -1;
+}
+
+// Nearest integer to value if value is within a rounding error of it.
+bool as_integer(double value, boost::int64_t& result)
+{
+    double const rounded = detail::sround(value);
+    if (std::fabs(value - rounded) > 1e-6 * (std::max)(1.0, std::fabs(value)))
+        return false;
+    if (std::fabs(rounded) > 2147483647.0 * 2147483647.0)
+        return false;
+    result = static_cast<boost::int64_t>(rounded);
+    return true;
+}
+
+// n / k rounded half away from zero, matching detail::sround.
+inline boost::int64_t round_divide(boost::int64_t n, boost::int64_t k)
+{
+    return n >= 0 ? (n + k / 2) / k : -((-n + k / 2) / k);
+}
+
+inline boost::int32_t load_raw(boost::uint8_t const* data)
+{
+    return detail::load_stored<boost::int32_t>(data);
+}
+
+inline void store_raw(boost::uint8_t* data, boost::int64_t value)
+{
+    detail::store_stored<boost::int32_t>(data, static_cast<boost::int32_t>(value));
+}
+
+} // namespace
+
+SchemaConverter::SchemaConverter(Header const& source, Header const& target)
+    : m_source_length(source.GetDataRecordLength())
+    , m_target_length(target.GetDataRecordLength())
+    , m_source_format(source.GetDataFormatId())
+    , m_target_format(target.GetDataFormatId())
+    , m_zero_fill(false)
+{
+    m_source_scale[0] = source.GetScaleX();
+    m_source_scale[1] = source.GetScaleY();
+    m_source_scale[2] = source.GetScaleZ();
+    m_source_offset[0] = source.GetOffsetX();
+    m_source_offset[1] = source.GetOffsetY();
+    m_source_offset[2] = source.GetOffsetZ();
+    m_target_scale[0] = target.GetScaleX();
+    m_target_scale[1] = target.GetScaleY();
+    m_target_scale[2] = target.GetScaleZ();
+    m_target_offset[0] = target.GetOffsetX();
+    m_target_offset[1] = target.GetOffsetY();
+    m_target_offset[2] = target.GetOffsetZ();
+
+    StoreLayout(source.GetSchema(), m_source_layout);
+    StoreLayout(target.GetSchema(), m_target_layout);
+
+    Compile(source.GetSchema(), target.GetSchema(), 
+            m_source_scale, m_source_offset, 
+            m_target_scale, m_target_offset);
+}
+
+SchemaConverter::SchemaConverter(Schema const& source, Schema const& target)
+    : m_source_length(source.GetByteSize())
+    , m_target_length(target.GetByteSize())
+    , m_source_format(source.GetDataFormatId())
+    , m_target_format(target.GetDataFormatId())
+    , m_zero_fill(false)
+{
+    std::fill(m_source_scale, m_source_scale + 3, 0.0);
+    std::fill(m_source_offset, m_source_offset + 3, 0.0);
+    std::fill(m_target_scale, m_target_scale + 3, 0.0);
+    std::fill(m_target_offset, m_target_offset + 3, 0.0);
+
+    StoreLayout(source, m_source_layout);
+    StoreLayout(target, m_target_layout);
+
+    Compile(source, target, 0, 0, 0, 0);
+}
+
+SchemaConverter::DimensionKey::DimensionKey(Dimension const& d)
+    : name(d.GetName())
+    , byte_offset(d.GetByteOffset())
+    , bit_offset(d.GetBitOffset())
+    , bit_size(d.GetBitSize())
+    , numeric(d.IsNumeric())
+    , is_signed(d.IsSigned())
+    , integer(d.IsInteger())
+{
+}
+
+bool SchemaConverter::DimensionKey::Matches(Dimension const& d) const
+{
+    return byte_offset == d.GetByteOffset() &&
+           bit_offset == d.GetBitOffset() &&
+           bit_size == d.GetBitSize() &&
+           numeric == d.IsNumeric() &&
+           is_signed == d.IsSigned() &&
+           integer == d.IsInteger() &&
+           name == d.GetName();
+}
+
+void SchemaConverter::StoreLayout(Schema const& schema, std::vector<DimensionKey>& layout)
+{
+    index_by_position const& dims = schema.GetDimensions().get<position>();
+    layout.clear();
+    layout.reserve(dims.size());
+    for (index_by_position::const_iterator i = dims.begin(); i != dims.end(); ++i)
+        layout.push_back(DimensionKey(*i));
+}
+
+bool SchemaConverter::SameLayout(std::vector<DimensionKey> const& layout, Schema const& schema)
+{
+    index_by_position const& dims = schema.GetDimensions().get<position>();
+    if (dims.size() != layout.size())
+        return false;
+
+    std::vector<DimensionKey>::const_iterator k = layout.begin();
+    for (index_by_position::const_iterator i = dims.begin(); i != dims.end(); ++i, ++k)
+    {
+        if (!k->Matches(*i))
+            return false;
+    }
+    return true;
+}
+
+bool SchemaConverter::IsIdentity() const
+{
+    return m_source_length == m_target_length && 
+           !m_zero_fill &&
+           m_copies.size() == 1 &&
+           m_copies[0].source == 0 && 
+           m_copies[0].target == 0 &&
+           m_copies[0].size == m_target_length &&
+           m_masks.empty() && m_scales.empty() && 
+           m_integers.empty() && m_reals.empty();
+}
+
+bool SchemaConverter::Matches(Header const& source, Header const& target) const
+{
+    return m_source_length == source.GetDataRecordLength() &&
+           m_target_length == target.GetDataRecordLength() &&
+           m_source_format == source.GetDataFormatId() &&
+           m_target_format == target.GetDataFormatId() &&
+           m_source_scale[0] == source.GetScaleX() &&
+           m_source_scale[1] == source.GetScaleY() &&
+           m_source_scale[2] == source.GetScaleZ() &&
+           m_source_offset[0] == source.GetOffsetX() &&
+           m_source_offset[1] == source.GetOffsetY() &&
+           m_source_offset[2] == source.GetOffsetZ() &&
+           m_target_scale[0] == target.GetScaleX() &&
+           m_target_scale[1] == target.GetScaleY() &&
+           m_target_scale[2] == target.GetScaleZ() &&
+           m_target_offset[0] == target.GetOffsetX() &&
+           m_target_offset[1] == target.GetOffsetY() &&
+           m_target_offset[2] == target.GetOffsetZ() &&
+           SameLayout(m_source_layout, source.GetSchema()) &&
+           SameLayout(m_target_layout, target.GetSchema());
+}
+
+void SchemaConverter::Compile(Schema const& source, Schema const& target, 
+                              double const* source_scale, double const* source_offset,
+                              double const* target_scale, double const* target_offset)
+{
+    using detail::DimensionLayout;
+
+    // Bits of each target byte that some step writes.
+    std::vector<boost::uint8_t> covered(m_target_length, 0);
+
+    index_by_position const& dims = target.GetDimensions().get<position>();
+    for (index_by_position::const_iterator i = dims.begin(); i != dims.end(); ++i)
+    {
+        Dimension const& to = *i;
+        boost::optional< Dimension const& > found = source.GetDimension(to.GetName());
+        if (!found)
+            continue;
+        Dimension const& from = *found;
+
+        bool const bit_aligned = from.GetBitSize() % 8 == 0 && 
+                                 to.GetBitSize() % 8 == 0 &&
+                                 from.GetBitOffset() == 0 && 
+                                 to.GetBitOffset() == 0;
+
+        std::size_t const to_bytes = to.GetBitSize() / 8;
+        if (bit_aligned && 
+            (from.GetByteOffset() + from.GetBitSize() / 8 > m_source_length ||
+             to.GetByteOffset() + to_bytes > m_target_length))
+        {
+            std::ostringstream oss;
+            oss << "dimension '" << to.GetName() << "' lies outside of the point record";
+            throw liblas_error(oss.str());
+        }
+
+        int const axis = axis_of(to.GetName());
+        if (axis >= 0 && source_scale && 
+            from.GetBitSize() == 32 && to.GetBitSize() == 32 && bit_aligned)
+        {
+            AddScale(from, to, 
+                     source_scale[axis], source_offset[axis],
+                     target_scale[axis], target_offset[axis]);
+            std::fill(covered.begin() + to.GetByteOffset(), 
+                      covered.begin() + to.GetByteOffset() + 4, 0xFF);
+            continue;
+        }
+
+        if (bit_aligned && from.GetBitSize() == to.GetBitSize() &&
+            from.IsNumeric() == to.IsNumeric() &&
+            from.IsInteger() == to.IsInteger() &&
+            from.IsSigned() == to.IsSigned())
+        {
+            AddCopy(from.GetByteOffset(), to.GetByteOffset(), to_bytes);
+            std::fill(covered.begin() + to.GetByteOffset(), 
+                      covered.begin() + to.GetByteOffset() + to_bytes, 0xFF);
+            continue;
+        }
+
+        if (!from.IsNumeric() || !to.IsNumeric())
+        {
+            // Raw bytes of different widths: keep what fits.
+            if (bit_aligned)
+            {
+                std::size_t const n = (std::min)(from.GetBitSize(), to.GetBitSize()) / 8;
+                AddCopy(from.GetByteOffset(), to.GetByteOffset(), n);
+                std::fill(covered.begin() + to.GetByteOffset(), 
+                          covered.begin() + to.GetByteOffset() + n, 0xFF);
+            }
+            continue;
+        }
+
+        DimensionLayout const from_layout(from);
+        DimensionLayout const to_layout(to);
+        if (from_layout.byte_offset + from_layout.GetExtent() > m_source_length ||
+            to_layout.byte_offset + to_layout.GetExtent() > m_target_length)
+        {
+            std::ostringstream oss;
+            oss << "dimension '" << to.GetName() << "' lies outside of the point record";
+            throw liblas_error(oss.str());
+        }
+
+        if (from_layout.kind == DimensionLayout::eBits && 
+            to_layout.kind == DimensionLayout::eBits &&
+            from_layout.mask == to_layout.mask)
+        {
+            AddBits(from_layout, to_layout);
+            covered[to_layout.byte_offset] |= 
+                static_cast<boost::uint8_t>(to_layout.mask << to_layout.shift);
+            continue;
+        }
+
+        if (to_layout.kind == DimensionLayout::eBits)
+        {
+            // Read-modify-write of a partial byte, which needs the rest 
+            // of the byte to start out zeroed.
+            m_integers.push_back(IntegerStep(DimensionAccessor<boost::int64_t>(from), 
+                                             DimensionAccessor<boost::int64_t>(to)));
+            continue;
+        }
+
+        if (from.IsInteger() && to.IsInteger())
+            m_integers.push_back(IntegerStep(DimensionAccessor<boost::int64_t>(from), 
+                                             DimensionAccessor<boost::int64_t>(to)));
+        else
+            m_reals.push_back(RealStep(DimensionAccessor<double>(from), 
+                                       DimensionAccessor<double>(to)));
+
+        std::fill(covered.begin() + to_layout.byte_offset, 
+                  covered.begin() + to_layout.byte_offset + to_layout.GetExtent(), 0xFF);
+    }
+
+    // Masks that end up covering a whole byte unchanged are byte copies.
+    std::vector<MaskStep> masks;
+    masks.swap(m_masks);
+    for (std::vector<MaskStep>::const_iterator i = masks.begin(); i != masks.end(); ++i)
+    {
+        if (i->mask == 0xFF && i->shift == 0)
+            AddCopy(i->source, i->target, 1);
+        else
+            m_masks.push_back(*i);
+    }
+
+    // Merge copies that are adjacent in both records.
+    std::vector<CopyStep> copies;
+    copies.swap(m_copies);
+    std::sort(copies.begin(), copies.end());
+    for (std::vector<CopyStep>::const_iterator i = copies.begin(); i != copies.end(); ++i)
+    {
+        if (!m_copies.empty() && 
+            m_copies.back().source + m_copies.back().size == i->source &&
+            m_copies.back().target + m_copies.back().size == i->target)
+        {
+            m_copies.back().size += i->size;
+        }
+        else
+        {
+            m_copies.push_back(*i);
+        }
+    }
+
+    m_zero_fill = std::find_if(covered.begin(), covered.end(), 
+                               std::bind2nd(std::not_equal_to<boost::uint8_t>(), 0xFF)) != covered.end();
+}
+
+void SchemaConverter::AddCopy(std::size_t source, std::size_t target, std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    CopyStep step;
+    step.source = source;
+    step.target = target;
+    step.size = size;
+    m_copies.push_back(step);
+}
+
+void SchemaConverter::AddBits(detail::DimensionLayout const& source, 
+                              detail::DimensionLayout const& target)
+{
+    int const shift = static_cast<int>(source.shift) - static_cast<int>(target.shift);
+    boost::uint8_t const mask = static_cast<boost::uint8_t>(target.mask << target.shift);
+
+    for (std::vector<MaskStep>::iterator i = m_masks.begin(); i != m_masks.end(); ++i)
+    {
+        if (i->source == source.byte_offset && 
+            i->target == target.byte_offset && 
+            i->shift == shift)
+        {
+            i->mask |= mask;
+            return;
+        }
+    }
+
+    MaskStep step;
+    step.source = source.byte_offset;
+    step.target = target.byte_offset;
+    step.shift = shift;
+    step.mask = mask;
+    m_masks.push_back(step);
+}
+
+void SchemaConverter::AddScale(Dimension const& source, Dimension const& target, 
+                               double source_scale, double source_offset,
+                               double target_scale, double target_offset)
+{
+    ScaleStep step;
+    step.source = source.GetByteOffset();
+    step.target = target.GetByteOffset();
+    step.mode = ScaleStep::eReal;
+    step.factor = 1;
+    step.delta = 0;
+    step.source_scale = source_scale;
+    step.source_offset = source_offset;
+    step.target_scale = target_scale;
+    step.target_offset = target_offset;
+
+    boost::int64_t factor = 0;
+    boost::int64_t delta = 0;
+    if (as_integer(source_scale / target_scale, factor) && factor >= 1 &&
+        as_integer((source_offset - target_offset) / target_scale, delta))
+    {
+        // target = source * factor + delta
+        if (factor == 1 && delta == 0)
+        {
+            AddCopy(step.source, step.target, 4);
+            return;
+        }
+        step.mode = ScaleStep::eMultiply;
+    }
+    else if (as_integer(target_scale / source_scale, factor) && factor >= 2 &&
+             as_integer((source_offset - target_offset) / source_scale, delta))
+    {
+        // target = round((source + delta) / factor)
+        step.mode = ScaleStep::eDivide;
+    }
+
+    step.factor = factor;
+    step.delta = delta;
+    m_scales.push_back(step);
+}
+
+void SchemaConverter::Convert(boost::uint8_t const* source, 
+                              boost::uint8_t* target, 
+                              std::size_t count) const
+{
+    for (std::size_t n = 0; n < count; ++n, source += m_source_length, target += m_target_length)
+    {
+        if (m_zero_fill)
+            std::memset(target, 0, m_target_length);
+
+        for (std::vector<CopyStep>::const_iterator i = m_copies.begin(); i != m_copies.end(); ++i)
+            std::memcpy(target + i->target, source + i->source, i->size);
+
+        for (std::vector<MaskStep>::const_iterator i = m_masks.begin(); i != m_masks.end(); ++i)
+        {
+            unsigned int const bits = source[i->source];
+            unsigned int const moved = i->shift >= 0 ? bits >> i->shift : bits << -i->shift;
+            target[i->target] = static_cast<boost::uint8_t>(
+                (target[i->target] & ~i->mask) | (moved & i->mask));
+        }
+
+        for (std::vector<ScaleStep>::const_iterator i = m_scales.begin(); i != m_scales.end(); ++i)
+        {
+            boost::int64_t const raw = load_raw(source + i->source);
+            switch (i->mode)
+            {
+                case ScaleStep::eMultiply:
+                    store_raw(target + i->target, raw * i->factor + i->delta);
+                    break;
+                case ScaleStep::eDivide:
+                    store_raw(target + i->target, round_divide(raw + i->delta, i->factor));
+                    break;
+                case ScaleStep::eReal:
+                {
+                    double const value = raw * i->source_scale + i->source_offset;
+                    store_raw(target + i->target, static_cast<boost::int64_t>(
+                        detail::sround((value - i->target_offset) / i->target_scale)));
+                    break;
+                }
+            }
+        }
+
+        for (std::vector<IntegerStep>::const_iterator i = m_integers.begin(); i != m_integers.end(); ++i)
+            i->second.Set(target, i->first.Get(source));
+
+        for (std::vector<RealStep>::const_iterator i = m_reals.begin(); i != m_reals.end(); ++i)
+            i->second.Set(target, i->first.Get(source));
+    }
+}
+
+void SchemaConverter::Convert(PointSpan const& source, PointBuffer& target) const
+{
+    if (!target.GetHeader())
+        throw liblas_error("SchemaConverter::Convert: target buffer has no header");
+
+    if (target.GetRecordLength() != m_target_length || 
+        source.GetRecordLength() != m_source_length)
+    {
+        std::ostringstream oss;
+        oss << "SchemaConverter::Convert: converter is for " << m_source_length 
+            << " to " << m_target_length << " byte records, not " 
+            << source.GetRecordLength() << " to " << target.GetRecordLength();
+        throw liblas_error(oss.str());
+    }
+
+    target.resize(source.size());
+    if (source.empty())
+        return;
+
+    Convert(source.GetRecord(0), target.GetRecord(0), source.size());
+}
+
+} // namespace liblas
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Point page cache shared between readers and threads
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/sharedpagecache.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/detail/reader/pagecache.hpp>
+// std
+#include <algorithm>
+
+namespace liblas {
+
+const std::size_t SharedPageCache::default_budget;
+const std::size_t SharedPageCache::default_stripes;
+
+SharedPageCache::Stats::Stats()
+    : hits(0)
+    , misses(0)
+    , evictions(0)
+    , bytes_served(0)
+    , pages(0)
+    , bytes(0)
+    , budget(0)
+{
+}
+
+double SharedPageCache::Stats::GetHitRatio() const
+{
+    boost::uint64_t const lookups = hits + misses;
+    if (0 == lookups)
+        return 0.0;
+    return static_cast<double>(hits) / static_cast<double>(lookups);
+}
+
+SharedPageCache::Stripe::Stripe(std::size_t budget)
+    : cache(new detail::PageCache(budget))
+{
+}
+
+SharedPageCache::SharedPageCache()
+    : m_budget(0)
+{
+    Initialize(default_budget, default_stripes);
+}
+
+SharedPageCache::SharedPageCache(std::size_t budget, std::size_t stripes)
+    : m_budget(0)
+{
+    Initialize(budget, stripes);
+}
+
+SharedPageCache::~SharedPageCache()
+{
+}
+
+void SharedPageCache::Initialize(std::size_t budget, std::size_t stripes)
+{
+    if (0 == stripes)
+        throw configuration_error("SharedPageCache: stripe count must be at least 1");
+
+    m_budget = budget;
+    std::size_t const share = budget ? (std::max)(std::size_t(1), budget / stripes) : 0;
+    for (std::size_t i = 0; i < stripes; ++i)
+        m_stripes.push_back(StripePtr(new Stripe(share)));
+}
+
+boost::uint64_t SharedPageCache::GetFileId(std::string const& identity)
+{
+    boost::mutex::scoped_lock lock(m_files_mutex);
+
+    std::map<std::string, boost::uint64_t>::const_iterator i = m_files.find(identity);
+    if (i != m_files.end())
+        return i->second;
+
+    boost::uint64_t const id = m_files.size();
+    m_files.insert(std::make_pair(identity, id));
+    return id;
+}
+
+SharedPageCache::Stripe& SharedPageCache::GetStripe(boost::uint64_t file, std::size_t page) const
+{
+    // Consecutive pages of a file land on different stripes, so readers 
+    // streaming through the same file don't queue up on one lock.
+    boost::uint64_t const h = file * 2654435761u + page;
+    return *m_stripes[static_cast<std::size_t>(h % m_stripes.size())];
+}
+
+SharedPageCache::PagePtr SharedPageCache::Find(boost::uint64_t file, std::size_t page)
+{
+    Stripe& stripe = GetStripe(file, page);
+    boost::mutex::scoped_lock lock(stripe.mutex);
+    return stripe.cache->Find(detail::PageKey(file, page));
+}
+
+void SharedPageCache::Insert(boost::uint64_t file, std::size_t page, PagePtr data)
+{
+    Stripe& stripe = GetStripe(file, page);
+    boost::mutex::scoped_lock lock(stripe.mutex);
+    stripe.cache->Insert(detail::PageKey(file, page), data);
+}
+
+void SharedPageCache::Clear()
+{
+    for (std::size_t i = 0; i < m_stripes.size(); ++i)
+    {
+        boost::mutex::scoped_lock lock(m_stripes[i]->mutex);
+        m_stripes[i]->cache->Clear();
+    }
+}
+
+std::size_t SharedPageCache::GetBudget() const
+{
+    boost::mutex::scoped_lock lock(m_files_mutex);
+    return m_budget;
+}
+
+void SharedPageCache::SetBudget(std::size_t budget)
+{
+    {
+        boost::mutex::scoped_lock lock(m_files_mutex);
+        m_budget = budget;
+    }
+
+    std::size_t const share = budget ? (std::max)(std::size_t(1), budget / m_stripes.size()) : 0;
+    for (std::size_t i = 0; i < m_stripes.size(); ++i)
+    {
+        boost::mutex::scoped_lock lock(m_stripes[i]->mutex);
+        m_stripes[i]->cache->SetBudget(share);
+    }
+}
+
+SharedPageCache::Stats SharedPageCache::GetStats() const
+{
+    Stats stats;
+    stats.budget = GetBudget();
+
+    for (std::size_t i = 0; i < m_stripes.size(); ++i)
+    {
+        boost::mutex::scoped_lock lock(m_stripes[i]->mutex);
+        detail::PageCache const& cache = *m_stripes[i]->cache;
+
+        stats.hits += cache.GetHitCount();
+        stats.misses += cache.GetMissCount();
+        stats.evictions += cache.GetEvictionCount();
+        stats.bytes_served += cache.GetBytesServed();
+        stats.pages += cache.GetPageCount();
+        stats.bytes += cache.GetByteCount();
+    }
+    return stats;
+}
+
+} // namespace liblas
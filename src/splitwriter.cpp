@@ -0,0 +1,201 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  libLAS - http://liblas.org - A BSD library for LAS format data.
+ * Purpose:  Writing points to a series of files of bounded size
+ * Author:   libLAS development team
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, libLAS development team
+ *
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following 
+ * conditions are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright 
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright 
+ *       notice, this list of conditions and the following disclaimer in 
+ *       the documentation and/or other materials provided 
+ *       with the distribution.
+ *     * Neither the name of the Martin Isenburg or Iowa Department 
+ *       of Natural Resources nor the names of its contributors may be 
+ *       used to endorse or promote products derived from this software 
+ *       without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS 
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE 
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, 
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS 
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+
+#include <liblas/splitwriter.hpp>
+#include <liblas/exception.hpp>
+#include <liblas/factory.hpp>
+// boost
+#include <boost/cstdint.hpp>
+// std
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring> // std::memcpy
+
+namespace liblas {
+
+namespace {
+
+// Records waiting to be written, shared by all open parts
+std::size_t const queue_budget = 64 * 1024 * 1024;
+
+} // namespace
+
+SplitWriter::SplitWriter(std::string const& prefix, 
+                         std::string const& extension, 
+                         Header const& header, 
+                         boost::uint32_t part_size)
+    : m_prefix(prefix)
+    , m_extension(extension)
+    , m_header(header)
+    , m_part_size(part_size)
+    , m_encode_threads(1)
+    , m_chunk_summaries(false)
+    , m_open_parts(4)
+    , m_part_count(0)
+    , m_part_points(0)
+    , m_closed(false)
+{
+    if (0 == m_part_size)
+        throw configuration_error("SplitWriter: parts must hold at least 1 point");
+}
+
+SplitWriter::~SplitWriter()
+{
+    try
+    {
+        Close();
+    } catch (std::runtime_error const&)
+    {
+    }
+}
+
+void SplitWriter::SetEncodeThreads(std::size_t threads)
+{
+    if (0 == threads)
+        throw configuration_error("SplitWriter: encode thread count must be at least 1");
+    m_encode_threads = threads;
+}
+
+void SplitWriter::SetOpenParts(std::size_t parts)
+{
+    if (0 == parts)
+        throw configuration_error("SplitWriter: at least one part must be open");
+    m_open_parts = parts;
+}
+
+void SplitWriter::StartPart()
+{
+    while (m_parts.size() >= m_open_parts)
+        FinishPart();
+
+    std::ostringstream name;
+    name << m_prefix << "-" << m_part_count + 1 << m_extension;
+
+    Part part;
+    std::ofstream* ofs = new std::ofstream(name.str().c_str(), std::ios::out | std::ios::binary);
+    part.ofs.reset(ofs);
+    if (!ofs->is_open())
+    {
+        std::ostringstream msg;
+        msg << "SplitWriter: unable to open file '" << name.str() << "' for writing";
+        throw std::runtime_error(msg.str());
+    }
+
+    WriterIPtr w = WriterFactory::CreateWithStream(*ofs, m_header, m_encode_threads, m_chunk_summaries);
+    part.writer.reset(new Writer(WriterFactory::CreateAsync(w, queue_budget / m_open_parts)));
+    part.writer->SetHeader(m_header);
+    part.writer->WriteHeader();
+
+    m_parts.push_back(part);
+    ++m_part_count;
+    m_part_points = 0;
+}
+
+void SplitWriter::FinishPart()
+{
+    // The writer goes before its stream, and fills in the header's 
+    // bounds on its way out.
+    Part part = m_parts.front();
+    m_parts.pop_front();
+    part.writer->Flush();
+}
+
+Writer& SplitWriter::GetWriter()
+{
+    if (m_closed)
+        throw std::runtime_error("SplitWriter: the writer has been closed");
+
+    if (m_parts.empty() || m_part_points == m_part_size)
+        StartPart();
+
+    return *m_parts.back().writer;
+}
+
+void SplitWriter::WritePoint(Point const& point)
+{
+    GetWriter().WritePoint(point);
+    ++m_part_points;
+}
+
+void SplitWriter::WritePoints(PointBuffer const& buffer)
+{
+    std::size_t first = 0;
+    while (first < buffer.size())
+    {
+        Writer& writer = GetWriter();
+        std::size_t const n = (std::min)(buffer.size() - first, 
+                                         static_cast<std::size_t>(m_part_size - m_part_points));
+
+        if (0 == first && n == buffer.size())
+        {
+            writer.WritePoints(buffer);
+        }
+        else
+        {
+            // The buffer straddles parts
+            m_slice.SetHeader(buffer.GetHeader());
+            m_slice.resize(n);
+            std::memcpy(m_slice.GetRecord(0), buffer.GetRecord(first), n * buffer.GetRecordLength());
+            writer.WritePoints(m_slice);
+        }
+
+        m_part_points += static_cast<boost::uint32_t>(n);
+        first += n;
+    }
+}
+
+void SplitWriter::Close()
+{
+    if (m_closed)
+        return;
+
+    if (0 == m_part_count)
+        StartPart();
+
+    m_closed = true;
+    while (!m_parts.empty())
+        FinishPart();
+}
+
+} // namespace liblas
@@ -77,7 +77,7 @@ Summary::Summary(Summary const& other)
     , points_by_return(other.points_by_return)
     , returns_of_given_pulse(other.returns_of_given_pulse)
     , first(other.first)
-    , minimum(other.maximum)
+    , minimum(other.minimum)
     , maximum(other.maximum)
     , m_header(other.m_header)
     , bHaveHeader(other.bHaveHeader)
@@ -159,6 +159,22 @@ void Summary::AddPoint(liblas::Point const& p)
             first = false;
         }
         
+        UpdateExtremes(p);
+
+        liblas::Classification const& cls = p.GetClassification();
+
+        classes[cls.GetClass()]++;
+        
+        if (cls.IsWithheld()) withheld++;
+        if (cls.IsKeyPoint()) keypoint++;
+        if (cls.IsSynthetic()) synthetic++;
+
+        points_by_return[p.GetReturnNumber()]++;
+        returns_of_given_pulse[p.GetNumberOfReturns()]++;    
+}
+
+void Summary::UpdateExtremes(liblas::Point const& p)
+{
         if (p.GetRawX() < minimum.GetRawX() )
             minimum.SetRawX(p.GetRawX());
         if (p.GetRawX() > maximum.GetRawX() )
@@ -230,12 +246,6 @@ void Summary::AddPoint(liblas::Point const& p)
         boost::uint8_t minc = (std::min)(cls.GetClass(), minimum.GetClassification().GetClass());
         boost::uint8_t maxc = (std::max)(cls.GetClass(), maximum.GetClassification().GetClass());
         
-        classes[cls.GetClass()]++;
-        
-        if (cls.IsWithheld()) withheld++;
-        if (cls.IsKeyPoint()) keypoint++;
-        if (cls.IsSynthetic()) synthetic++;
-        
         if (minc < minimum.GetClassification().GetClass())
             minimum.SetClassification(liblas::Classification(minc));
         if (maxc > maximum.GetClassification().GetClass())
@@ -298,10 +308,6 @@ void Summary::AddPoint(liblas::Point const& p)
                                             max_green, 
                                             max_blue));
         }
-        
-
-        points_by_return[p.GetReturnNumber()]++;
-        returns_of_given_pulse[p.GetNumberOfReturns()]++;    
 }
 
 void Summary::SetHeader(liblas::Header const& h) 
@@ -312,6 +318,42 @@ void Summary::SetHeader(liblas::Header const& h)
     bHaveHeader = true;
 }
 
+void Summary::Merge(Summary const& other)
+{
+    if (other.first)
+        return;
+
+    if (first)
+    {
+        *this = other;
+
+        // Keep min/max pointing at our own copy of the header
+        if (bHaveHeader)
+        {
+            minimum.SetHeader(&m_header);
+            maximum.SetHeader(&m_header);
+        }
+        return;
+    }
+
+    for (classes_type::size_type i = 0; i < classes.size(); ++i)
+        classes[i] += other.classes[i];
+
+    for (boost::array<boost::uint32_t,8>::size_type i = 0; i < points_by_return.size(); ++i)
+    {
+        points_by_return[i] += other.points_by_return[i];
+        returns_of_given_pulse[i] += other.returns_of_given_pulse[i];
+    }
+
+    synthetic += other.synthetic;
+    withheld += other.withheld;
+    keypoint += other.keypoint;
+    count += other.count;
+
+    UpdateExtremes(other.minimum);
+    UpdateExtremes(other.maximum);
+}
+
 bool Summary::filter(liblas::Point const& p)
 {
     AddPoint(p);
@@ -673,6 +715,48 @@ void CoordinateSummary::SetHeader(liblas::Header const& h)
     bHaveHeader = true;
 }
 
+void CoordinateSummary::Merge(CoordinateSummary const& other)
+{
+    if (other.first)
+        return;
+
+    if (first)
+    {
+        *this = other;
+
+        // Keep min/max pointing at our own copy of the header
+        if (bHaveHeader)
+        {
+            minimum.SetHeader(&m_header);
+            maximum.SetHeader(&m_header);
+        }
+        return;
+    }
+
+    for (boost::array<boost::uint32_t,8>::size_type i = 0; i < points_by_return.size(); ++i)
+    {
+        points_by_return[i] += other.points_by_return[i];
+        returns_of_given_pulse[i] += other.returns_of_given_pulse[i];
+    }
+
+    count += other.count;
+
+    if (other.minimum.GetRawX() < minimum.GetRawX() )
+        minimum.SetRawX(other.minimum.GetRawX());
+    if (other.maximum.GetRawX() > maximum.GetRawX() )
+        maximum.SetRawX(other.maximum.GetRawX());
+
+    if (other.minimum.GetRawY() < minimum.GetRawY() )
+        minimum.SetRawY(other.minimum.GetRawY());
+    if (other.maximum.GetRawY() > maximum.GetRawY() )
+        maximum.SetRawY(other.maximum.GetRawY());
+
+    if (other.minimum.GetRawZ() < minimum.GetRawZ() )
+        minimum.SetRawZ(other.minimum.GetRawZ());
+    if (other.maximum.GetRawZ() > maximum.GetRawZ() )
+        maximum.SetRawZ(other.maximum.GetRawZ());
+}
+
 ptree CoordinateSummary::GetPTree() const
 {
     ptree pt;
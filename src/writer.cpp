@@ -41,6 +41,7 @@
 
 #include <liblas/version.hpp>
 #include <liblas/writer.hpp>
+#include <liblas/pointtable.hpp>
 #include <liblas/detail/writer/writer.hpp>
 #include <liblas/detail/writer/zipwriter.hpp>
 #include <liblas/factory.hpp>
@@ -109,6 +110,21 @@ bool Writer::WritePoint(Point const& point)
     return true;
 }
 
+void Writer::WritePoints(PointBuffer const& buffer)
+{
+    m_pimpl->WritePoints(buffer);
+}
+
+void Writer::WritePoints(PointTable const& table)
+{
+    table.Write(*this);
+}
+
+void Writer::Flush()
+{
+    m_pimpl->Flush();
+}
+
 void Writer::WriteHeader()
 {
     // The writer may update our header as part of its 
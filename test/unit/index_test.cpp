@@ -0,0 +1,100 @@
+// $Id$
+//
+// Distributed under the BSD License
+// (See accompanying file LICENSE.txt or copy at
+// http://www.opensource.org/licenses/bsd-license.php)
+//
+#include <liblas/liblas.hpp>
+#include <liblas/index.hpp>
+#include <tut/tut.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "liblas_test.hpp"
+#include "common.hpp"
+
+namespace tut
+{ 
+    struct lasindex_data
+    {
+        std::string tmpfile_;
+        std::string file12_;
+
+        lasindex_data()
+            : tmpfile_(g_test_data_path + "//tmp_index.tmp")
+            , file12_(g_test_data_path + "//certainty3d-color-utm-feet-navd88.las")
+        {}
+
+        // Builds a standalone index of file12_ and filters it with the 
+        // given fraction of its extent in X and Y, starting at the minimum
+        std::vector<boost::uint32_t> filter(boost::uint32_t threads, double zbinht, double fraction)
+        {
+            std::ifstream ifs;
+            ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+            liblas::Reader reader(ifs);
+            std::stringstream oss(std::ios::in | std::ios::out | std::ios::binary);
+
+            liblas::IndexData data;
+            ensure(data.SetBuildAloneValues(&reader, &oss, tmpfile_.c_str(), 0, 0, 0, zbinht, 
+                LIBLAS_INDEX_MINMEMDEFAULT));
+            data.SetBuildThreads(threads);
+            liblas::Index index(data);
+            ensure(index.IndexReady());
+            ensure_equals(index.GetBuildThreads(), threads);
+
+            liblas::IndexData bounds(index);
+            ensure(bounds.SetFilterValues(index.GetMinX(), 
+                index.GetMinX() + index.GetRangeX() * fraction,
+                index.GetMinY(), 
+                index.GetMinY() + index.GetRangeY() * fraction,
+                index.GetMinZ(), index.GetMaxZ(), index));
+            return index.Filter(bounds);
+        }
+    };
+
+    typedef test_group<lasindex_data> tg;
+    typedef tg::object to;
+
+    tg test_group_lasindex("liblas::Index");
+
+    // Test an index built on several threads finds every point and 
+    // removes the temp file of each thread
+    template<>
+    template<>
+    void to::test<1>()
+    {
+        std::vector<boost::uint32_t> ids = filter(3, 0.0, 1.0);
+
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        ensure_equals(ids.size(), static_cast<std::size_t>(reader.GetHeader().GetPointRecordsCount()));
+
+        for (int i = 0; i < 3; ++i)
+        {
+            std::string name = tmpfile_;
+            if (i > 0)
+                name += "-" + boost::lexical_cast<std::string>(i);
+            std::ifstream tmp(name.c_str());
+            ensure_not(tmp.is_open());
+        }
+    }
+
+    // Test filter results do not depend on the number of threads 
+    // used to build the index
+    template<>
+    template<>
+    void to::test<2>()
+    {
+        std::vector<boost::uint32_t> one = filter(1, 0.0, 0.4);
+        ensure_not(one.empty());
+        ensure(filter(4, 0.0, 0.4) == one);
+
+        std::vector<boost::uint32_t> zone = filter(1, 5.0, 0.6);
+        ensure_not(zone.empty());
+        ensure(filter(4, 5.0, 0.6) == zone);
+    }
+}
+
@@ -603,4 +603,239 @@ namespace tut
         
     }
 
+    // Test GetValue and DimensionAccessor on standard and custom dimensions
+    template<>
+    template<>
+    void to::test<21>()
+    {
+        liblas::Header header;
+        header.SetDataFormatId(liblas::ePointFormat3);
+
+        liblas::Schema schema(header.GetSchema());
+        liblas::Dimension extra("Extra", 24);
+        extra.IsNumeric(true);
+        extra.IsInteger(true);
+        extra.IsSigned(true);
+        schema.AddDimension(extra);
+        header.SetSchema(schema);
+
+        liblas::Point p;
+        p.SetHeader(&header);
+        ensure_equals(p.GetData().size(), header.GetDataRecordLength());
+        p.SetIntensity(1234);
+        p.SetScanAngleRank(-12);
+        p.SetTime(1.5);
+        p.SetReturnNumber(3);
+        p.SetNumberOfReturns(5);
+        p.SetColor(liblas::Color(1, 2, 3));
+
+        liblas::Schema const& s = header.GetSchema();
+        ensure_equals(boost::any_cast<boost::uint16_t>(p.GetValue(*s.GetDimension("Intensity"))), 1234);
+        ensure_equals(boost::any_cast<boost::int8_t>(p.GetValue(*s.GetDimension("Scan Angle Rank"))), -12);
+        ensure_equals(boost::any_cast<double>(p.GetValue(*s.GetDimension("Time"))), 1.5);
+        ensure_equals(boost::any_cast<boost::uint8_t>(p.GetValue(*s.GetDimension("Return Number"))), 3);
+        ensure_equals(boost::any_cast<boost::uint16_t>(p.GetValue(*s.GetDimension("Blue"))), 3);
+
+        liblas::DimensionAccessor<int> returns(s, "Return Number");
+        liblas::DimensionAccessor<int> count(s, "Number of Returns");
+        ensure_equals(returns.Get(p), 3);
+        ensure_equals(count.Get(p), 5);
+        returns.Set(p, 2);
+        ensure_equals(p.GetReturnNumber(), 2);
+        ensure_equals(p.GetNumberOfReturns(), 5);
+
+        liblas::DimensionAccessor<boost::int32_t> custom(s, "Extra");
+        custom.Set(p, -70000);
+        ensure_equals(custom.Get(p), -70000);
+        ensure_equals(boost::any_cast<boost::int64_t>(p.GetValue(*s.GetDimension("Extra"))), -70000);
+        ensure_equals(p.GetIntensity(), 1234);
+        ensure_equals(p.GetColor().GetBlue(), 3);
+
+        liblas::PointBuffer buffer;
+        buffer.SetHeader(&header);
+        for (int i = 0; i < 10; ++i)
+        {
+            p.SetIntensity(static_cast<boost::uint16_t>(i * 100));
+            custom.Set(p, -i * 1000);
+            buffer.AddPoint(p);
+        }
+
+        std::vector<double> intensities;
+        std::vector<boost::int32_t> extras;
+        liblas::DimensionAccessor<double>(s, "Intensity").Get(liblas::PointSpan(buffer), intensities);
+        custom.Get(liblas::PointSpan(buffer), extras);
+        ensure_equals(intensities.size(), buffer.size());
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            ensure_equals(intensities[i], i * 100.0);
+            ensure_equals(extras[i], -static_cast<boost::int32_t>(i) * 1000);
+        }
+
+        try
+        {
+            liblas::DimensionAccessor<int> missing(s, "No such dimension");
+            ensure("liblas_error not thrown", false);
+        }
+        catch (liblas::liblas_error const&)
+        {}
+    }
+
+    // Test point data stays inline for the standard formats, spills to 
+    // the heap for wide records and survives copies and swaps
+    template<>
+    template<>
+    void to::test<22>()
+    {
+        liblas::Point p;
+        ensure_equals(p.GetData().size(), std::size_t(liblas::ePointSize3));
+        ensure_not(p.GetData().IsHeapAllocated());
+
+        p.SetIntensity(42);
+        p.SetRawX(-17);
+
+        liblas::Point wide;
+        std::vector<boost::uint8_t> bytes(200, 7);
+        bytes[12] = 9; bytes[13] = 0;
+        wide.SetData(bytes);
+        ensure(wide.GetData().IsHeapAllocated());
+        ensure_equals(wide.GetIntensity(), 9);
+
+        liblas::Point copy(wide);
+        ensure(copy.GetData() == wide.GetData());
+        ensure(copy.GetData().data() != wide.GetData().data());
+
+        boost::uint8_t const* heap = wide.GetData().data();
+        p.swap(wide);
+        ensure_equals(p.GetData().size(), std::size_t(200));
+        ensure(p.GetData().data() == heap);
+        ensure_equals(wide.GetIntensity(), 42);
+        ensure_equals(wide.GetRawX(), -17);
+        ensure_not(wide.GetData().IsHeapAllocated());
+
+        wide = p;
+        ensure(wide.GetData() == p.GetData());
+
+        liblas::PointData shrunk(wide.GetData());
+        shrunk.resize(20);
+        ensure_equals(shrunk.size(), std::size_t(20));
+        ensure_equals(shrunk[19], boost::uint8_t(7));
+        shrunk.resize(24, 1);
+        ensure_equals(shrunk[23], boost::uint8_t(1));
+
+        try
+        {
+            shrunk.at(24);
+            fail("std::out_of_range not thrown but expected");
+        }
+        catch (std::out_of_range const& e)
+        {
+            ensure(e.what(), true);
+        }
+    }
+
+    // Test SetHeader and SchemaConverter carry dimensions across point 
+    // formats, custom dimensions and changes of scale and offset
+    template<>
+    template<>
+    void to::test<23>()
+    {
+        liblas::Header source;
+        source.SetDataFormatId(liblas::ePointFormat3);
+        source.SetScale(0.01, 0.01, 0.01);
+        source.SetOffset(100.0, 200.0, 0.0);
+
+        liblas::Schema schema(source.GetSchema());
+        liblas::Dimension extra("Extra", 16);
+        extra.IsNumeric(true);
+        extra.IsInteger(true);
+        schema.AddDimension(extra);
+        source.SetSchema(schema);
+
+        // Format 1 with extra bytes, finer scale that is an integer 
+        // multiple of the source's and an offset a whole step away.
+        liblas::Header target;
+        target.SetDataFormatId(liblas::ePointFormat1);
+        target.SetScale(0.001, 0.001, 0.001);
+        target.SetOffset(100.5, 200.0, 0.0);
+        liblas::Schema target_schema(target.GetSchema());
+        target_schema.AddDimension(extra);
+        target.SetSchema(target_schema);
+
+        liblas::Point p;
+        p.SetHeader(&source);
+        p.SetCoordinates(123.45, 678.91, -3.21);
+        p.SetIntensity(321);
+        p.SetReturnNumber(2);
+        p.SetNumberOfReturns(4);
+        p.SetScanDirection(1);
+        p.SetClassification(liblas::Classification(6));
+        p.SetScanAngleRank(-30);
+        p.SetPointSourceID(77);
+        p.SetTime(1234.5);
+        p.SetColor(liblas::Color(10, 20, 30));
+        liblas::DimensionAccessor<int>(source.GetSchema(), "Extra").Set(p, 4321);
+
+        liblas::Point q(p);
+        q.SetHeader(&target);
+        ensure_equals(q.GetData().size(), target.GetDataRecordLength());
+        ensure_equals(q.GetRawX(), 22950);
+        ensure_distance(q.GetX(), 123.45, 1e-9);
+        ensure_distance(q.GetY(), 678.91, 1e-9);
+        ensure_distance(q.GetZ(), -3.21, 1e-9);
+        ensure_equals(q.GetIntensity(), 321);
+        ensure_equals(q.GetReturnNumber(), 2);
+        ensure_equals(q.GetNumberOfReturns(), 4);
+        ensure_equals(q.GetScanDirection(), 1);
+        ensure_equals(q.GetClassification().GetClass(), 6u);
+        ensure_equals(q.GetScanAngleRank(), -30);
+        ensure_equals(q.GetPointSourceID(), 77);
+        ensure_equals(q.GetTime(), 1234.5);
+        ensure_equals(liblas::DimensionAccessor<int>(target.GetSchema(), "Extra").Get(q), 4321);
+
+        // And back again, where the coarser scale divides the raw values 
+        // and the color the target dropped comes back as zero.
+        liblas::Point r(q);
+        r.SetHeader(&source);
+        ensure_equals(r.GetRawX(), p.GetRawX());
+        ensure_equals(r.GetRawY(), p.GetRawY());
+        ensure_equals(r.GetRawZ(), p.GetRawZ());
+        ensure_equals(r.GetTime(), 1234.5);
+        ensure_equals(r.GetColor().GetRed(), 0);
+        ensure_equals(liblas::DimensionAccessor<int>(source.GetSchema(), "Extra").Get(r), 4321);
+
+        // Batches give the same records as converting point by point, 
+        // also when the scales are not multiples of each other.
+        target.SetScale(0.003, 0.003, 0.003);
+        liblas::PointBuffer buffer;
+        buffer.SetHeader(&source);
+        for (int i = 0; i < 100; ++i)
+        {
+            p.SetCoordinates(100.0 + i * 0.37, 200.0 - i * 1.01, i * 0.05);
+            p.SetIntensity(static_cast<boost::uint16_t>(i));
+            buffer.AddPoint(p);
+        }
+
+        liblas::SchemaConverter converter(source, target);
+        ensure_not(converter.IsIdentity());
+        ensure(liblas::SchemaConverter(source, source).IsIdentity());
+
+        liblas::PointBuffer converted;
+        converted.SetHeader(&target);
+        converter.Convert(liblas::PointSpan(buffer), converted);
+        ensure_equals(converted.size(), buffer.size());
+
+        liblas::Point expected;
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            buffer.GetPoint(i, expected);
+            double const x = expected.GetX();
+            expected.SetHeader(&target);
+            ensure_equals(expected.GetRawX(), static_cast<boost::int32_t>(
+                liblas::detail::sround((x - 100.5) / 0.003)));
+            ensure("record differs", std::equal(expected.GetData().begin(), 
+                                                expected.GetData().end(), 
+                                                converted.GetRecord(i)));
+        }
+    }
 }
+
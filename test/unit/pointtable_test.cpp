@@ -0,0 +1,114 @@
+// $Id$
+//
+// Distributed under the BSD License
+// (See accompanying file LICENSE.txt or copy at
+// http://www.opensource.org/licenses/bsd-license.php)
+//
+#include <liblas/liblas.hpp>
+#include <tut/tut.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "liblas_test.hpp"
+#include "common.hpp"
+
+namespace tut
+{ 
+    struct laspointtable_data
+    {
+        std::string file10_;
+        std::string file12_;
+
+        laspointtable_data()
+            : file10_(g_test_data_path + "//TO_core_last_clip.las")
+            , file12_(g_test_data_path + "//certainty3d-color-utm-feet-navd88.las")
+        {}
+    };
+
+    typedef test_group<laspointtable_data> tg;
+    typedef tg::object to;
+
+    tg test_group_laspointtable("liblas::PointTable");
+
+    // Test columns decoded from a reader
+    template<>
+    template<>
+    void to::test<1>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointTable table;
+        ensure_equals(table.Read(reader, 3), 3u);
+        ensure_equals(table.Read(reader, 100), 5u);
+        ensure_equals(table.Read(reader, 100), 0u);
+        ensure_equals(table.size(), 8u);
+        ensure(table.HasTime());
+        ensure_not(table.HasColor());
+
+        ensure_distance(table.GetX()[0], double(630262.30), 0.0001);
+        ensure_distance(table.GetY()[0], double(4834500), 0.0001);
+        ensure_distance(table.GetZ()[0], double(51.53), 0.0001);
+        ensure_equals(table.GetIntensity()[0], 670);
+        ensure_equals(table.GetScanFlags()[0], 9);
+        ensure_equals(table.GetUserData()[0], 3);
+        ensure_distance(table.GetTime()[0], double(413665.23360000004), 0.0001);
+
+        liblas::Point p;
+        table.GetPoint(0, p);
+        test_file10_point1(p);
+        table.GetPoint(1, p);
+        test_file10_point2(p);
+        table.GetPoint(3, p);
+        test_file10_point4(p);
+    }
+
+    // Test rows encode back to the original records and through a writer
+    template<>
+    template<>
+    void to::test<2>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Header const& header = reader.GetHeader();
+
+        liblas::PointTable table;
+        while (table.Read(reader, 1000))
+        {
+        }
+        ensure_equals(table.size(), static_cast<std::size_t>(header.GetPointRecordsCount()));
+        ensure(table.HasColor());
+
+        liblas::PointBuffer buffer;
+        table.Encode(buffer, 0, table.size());
+
+        reader.Reset();
+        std::size_t i = 0;
+        while (reader.ReadNextPoint())
+        {
+            liblas::PointData const& data = reader.GetPoint().GetData();
+            ensure("record differs", std::equal(data.begin(), data.end(), buffer.GetRecord(i)));
+            ++i;
+        }
+
+        std::stringstream oss;
+        {
+            liblas::Writer writer(oss, header);
+            table.Write(writer);
+        }
+
+        liblas::Reader copy(oss);
+        liblas::PointTable other;
+        while (other.Read(copy, 1000))
+        {
+        }
+        ensure_equals(other.size(), table.size());
+        ensure(other.GetRawX() == table.GetRawX());
+        ensure(other.GetRed() == table.GetRed());
+        ensure(other.GetTime() == table.GetTime());
+    }
+}
+
@@ -7,9 +7,16 @@
 //
 
 #include <liblas/liblas.hpp>
+#include <liblas/detail/chunksummary.hpp>
+#include <liblas/detail/reader/cachedreader.hpp>
+#include <liblas/detail/reader/reader.hpp>
 #include <tut/tut.hpp>
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include "liblas_test.hpp"
 #include "common.hpp"
 
@@ -276,5 +283,961 @@ namespace tut
 
     }
 
-}
+    // Test ReadNextPoints
+    template<>
+    template<>
+    void to::test<9>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointBuffer buffer;
+        liblas::Point p;
+
+        ensure_equals(reader.ReadNextPoints(buffer, 3), 3u);
+        ensure(buffer.GetHeader() == &reader.GetHeader());
+        buffer.GetPoint(0, p);
+        test_file10_point1(p);
+        buffer.GetPoint(1, p);
+        test_file10_point2(p);
+
+        ensure_equals(reader.ReadNextPoints(buffer, 3), 3u);
+        buffer.GetPoint(0, p);
+        test_file10_point4(p);
+
+        // only 2 of the 8 points are left
+        ensure_equals(reader.ReadNextPoints(buffer, 3), 2u);
+        ensure_equals(reader.ReadNextPoints(buffer, 3), 0u);
+        ensure_equals(buffer.size(), 0u);
+    }
+
+    // Test ReadNextPoints applies filters across blocks
+    template<>
+    template<>
+    void to::test<10>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::ThinFilter thin(3);
+        std::vector<liblas::Point> expected;
+        while (reader.ReadNextPoint())
+        {
+            if (thin.filter(reader.GetPoint()))
+                expected.push_back(reader.GetPoint());
+        }
+
+        std::ifstream ifs2;
+        ifs2.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader batch(ifs2);
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new liblas::ThinFilter(3)));
+        batch.SetFilters(filters);
+
+        liblas::PointBuffer buffer;
+        liblas::Point p;
+        std::size_t count = 0;
+        while (batch.ReadNextPoints(buffer, 1000))
+        {
+            for (std::size_t i = 0; i < buffer.size(); ++i, ++count)
+            {
+                buffer.GetPoint(i, p);
+                ensure("point past expected count", count < expected.size());
+                ensure_equals(p.GetRawX(), expected[count].GetRawX());
+                ensure_equals(p.GetRawY(), expected[count].GetRawY());
+                ensure_equals(p.GetTime(), expected[count].GetTime());
+            }
+        }
+        ensure_equals(count, expected.size());
+    }
+
+    // Test the mapped reader matches the stream reader
+    template<>
+    template<>
+    void to::test<11>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::ReaderFactory factory;
+        liblas::Reader mapped = factory.CreateMapped(file12_);
+        ensure_equals(mapped.GetHeader().GetPointRecordsCount(),
+                      reader.GetHeader().GetPointRecordsCount());
+
+        std::size_t count = 0;
+        while (reader.ReadNextPoint())
+        {
+            ensure("mapped reader ended early", mapped.ReadNextPoint());
+            ensure_equals(mapped.GetPoint().GetRawX(), reader.GetPoint().GetRawX());
+            ensure_equals(mapped.GetPoint().GetRawY(), reader.GetPoint().GetRawY());
+            ensure_equals(mapped.GetPoint().GetRawZ(), reader.GetPoint().GetRawZ());
+            ensure_equals(mapped.GetPoint().GetTime(), reader.GetPoint().GetTime());
+            ++count;
+        }
+        ensure_not(mapped.ReadNextPoint());
+        ensure_equals(count, reader.GetHeader().GetPointRecordsCount());
+
+        // random access goes straight to the mapping
+        ensure(reader.ReadPointAt(count - 1));
+        ensure(mapped.ReadPointAt(count - 1));
+        liblas::Point const& last = reader.GetPoint();
+        ensure_equals(mapped.GetPoint().GetRawX(), last.GetRawX());
+        ensure_equals(mapped.GetPoint().GetRawY(), last.GetRawY());
+
+        mapped.Seek(count - 2);
+        liblas::PointBuffer buffer;
+        ensure_equals(mapped.ReadNextPoints(buffer, 10), 2u);
+        liblas::Point p;
+        buffer.GetPoint(1, p);
+        ensure_equals(p.GetRawX(), last.GetRawX());
+    }
+
+    // Test the read-ahead reader matches the stream reader
+    template<>
+    template<>
+    void to::test<12>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        std::ifstream ifs2;
+        ifs2.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader prefetched = factory.CreatePrefetched(ifs2, 100, 3);
+
+        // mix single point and block reads across block boundaries
+        liblas::PointBuffer buffer;
+        liblas::Point p;
+        std::size_t count = 0;
+        while (reader.ReadNextPoint())
+        {
+            liblas::Point const& expected = reader.GetPoint();
+            if (count % 250 < 200)
+            {
+                ensure("read-ahead reader ended early", prefetched.ReadNextPoint());
+                p = prefetched.GetPoint();
+            }
+            else
+            {
+                if (count % 250 == 200)
+                    ensure_equals(prefetched.ReadNextPoints(buffer, 50), 50u);
+                buffer.GetPoint(count % 250 - 200, p);
+            }
+            ensure_equals(p.GetRawX(), expected.GetRawX());
+            ensure_equals(p.GetRawY(), expected.GetRawY());
+            ensure_equals(p.GetTime(), expected.GetTime());
+            ++count;
+        }
+        ensure_equals(count, reader.GetHeader().GetPointRecordsCount());
+        ensure_not(prefetched.ReadNextPoint());
+
+        liblas::PrefetchStats const stats = prefetched.GetPrefetchStats();
+        ensure_equals(stats.blocks, (count + 99) / 100);
+        ensure(stats.stalls <= stats.blocks + 1);
+        ensure(stats.stall_time >= 0.0);
+        ensure_equals(reader.GetPrefetchStats().blocks, 0u);
+
+        prefetched.Reset();
+        std::size_t again = 0;
+        while (prefetched.ReadNextPoints(buffer, 1000))
+            again += buffer.size();
+        ensure_equals(again, count);
+    }
+
+    struct batch_counter
+    {
+        batch_counter(std::vector<std::size_t>& counts) : counts_(&counts) {}
+        void operator()(std::size_t thread, liblas::PointBuffer const& batch) const
+        {
+            (*counts_)[thread] += batch.size();
+        }
+        std::vector<std::size_t>* counts_;
+    };
+
+    // Test the parallel reader covers every point once and merges summaries
+    template<>
+    template<>
+    void to::test<13>()
+    {
+        liblas::ParallelReader parallel(file12_, 4);
+        parallel.SetBatchSize(100);
+
+        std::vector<std::size_t> counts(parallel.GetThreadCount(), 0);
+        parallel.ForEachBatch(batch_counter(counts));
+
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            ensure("every thread gets a range", counts[i] > 0);
+            total += counts[i];
+        }
+        ensure_equals(total, parallel.GetHeader().GetPointRecordsCount());
+
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Summary expected;
+        while (reader.ReadNextPoint())
+            expected.AddPoint(reader.GetPoint());
+
+        liblas::Summary summary;
+        parallel.Reduce(summary);
+
+        liblas::property_tree::ptree e = expected.GetPTree();
+        liblas::property_tree::ptree s = summary.GetPTree();
+        ensure_equals(s.get<boost::uint32_t>("summary.points.count"), 
+                      e.get<boost::uint32_t>("summary.points.count"));
+        ensure_equals(s.get<double>("summary.points.minimum.x"), 
+                      e.get<double>("summary.points.minimum.x"));
+        ensure_equals(s.get<double>("summary.points.maximum.y"), 
+                      e.get<double>("summary.points.maximum.y"));
+        ensure_equals(s.get<double>("summary.points.maximum.time"), 
+                      e.get<double>("summary.points.maximum.time"));
+        ensure_equals(s.get<boost::uint32_t>("summary.points.maximum.color.red"), 
+                      e.get<boost::uint32_t>("summary.points.maximum.color.red"));
+    }
+
+    // Test BoundsFilter raw comparisons agree with scaled coordinates
+    template<>
+    template<>
+    void to::test<14>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        // put the edges exactly on existing coordinates
+        ensure(reader.ReadPointAt(10));
+        double const minx = reader.GetPoint().GetX();
+        double const minz = reader.GetPoint().GetZ();
+        ensure(reader.ReadPointAt(20));
+        double const maxy = reader.GetPoint().GetY();
+
+        liblas::Header const& h = reader.GetHeader();
+        double const maxx = h.GetMaxX();
+        double const miny = h.GetMinY();
+        double const maxz = h.GetMaxZ();
+
+        liblas::BoundsFilter filter(minx, miny, minz, maxx, maxy, maxz);
+        liblas::BoundsFilter flat(minx, miny, maxx, maxy);
+
+        reader.Reset();
+        liblas::PointBuffer buffer;
+        ensure(reader.ReadNextPoints(buffer, 100000) > 0);
+
+        liblas::SelectionMask mask;
+        std::size_t const kept = filter.filter_batch(liblas::PointSpan(buffer), mask);
+        ensure_equals(mask.size(), buffer.size());
+
+        std::size_t expected = 0;
+        std::size_t expected_flat = 0;
+        liblas::Point p;
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            buffer.GetPoint(i, p);
+            bool const in_xy = p.GetX() >= minx && p.GetX() <= maxx && 
+                               p.GetY() >= miny && p.GetY() <= maxy;
+            bool const inside = in_xy && p.GetZ() >= minz && p.GetZ() <= maxz;
+
+            ensure_equals(filter.filter(p), inside);
+            ensure_equals(mask[i] != 0, inside);
+            ensure_equals(flat.filter(p), in_xy);
+
+            if (inside) ++expected;
+            if (in_xy) ++expected_flat;
+        }
+        ensure_equals(kept, expected);
+        ensure("bounds select some points", expected > 0 && expected < buffer.size());
+        ensure_equals(flat.filter_batch(liblas::PointSpan(buffer), mask), expected_flat);
+    }
+
+    // Test batch filtering matches point-at-a-time filtering
+    template<>
+    template<>
+    void to::test<15>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointBuffer buffer;
+        ensure(reader.ReadNextPoints(buffer, 100000) > 0);
+
+        std::vector<liblas::FilterPtr> filters;
+
+        // select the class of the last record so the end of the file 
+        // is exercised below
+        liblas::Point p;
+        buffer.GetPoint(buffer.size() - 1, p);
+        std::vector<liblas::Classification> classes;
+        classes.push_back(p.GetClassification());
+        filters.push_back(liblas::FilterPtr(new liblas::ClassificationFilter(classes)));
+
+        std::vector<boost::uint16_t> returns;
+        returns.push_back(1);
+        filters.push_back(liblas::FilterPtr(new liblas::ReturnFilter(returns, false)));
+        filters.push_back(liblas::FilterPtr(new liblas::ReturnFilter(returns, true)));
+
+        filters.push_back(liblas::FilterPtr(new liblas::ValidationFilter()));
+
+        liblas::Color low(0, 0, 0);
+        liblas::Color high(40000, 40000, 40000);
+        filters.push_back(liblas::FilterPtr(new liblas::ColorFilter(low, high)));
+        liblas::FilterPtr outside(new liblas::ColorFilter(low, high));
+        outside->SetType(liblas::FilterI::eExclusion);
+        filters.push_back(outside);
+
+        // ContinuousValueFilter on raw records, with a parsed comparator, 
+        // a std:: comparator and a scaled coordinate
+        typedef liblas::ContinuousValueFilter<boost::uint16_t> intensity_filter;
+        intensity_filter::filter_func fi = &liblas::Point::GetIntensity;
+        std::string const intensity = "<" + boost::lexical_cast<std::string>(p.GetIntensity());
+        filters.push_back(liblas::FilterPtr(new intensity_filter(fi, intensity)));
+
+        typedef liblas::ContinuousValueFilter<double> double_filter;
+        double_filter::filter_func fz = &liblas::Point::GetZ;
+        filters.push_back(liblas::FilterPtr(new double_filter(fz, p.GetZ(), std::greater_equal<double>())));
+        double_filter::filter_func ft = &liblas::Point::GetTime;
+        liblas::FilterPtr time(new double_filter(ft, p.GetTime(), std::less<double>()));
+        time->SetType(liblas::FilterI::eExclusion);
+        filters.push_back(time);
+
+        typedef liblas::ContinuousValueFilter<int> int_filter;
+        int_filter::filter_func fa = &liblas::Point::GetScanAngleRank;
+        filters.push_back(liblas::FilterPtr(new int_filter(fa, "==0")));
+        int_filter::filter_func fr = &liblas::Point::GetReturnNumber;
+        filters.push_back(liblas::FilterPtr(new int_filter(fr, ">=2")));
+
+        liblas::SelectionMask mask;
+        for (std::size_t f = 0; f < filters.size(); ++f)
+        {
+            std::size_t const kept = filters[f]->filter_batch(liblas::PointSpan(buffer), mask);
+            ensure_equals(mask.size(), buffer.size());
+
+            std::size_t expected = 0;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+            {
+                buffer.GetPoint(i, p);
+                bool const keep = filters[f]->filter(p);
+                ensure_equals(mask[i] != 0, keep);
+                if (keep) ++expected;
+            }
+            ensure_equals(kept, expected);
+        }
+
+        // Filtered ReadNextPoint hands out every matching point, 
+        // including the last record of the file
+        std::vector<liblas::FilterPtr> classification;
+        classification.push_back(filters[0]);
+        reader.SetFilters(classification);
+
+        std::size_t matches = 0;
+        std::size_t last = 0;
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            buffer.GetPoint(i, p);
+            if (filters[0]->filter(p))
+            {
+                ++matches;
+                last = i;
+            }
+        }
+        ensure_equals(last, buffer.size() - 1);
+
+        reader.Reset();
+        std::size_t read = 0;
+        while (reader.ReadNextPoint())
+        {
+            ensure(filters[0]->filter(reader.GetPoint()));
+            ++read;
+        }
+        ensure_equals(read, matches);
+
+        buffer.GetPoint(last, p);
+        ensure_equals(reader.GetPoint().GetRawX(), p.GetRawX());
+        ensure_equals(reader.GetPoint().GetRawY(), p.GetRawY());
+    }
+
+    // Test ExpressionFilter against the equivalent tests on Point
+    template<>
+    template<>
+    void to::test<16>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointBuffer buffer;
+        ensure(reader.ReadNextPoints(buffer, 100000) > 0);
+
+        liblas::Header const& h = reader.GetHeader();
+        double const midz = (h.GetMinZ() + h.GetMaxZ()) / 2;
+
+        std::ostringstream text;
+        text.precision(15);
+        text << "Intensity > 300 && (classification in (0, 2) || return_number != 1)"
+             << " and not z between " << h.GetMinZ() << " and " << midz
+             << " and scan_angle >= -45 && Point_Source_ID == 0";
+
+        liblas::ExpressionFilter filter(text.str());
+        ensure_equals(filter.GetExpression(), text.str());
+
+        liblas::ExpressionFilter dropped(text.str());
+        dropped.SetType(liblas::FilterI::eExclusion);
+
+        liblas::SelectionMask mask;
+        liblas::SelectionMask dropped_mask;
+        std::size_t const kept = filter.filter_batch(liblas::PointSpan(buffer), mask);
+        std::size_t const not_dropped = dropped.filter_batch(liblas::PointSpan(buffer), dropped_mask);
+        ensure_equals(kept + not_dropped, buffer.size());
+
+        std::size_t expected = 0;
+        liblas::Point p;
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            buffer.GetPoint(i, p);
+            bool const match = p.GetIntensity() > 300 && 
+                (p.GetClassification().GetClass() == 0 || 
+                 p.GetClassification().GetClass() == 2 || 
+                 p.GetReturnNumber() != 1) &&
+                !(p.GetZ() >= h.GetMinZ() && p.GetZ() <= midz) &&
+                p.GetScanAngleRank() >= -45 && p.GetPointSourceID() == 0;
+
+            ensure_equals(mask[i] != 0, match);
+            ensure_equals(dropped_mask[i] != 0, !match);
+            ensure_equals(filter.filter(p), match);
+            if (match) ++expected;
+        }
+        ensure_equals(kept, expected);
+        ensure("expression selects some points", expected > 0 && expected < buffer.size());
+
+        try
+        {
+            liblas::ExpressionFilter bad("intensity >> 3");
+            ensure("invalid_expression not thrown", false);
+        }
+        catch (liblas::invalid_expression const&)
+        {}
+
+        liblas::ExpressionFilter unknown("no_such_dimension > 3");
+        try
+        {
+            unknown.filter_batch(liblas::PointSpan(buffer), mask);
+            ensure("invalid_expression not thrown", false);
+        }
+        catch (liblas::invalid_expression const&)
+        {}
+    }
 
+    // Test the cached reader serves sequential and random reads from 
+    // its pages and keeps within its budget
+    template<>
+    template<>
+    void to::test<17>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader plain(ifs);
+
+        liblas::PointBuffer expected;
+        plain.ReadNextPoints(expected, 100000);
+        std::size_t const record_length = expected.GetRecordLength();
+        ensure("enough points for several pages", expected.size() > 500);
+
+        std::ifstream cifs;
+        cifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderIPtr inner(new liblas::detail::ReaderImpl(cifs));
+        boost::shared_ptr<liblas::detail::CachedReaderImpl> cache(
+            new liblas::detail::CachedReaderImpl(inner, 100, 3 * 100 * record_length));
+        liblas::Reader reader(cache);
+
+        std::size_t n = 0;
+        while (reader.ReadNextPoint())
+        {
+            ensure("record differs", std::equal(reader.GetPoint().GetData().begin(), 
+                                                reader.GetPoint().GetData().end(), 
+                                                expected.GetRecord(n)));
+            ++n;
+        }
+        ensure_equals(n, expected.size());
+        std::size_t const pages = (n + 99) / 100;
+        ensure_equals(cache->GetStats().misses, boost::uint64_t(pages));
+        ensure_equals(cache->GetStats().evictions, boost::uint64_t(pages - 3));
+        ensure(cache->GetStats().bytes <= 3 * 100 * record_length);
+
+        // Points on the last pages come out of memory
+        boost::uint64_t const misses = cache->GetStats().misses;
+        for (std::size_t i = n - 1; i >= n - 200; --i)
+        {
+            reader.ReadPointAt(i);
+            ensure_equals(reader.GetPoint().GetRawX(), 
+                          liblas::detail::load_stored<boost::int32_t>(expected.GetRecord(i)));
+        }
+        ensure_equals(cache->GetStats().misses, misses);
+
+        // ... and the first one has to be read again
+        reader.ReadPointAt(0);
+        ensure_equals(cache->GetStats().misses, misses + 1);
+        ensure("next point follows ReadPointAt", reader.ReadNextPoint());
+        ensure("record differs", std::equal(reader.GetPoint().GetData().begin(), 
+                                            reader.GetPoint().GetData().end(), 
+                                            expected.GetRecord(1)));
+
+        // Filters apply to cached points, and batches match
+        std::vector<liblas::Classification> classes;
+        liblas::Point p;
+        expected.GetPoint(0, p);
+        classes.push_back(p.GetClassification());
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new liblas::ClassificationFilter(classes)));
+        reader.SetFilters(filters);
+        reader.Reset();
+
+        liblas::PointBuffer filtered;
+        reader.ReadNextPoints(filtered, 100000);
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected.GetPoint(i, p);
+            if (filters[0]->filter(p))
+            {
+                ensure("record differs", std::equal(filtered.GetRecord(matches), 
+                                                    filtered.GetRecord(matches) + record_length, 
+                                                    expected.GetRecord(i)));
+                ++matches;
+            }
+        }
+        ensure_equals(filtered.size(), matches);
+    }
+
+    // Test readers of the same file share pages through a SharedPageCache
+    template<>
+    template<>
+    void to::test<18>()
+    {
+        liblas::SharedPageCache cache(0, 4);
+        liblas::ReaderFactory factory;
+
+        std::ifstream ifs1;
+        ifs1.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader first = factory.CreateCached(ifs1, file12_, cache);
+
+        liblas::PointBuffer expected;
+        std::size_t const n = first.ReadNextPoints(expected, 100000);
+        ensure("points read", n > 0);
+
+        liblas::SharedPageCache::Stats const filled = cache.GetStats();
+        ensure_equals(filled.hits, boost::uint64_t(0));
+        ensure("pages cached", filled.pages > 0);
+        ensure_equals(filled.bytes, n * expected.GetRecordLength());
+
+        // A second reader of the same file only hits the cache
+        std::ifstream ifs2;
+        ifs2.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader second = factory.CreateCached(ifs2, file12_, cache);
+
+        liblas::PointBuffer points;
+        ensure_equals(second.ReadNextPoints(points, 100000), n);
+        ensure("records differ", std::equal(points.GetRecord(0), points.GetRecord(0) + n * points.GetRecordLength(), 
+                                            expected.GetRecord(0)));
+
+        liblas::SharedPageCache::Stats const shared = cache.GetStats();
+        ensure_equals(shared.misses, filled.misses);
+        ensure_equals(shared.hits, boost::uint64_t(filled.pages));
+        ensure_equals(shared.bytes_served, boost::uint64_t(n * points.GetRecordLength()));
+        ensure_distance(shared.GetHitRatio(), 0.5, 0.001);
+
+        // Another identity gets pages of its own
+        std::ifstream ifs3;
+        ifs3.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader other = factory.CreateCached(ifs3, file12_ + ".copy", cache);
+        other.ReadPointAt(0);
+        ensure_equals(cache.GetStats().misses, filled.misses + 1);
+
+        try
+        {
+            liblas::SharedPageCache broken(0, 0);
+            fail("configuration_error expected for a cache without stripes");
+        }
+        catch (liblas::configuration_error const&)
+        {}
+    }
+
+    // Test ReadPointsAt returns the points asked for in the order asked for
+    template<>
+    template<>
+    void to::test<19>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader plain(ifs);
+
+        liblas::PointBuffer expected;
+        plain.ReadNextPoints(expected, 100000);
+        std::size_t const n = expected.size();
+        std::size_t const record_length = expected.GetRecordLength();
+
+        // Unsorted, with a repeat, runs and gaps both below and above 
+        // the tolerance
+        std::vector<boost::uint32_t> ids;
+        ids.push_back(static_cast<boost::uint32_t>(n - 1));
+        ids.push_back(5);
+        ids.push_back(6);
+        ids.push_back(7);
+        ids.push_back(20);
+        ids.push_back(5);
+        ids.push_back(0);
+        ids.push_back(static_cast<boost::uint32_t>(n / 2));
+
+        std::ifstream cifs;
+        cifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+
+        liblas::Reader cached = factory.CreateCached(cifs, 1000);
+        liblas::Reader mapped = factory.CreateMapped(file12_);
+
+        liblas::Reader* readers[] = { &plain, &cached, &mapped };
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            std::size_t const gaps[] = { 0, 10, liblas::Reader::default_gap };
+            for (std::size_t g = 0; g < 3; ++g)
+            {
+                liblas::PointBuffer points;
+                ensure("points read", readers[r]->ReadPointsAt(ids, points, gaps[g]));
+                ensure_equals(points.size(), ids.size());
+                for (std::size_t i = 0; i < ids.size(); ++i)
+                {
+                    ensure("record differs", std::equal(points.GetRecord(i), 
+                                                        points.GetRecord(i) + record_length, 
+                                                        expected.GetRecord(ids[i])));
+                }
+            }
+
+            // Reading on in order after a Seek is not disturbed
+            readers[r]->Seek(3);
+            ensure("next point read", readers[r]->ReadNextPoint());
+            ensure("record differs", std::equal(readers[r]->GetPoint().GetData().begin(), 
+                                                readers[r]->GetPoint().GetData().end(), 
+                                                expected.GetRecord(3)));
+
+            ids.push_back(static_cast<boost::uint32_t>(n));
+            try
+            {
+                liblas::PointBuffer points;
+                readers[r]->ReadPointsAt(ids, points);
+                fail("std::out_of_range expected for an id past the last point");
+            }
+            catch (std::out_of_range const&)
+            {}
+            ids.pop_back();
+        }
+    }
+
+    // Test chunk summaries only rule out runs of points no point of 
+    // which passes the filter
+    template<>
+    template<>
+    void to::test<20>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Header const& header = reader.GetHeader();
+
+        liblas::PointBuffer points;
+        reader.ReadNextPoints(points, 100000);
+        liblas::PointFormatName const format = header.GetDataFormatId();
+        bool const has_time = format == liblas::ePointFormat1 || format == liblas::ePointFormat3;
+
+        std::size_t const chunk_size = 50;
+        std::vector<liblas::ChunkSummary> summaries;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            if (i % chunk_size == 0)
+                summaries.push_back(liblas::ChunkSummary());
+            summaries.back().Add(points.GetRecord(i), has_time);
+        }
+
+        // What is written is what is read back
+        std::stringstream stored(std::ios::in | std::ios::out | std::ios::binary);
+        liblas::detail::WriteChunkSummaries(stored, summaries);
+        std::vector<liblas::ChunkSummary> loaded;
+        ensure("summaries read", liblas::detail::ReadChunkSummaries(stored, summaries.size(), loaded));
+        ensure_equals(loaded.size(), summaries.size());
+        for (std::size_t c = 0; c < summaries.size(); ++c)
+        {
+            ensure_equals(loaded[c].count, summaries[c].count);
+            ensure("bounds differ", loaded[c].min == summaries[c].min && loaded[c].max == summaries[c].max);
+            ensure_equals(loaded[c].min_time, summaries[c].min_time);
+            ensure_equals(loaded[c].classifications, summaries[c].classifications);
+        }
+
+        liblas::Point p(&header);
+        points.GetPoint(points.size() / 2, p);
+        double const x = p.GetX();
+        double const y = p.GetY();
+        std::ostringstream expression;
+        expression.precision(15);
+        expression << "Time <= " << p.GetTime() << " and X >= " << x;
+
+        std::vector<liblas::Classification> classes;
+        classes.push_back(p.GetClassification());
+
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new liblas::BoundsFilter(x - 10, y - 10, x + 10, y + 10)));
+        filters.push_back(liblas::FilterPtr(new liblas::ClassificationFilter(classes)));
+        filters.push_back(liblas::FilterPtr(new liblas::ExpressionFilter(expression.str())));
+        filters.push_back(liblas::FilterPtr(new liblas::ExpressionFilter(expression.str())));
+        filters.back()->SetType(liblas::FilterI::eExclusion);
+
+        for (std::size_t f = 0; f < filters.size(); ++f)
+        {
+            std::size_t skipped = 0;
+            for (std::size_t c = 0; c < summaries.size(); ++c)
+            {
+                if (filters[f]->filter_summary(summaries[c], header))
+                    continue;
+                ++skipped;
+                std::size_t const end = std::min(points.size(), (c + 1) * chunk_size);
+                for (std::size_t i = c * chunk_size; i < end; ++i)
+                {
+                    points.GetPoint(i, p);
+                    ensure("skipped point passes", !filters[f]->filter(p));
+                }
+            }
+            ensure("chunk of the picked point kept", skipped < summaries.size());
+        }
+
+        ensure("empty summary skipped", !filters[0]->filter_summary(liblas::ChunkSummary(), header));
+    }
+
+    // Test filters set while reading ahead apply to every point not yet 
+    // handed out
+    template<>
+    template<>
+    void to::test<21>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        std::ifstream ifs2;
+        ifs2.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader prefetched = factory.CreatePrefetched(ifs2, 100, 3);
+
+        ensure(reader.ReadNextPoint());
+        ensure(prefetched.ReadNextPoint());
+        ensure_equals(prefetched.GetPoint().GetRawX(), reader.GetPoint().GetRawX());
+
+        // keep the western half of the points
+        liblas::Header const& header = reader.GetHeader();
+        double const middle = (header.GetMinX() + header.GetMaxX()) / 2;
+        typedef liblas::ContinuousValueFilter<double> x_filter;
+        x_filter::filter_func fx = &liblas::Point::GetX;
+
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new x_filter(fx, middle, std::less<double>())));
+        reader.SetFilters(filters);
+
+        std::vector<liblas::FilterPtr> prefetched_filters;
+        prefetched_filters.push_back(liblas::FilterPtr(new x_filter(fx, middle, std::less<double>())));
+        prefetched.SetFilters(prefetched_filters);
+
+        std::size_t count = 0;
+        while (reader.ReadNextPoint())
+        {
+            ensure("read-ahead reader ended early", prefetched.ReadNextPoint());
+            liblas::Point const& expected = reader.GetPoint();
+            liblas::Point const& p = prefetched.GetPoint();
+            ensure(p.GetX() < middle);
+            ensure_equals(p.GetRawX(), expected.GetRawX());
+            ensure_equals(p.GetRawY(), expected.GetRawY());
+            ensure_equals(p.GetRawZ(), expected.GetRawZ());
+            ++count;
+        }
+        ensure("filter keeps some points", count > 0 && count < header.GetPointRecordsCount() - 1);
+        ensure_not(prefetched.ReadNextPoint());
+    }
+
+    // Test ReadPointsAt reports ids past the end of a truncated file by 
+    // returning false
+    template<>
+    template<>
+    void to::test<22>()
+    {
+        std::string const truncated(g_test_data_path + "//tmp-truncated.las");
+
+        std::size_t kept = 0;
+        {
+            std::ifstream ifs;
+            ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+            liblas::Reader reader(ifs);
+            liblas::Header const& header = reader.GetHeader();
+            kept = header.GetPointRecordsCount() / 2;
+
+            std::streamsize const size = header.GetDataOffset() + kept * header.GetDataRecordLength();
+            std::vector<char> bytes(size);
+            ifs.seekg(0, std::ios::beg);
+            ifs.read(&bytes.front(), size);
+
+            std::ofstream ofs;
+            ofs.open(truncated.c_str(), std::ios::out | std::ios::binary);
+            ofs.write(&bytes.front(), size);
+        }
+
+        std::ifstream ifs;
+        ifs.open(truncated.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader plain(ifs);
+
+        std::ifstream cifs;
+        cifs.open(truncated.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader cached = factory.CreateCached(cifs, 1000);
+
+        {
+            liblas::Reader mapped = factory.CreateMapped(truncated);
+
+            liblas::Reader* readers[] = { &plain, &cached, &mapped };
+            for (std::size_t r = 0; r < 3; ++r)
+            {
+                std::vector<boost::uint32_t> ids;
+                ids.push_back(0);
+                ids.push_back(static_cast<boost::uint32_t>(kept - 1));
+
+                liblas::PointBuffer points;
+                ensure("points read", readers[r]->ReadPointsAt(ids, points));
+
+                ids.push_back(static_cast<boost::uint32_t>(kept + 1));
+                ensure_not("points past the end read", readers[r]->ReadPointsAt(ids, points));
+            }
+        }
+
+        std::remove(truncated.c_str());
+    }
+
+    // Test an ExpressionFilter looks its fields up again when the header 
+    // it last saw is changed to another point format
+    template<>
+    template<>
+    void to::test<23>()
+    {
+        liblas::Header header;
+        header.SetDataFormatId(liblas::ePointFormat2);
+
+        liblas::ExpressionFilter filter("red == 100");
+
+        liblas::Point p2(&header);
+        p2.SetColor(liblas::Color(100, 0, 0));
+        ensure("red matched in format 2", filter.filter(p2));
+
+        // Red moves from byte 20 to byte 28, behind the GPS time
+        header.SetDataFormatId(liblas::ePointFormat3);
+
+        liblas::Point p3(&header);
+        p3.SetTime(0.0);
+        p3.SetColor(liblas::Color(100, 0, 0));
+        ensure("red matched in format 3", filter.filter(p3));
+    }
+
+    // Test changing the filters in mid-read filters every point not 
+    // handed out yet with the new filters, and only with those
+    template<>
+    template<>
+    void to::test<24>()
+    {
+        typedef std::vector<boost::uint8_t> record_type;
+        std::vector<record_type> all;
+        {
+            std::ifstream ifs;
+            ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+            liblas::Reader reader(ifs);
+            while (reader.ReadNextPoint())
+            {
+                liblas::PointData const& data = reader.GetPoint().GetData();
+                all.push_back(record_type(data.begin(), data.end()));
+            }
+        }
+        ensure_equals(all.size(), 8u);
+
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader plain(ifs);
+
+        std::ifstream cifs;
+        cifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader cached = factory.CreateCached(cifs, 3);
+        liblas::Reader mapped = factory.CreateMapped(file10_);
+
+        liblas::Reader* readers[] = { &plain, &cached, &mapped };
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            liblas::Reader& reader = *readers[r];
+
+            // Clearing the filters hands out every point after the last 
+            // one read, including those the old filter dropped
+            std::vector<liblas::FilterPtr> thin;
+            thin.push_back(liblas::FilterPtr(new liblas::ThinFilter(1)));
+            reader.SetFilters(thin);
+            ensure(reader.ReadNextPoint());
+            ensure(reader.ReadNextPoint());
+
+            liblas::PointData const& last = reader.GetPoint().GetData();
+            std::size_t next = std::find(all.begin(), all.end(), record_type(last.begin(), last.end())) - all.begin();
+            ensure("last point read found", next < all.size());
+            ++next;
+
+            reader.SetFilters(std::vector<liblas::FilterPtr>());
+            for (; next < all.size(); ++next)
+            {
+                ensure("point missing after clearing the filters", reader.ReadNextPoint());
+                ensure("record differs", std::equal(all[next].begin(), all[next].end(), 
+                                                    reader.GetPoint().GetData().begin()));
+            }
+            ensure_not(reader.ReadNextPoint());
+
+            // Swapping the filters drops the points that only passed the 
+            // old ones
+            reader.Reset();
+            thin[0] = liblas::FilterPtr(new liblas::ThinFilter(1));
+            reader.SetFilters(thin);
+            ensure(reader.ReadNextPoint());
+
+            std::vector<liblas::FilterPtr> none;
+            none.push_back(liblas::FilterPtr(new liblas::ExpressionFilter("intensity < 0")));
+            reader.SetFilters(none);
+            ensure_not("point kept by the old filter", reader.ReadNextPoint());
+        }
+    }
+
+    // Test errors raised while reading ahead reach the caller with the 
+    // type the plain reader throws
+    template<>
+    template<>
+    void to::test<25>()
+    {
+        std::ifstream ifs;
+        ifs.open(file12_.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader prefetched = factory.CreatePrefetched(ifs, 100, 3);
+
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new liblas::ExpressionFilter("no_such_field > 1")));
+        prefetched.SetFilters(filters);
+
+        try
+        {
+            prefetched.ReadNextPoint();
+            fail("invalid_expression not thrown");
+        }
+        catch (liblas::invalid_expression const& e)
+        {
+            ensure(std::string(e.what()).find("no_such_field") != std::string::npos);
+        }
+    }
+}
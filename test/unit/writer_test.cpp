@@ -7,10 +7,16 @@
 //
 
 #include <liblas/liblas.hpp>
+#include <liblas/detail/writer/asyncwriter.hpp>
 #include <tut/tut.hpp>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <bitset>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include "liblas_test.hpp"
 #include "common.hpp"
@@ -38,6 +44,41 @@ namespace tut
         }
     };
 
+    // Writer that fails to write any point
+    class failing_writer : public liblas::WriterI
+    {
+    public:
+        failing_writer(liblas::Header const& header) : m_header(header) {}
+
+        liblas::Header& GetHeader() const { return m_header; }
+        void WriteHeader() {}
+        void SetHeader(liblas::Header const& header) { m_header = header; }
+        void UpdatePointCount(boost::uint32_t) {}
+        void WritePoint(liblas::Point const&) { throw std::runtime_error("disk full"); }
+        void WritePoints(liblas::PointBuffer const&) { throw std::runtime_error("disk full"); }
+        void Flush() {}
+        void SetFilters(std::vector<liblas::FilterPtr> const&) {}
+        void SetTransforms(std::vector<liblas::TransformPtr> const&) {}
+        std::vector<liblas::TransformPtr> GetTransforms() const { return std::vector<liblas::TransformPtr>(); }
+        std::vector<liblas::FilterPtr> GetFilters() const { return std::vector<liblas::FilterPtr>(); }
+
+    private:
+        mutable liblas::Header m_header;
+    };
+
+    // Writes the batches of a ParallelReader to a MappedWriter
+    struct mapped_filler
+    {
+        mapped_filler(liblas::MappedWriter& writer) : m_writer(&writer) {}
+
+        void operator()(std::size_t, std::size_t index, liblas::PointBuffer const& batch) const
+        {
+            m_writer->WritePoints(index, batch);
+        }
+
+        liblas::MappedWriter* m_writer;
+    };
+
     typedef test_group<laswriter_data> tg;
     typedef tg::object to;
 
@@ -353,6 +394,390 @@ namespace tut
         }
     }
 
+    // Test writing a block of records matches writing them one by one
+    template<>
+    template<>
+    void to::test<7>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointBuffer points;
+        reader.ReadNextPoints(points, 100000);
+        liblas::Header const& header = reader.GetHeader();
 
-}
+        std::string const single_file(g_test_data_path + "//tmp-single.las");
+        {
+            std::ofstream single(single_file.c_str(), std::ios::out | std::ios::binary);
+            liblas::Writer writer(single, header);
+            liblas::Point p(&header);
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                points.GetPoint(i, p);
+                writer.WritePoint(p);
+            }
+        }
+
+        {
+            std::ofstream block(tmpfile_.c_str(), std::ios::out | std::ios::binary);
+            liblas::Writer writer(block, header);
+            writer.WritePoints(points);
+
+            // ... also from a table
+            liblas::PointTable table;
+            table.Append(points);
+            writer.WritePoints(table);
+
+            liblas::Header other(header);
+            other.SetDataFormatId(liblas::ePointFormat0 == header.GetDataFormatId() ? 
+                                  liblas::ePointFormat3 : liblas::ePointFormat0);
+            liblas::PointBuffer mismatched(&other, 1);
+            mismatched.resize(1);
+            try
+            {
+                writer.WritePoints(mismatched);
+                fail("std::invalid_argument expected for records of another format");
+            }
+            catch (std::invalid_argument const&)
+            {}
+        }
+
+        std::ifstream a(single_file.c_str(), std::ios::in | std::ios::binary);
+        std::ifstream b(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+        std::string const expected((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+        std::string const written((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+        a.close();
+        std::remove(single_file.c_str());
+
+        b.seekg(0);
+        liblas::Reader written_reader(b);
+        ensure_equals(written_reader.GetHeader().GetPointRecordsCount(), 2 * points.size());
+
+        std::size_t const data = header.GetDataOffset();
+        std::size_t const bytes = points.size() * points.GetRecordLength();
+        ensure("file too short", written.size() >= data + 2 * bytes);
+        ensure("records differ", expected.compare(data, bytes, written, data, bytes) == 0);
+        ensure("table records differ", expected.compare(data, bytes, written, data + bytes, bytes) == 0);
+    }
+
+    // Test writing behind on a background thread
+    template<>
+    template<>
+    void to::test<8>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+
+        liblas::PointBuffer points;
+        reader.ReadNextPoints(points, 100000);
+        liblas::Header const& header = reader.GetHeader();
+
+        std::string const plain_file(g_test_data_path + "//tmp-plain.las");
+        {
+            std::ofstream plain(plain_file.c_str(), std::ios::out | std::ios::binary);
+            liblas::Writer writer(plain, header);
+            writer.WritePoints(points);
+        }
+
+        {
+            // A queue that barely holds one block of 3 points
+            std::ofstream ofs(tmpfile_.c_str(), std::ios::out | std::ios::binary);
+            liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ofs, header);
+            boost::shared_ptr<liblas::detail::AsyncWriterImpl> async(
+                new liblas::detail::AsyncWriterImpl(w, 100, 3));
+            liblas::Writer writer(async);
+            writer.SetHeader(header);
+            writer.WriteHeader();
+
+            liblas::Point p(&header);
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                points.GetPoint(i, p);
+                writer.WritePoint(p);
+            }
+            liblas::PointBuffer rest(&header, 0);
+            rest.resize(points.size() - 4);
+            std::memcpy(rest.GetRecord(0), points.GetRecord(4), rest.size() * rest.GetRecordLength());
+            writer.WritePoints(rest);
+
+            writer.Flush();
+            ensure_equals(async->GetBlockCount(), boost::uint64_t(3));
+        }
+
+        std::ifstream a(plain_file.c_str(), std::ios::in | std::ios::binary);
+        std::ifstream b(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+        std::string const expected((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+        std::string const written((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+        a.close();
+        std::remove(plain_file.c_str());
+        ensure("files differ", expected == written);
+
+        // Errors of the worker come back to the caller
+        boost::shared_ptr<failing_writer> failing(new failing_writer(header));
+        liblas::Writer writer(liblas::WriterFactory::CreateAsync(failing));
+        try
+        {
+            writer.WritePoints(points);
+            writer.Flush();
+            fail("std::runtime_error expected from Flush");
+        }
+        catch (std::runtime_error const& e)
+        {
+            ensure_equals(std::string(e.what()), std::string("disk full"));
+        }
+        try
+        {
+            writer.WritePoints(points);
+            fail("std::runtime_error expected from a later write");
+        }
+        catch (std::runtime_error const&)
+        {}
+    }
+
+    // Test the writer keeps the header bounds and return counts current
+    template<>
+    template<>
+    void to::test<9>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Header const& original = reader.GetHeader();
+
+        liblas::PointBuffer points;
+        reader.ReadNextPoints(points, 100000);
+
+        liblas::Header header(original);
+        header.SetMin(0, 0, 0);
+        header.SetMax(0, 0, 0);
+        for (std::size_t i = 0; i < 5; ++i)
+            header.SetPointRecordsByReturnCount(i, 0);
+
+        {
+            std::ofstream ofs(tmpfile_.c_str(), std::ios::out | std::ios::binary);
+            liblas::Writer writer(ofs, header);
+            liblas::Point p(&header);
+            points.GetPoint(0, p);
+            writer.WritePoint(p);
+            writer.WritePoints(points);
+        }
 
+        std::ifstream written(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader written_reader(written);
+        liblas::Header const& h = written_reader.GetHeader();
+
+        ensure_equals(h.GetPointRecordsCount(), points.size() + 1);
+        ensure_distance(h.GetMinX(), original.GetMinX(), 0.001);
+        ensure_distance(h.GetMinY(), original.GetMinY(), 0.001);
+        ensure_distance(h.GetMinZ(), original.GetMinZ(), 0.001);
+        ensure_distance(h.GetMaxX(), original.GetMaxX(), 0.001);
+        ensure_distance(h.GetMaxY(), original.GetMaxY(), 0.001);
+        ensure_distance(h.GetMaxZ(), original.GetMaxZ(), 0.001);
+
+        liblas::Point p(&h);
+        points.GetPoint(0, p);
+        boost::uint32_t total = 0;
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            boost::uint32_t expected = original.GetPointRecordsByReturnCount()[i];
+            if (p.GetReturnNumber() == i + 1)
+                ++expected;
+            ensure_equals(h.GetPointRecordsByReturnCount()[i], expected);
+            total += h.GetPointRecordsByReturnCount()[i];
+        }
+        ensure_equals(total, points.size() + 1);
+    }
+
+    // Test MappedWriter filled by index from several threads
+    template<>
+    template<>
+    void to::test<10>()
+    {
+        liblas::ParallelReader parallel(file10_, 3);
+        parallel.SetBatchSize(100);
+        liblas::Header const& original = parallel.GetHeader();
+
+        liblas::Header header(original);
+        header.SetMin(0, 0, 0);
+        header.SetMax(0, 0, 0);
+        {
+            liblas::MappedWriter writer(tmpfile_, header, 
+                                        static_cast<boost::uint32_t>(parallel.GetPointCount()));
+            parallel.ForEachBatchAt(mapped_filler(writer));
+
+            liblas::PointBuffer one(&header, 1);
+            one.resize(1);
+            try
+            {
+                writer.WritePoints(writer.GetPointCount(), one);
+                fail("std::out_of_range expected past the last record");
+            }
+            catch (std::out_of_range const&)
+            {}
+
+            writer.Close();
+            ensure_distance(writer.GetHeader().GetMaxX(), original.GetMaxX(), 0.001);
+        }
+
+        std::ifstream expected_ifs(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader expected(expected_ifs);
+        std::ifstream written_ifs(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader written(written_ifs);
+
+        liblas::Header const& h = written.GetHeader();
+        ensure_equals(h.GetPointRecordsCount(), parallel.GetPointCount());
+        ensure_distance(h.GetMinX(), original.GetMinX(), 0.001);
+        ensure_distance(h.GetMinY(), original.GetMinY(), 0.001);
+        ensure_distance(h.GetMaxZ(), original.GetMaxZ(), 0.001);
+        for (std::size_t i = 0; i < 5; ++i)
+            ensure_equals(h.GetPointRecordsByReturnCount()[i], original.GetPointRecordsByReturnCount()[i]);
+
+        liblas::PointBuffer a;
+        liblas::PointBuffer b;
+        ensure_equals(expected.ReadNextPoints(a, 100000), parallel.GetPointCount());
+        ensure_equals(written.ReadNextPoints(b, 100000), parallel.GetPointCount());
+        ensure("records differ", 
+               0 == std::memcmp(a.GetRecord(0), b.GetRecord(0), a.size() * a.GetRecordLength()));
+    }
+
+    // Test SplitWriter spreads blocks over parts of bounded size
+    template<>
+    template<>
+    void to::test<11>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Header const& header = reader.GetHeader();
+
+        liblas::PointBuffer all;
+        reader.ReadNextPoints(all, 100000);
+        reader.Reset();
+
+        std::string const prefix(g_test_data_path + "//tmp-split");
+        boost::uint32_t const part_size = 150;
+        std::size_t parts = 0;
+        {
+            liblas::SplitWriter writer(prefix, ".las", header, part_size);
+            writer.SetOpenParts(2);
+
+            // Blocks that do not line up with the parts
+            liblas::PointBuffer block;
+            while (reader.ReadNextPoints(block, 100) > 0)
+                writer.WritePoints(block);
+            writer.Close();
+            parts = writer.GetPartCount();
+        }
+        ensure_equals(parts, (all.size() + part_size - 1) / part_size);
+
+        std::size_t total = 0;
+        for (std::size_t n = 1; n <= parts; ++n)
+        {
+            std::ostringstream name;
+            name << prefix << "-" << n << ".las";
+
+            {
+                std::ifstream part_ifs(name.str().c_str(), std::ios::in | std::ios::binary);
+                liblas::Reader part(part_ifs);
+
+                liblas::PointBuffer records;
+                std::size_t const count = part.ReadNextPoints(records, 100000);
+                ensure_equals(part.GetHeader().GetPointRecordsCount(), count);
+                ensure("records differ", 0 == std::memcmp(records.GetRecord(0), all.GetRecord(total), 
+                                                          count * records.GetRecordLength()));
+
+                liblas::Point p(&part.GetHeader());
+                double max_x = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    records.GetPoint(i, p);
+                    max_x = (0 == i) ? p.GetX() : (std::max)(max_x, p.GetX());
+                }
+                ensure_distance(part.GetHeader().GetMaxX(), max_x, 0.001);
+                total += count;
+            }
+            std::remove(name.str().c_str());
+        }
+        ensure_equals(total, all.size());
+    }
+
+    // Test appending to a file without rewriting its points
+    template<>
+    template<>
+    void to::test<12>()
+    {
+        std::ifstream ifs;
+        ifs.open(file10_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader reader(ifs);
+        liblas::Header const& header = reader.GetHeader();
+
+        liblas::PointBuffer all;
+        reader.ReadNextPoints(all, 100000);
+        std::size_t const half = all.size() / 2;
+        std::size_t const length = all.GetRecordLength();
+
+        liblas::PointBuffer first(&header, half);
+        first.resize(half);
+        std::memcpy(first.GetRecord(0), all.GetRecord(0), half * length);
+        liblas::PointBuffer second(&header, all.size() - half);
+        second.resize(all.size() - half);
+        std::memcpy(second.GetRecord(0), all.GetRecord(half), second.size() * length);
+
+        {
+            std::ofstream ofs(tmpfile_.c_str(), std::ios::out | std::ios::binary);
+            liblas::Writer writer(ofs, header);
+            writer.WritePoints(first);
+        }
+        {
+            // The remains of an append that did not finish
+            std::ofstream ofs(tmpfile_.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+            ofs.write("partial", 7);
+        }
+
+        // Points of another scale are refused and the file is left alone
+        {
+            liblas::Header other(header);
+            other.SetScale(header.GetScaleX() * 10, header.GetScaleY(), header.GetScaleZ());
+
+            std::fstream fs(tmpfile_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+            try
+            {
+                liblas::WriterFactory::CreateAppend(fs, other);
+                fail("liblas::invalid_format expected for another scale");
+            }
+            catch (liblas::invalid_format const&)
+            {}
+        }
+        {
+            std::ifstream check(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+            liblas::Reader check_reader(check);
+            ensure_equals(check_reader.GetHeader().GetPointRecordsCount(), half);
+        }
+
+        {
+            std::fstream fs(tmpfile_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+            liblas::Writer writer(liblas::WriterFactory::CreateAppend(fs, header));
+            ensure_equals(writer.GetHeader().GetPointRecordsCount(), half);
+            writer.WritePoints(second);
+        }
+
+        std::ifstream written_ifs(tmpfile_.c_str(), std::ios::in | std::ios::binary);
+        liblas::Reader written(written_ifs);
+        liblas::Header const& h = written.GetHeader();
+
+        ensure_equals(h.GetPointRecordsCount(), all.size());
+        ensure_distance(h.GetMinX(), header.GetMinX(), 0.001);
+        ensure_distance(h.GetMaxY(), header.GetMaxY(), 0.001);
+        ensure_distance(h.GetMaxZ(), header.GetMaxZ(), 0.001);
+        for (std::size_t i = 0; i < 5; ++i)
+            ensure_equals(h.GetPointRecordsByReturnCount()[i], header.GetPointRecordsByReturnCount()[i]);
+
+        liblas::PointBuffer records;
+        ensure_equals(written.ReadNextPoints(records, 100000), all.size());
+        ensure("records differ", 
+               0 == std::memcmp(records.GetRecord(0), all.GetRecord(0), all.size() * length));
+    }
+
+}
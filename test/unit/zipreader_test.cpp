@@ -10,6 +10,7 @@
 #include <liblas/liblas.hpp>
 #include <liblas/variablerecord.hpp>
 #include <tut/tut.hpp>
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include "liblas_test.hpp"
@@ -191,6 +192,78 @@ namespace tut
 
         return;
     }
+
+    // Test reading blocks of points (via ReadNextPoints)
+    template<>
+    template<>
+    void to::test<5>()
+    {
+        std::ifstream ifs_las;
+        ifs_las.open(file_las.c_str(), std::ios::in | std::ios::binary);
+        std::ifstream ifs_laz;
+        ifs_laz.open(file_laz.c_str(), std::ios::in | std::ios::binary);
+
+        liblas::ReaderFactory factory;
+        liblas::Reader reader_las = factory.CreateWithStream(ifs_las);
+        liblas::Reader reader_laz = factory.CreateWithStream(ifs_laz);
+
+        liblas::PointBuffer buffer_las;
+        liblas::PointBuffer buffer_laz;
+        liblas::Point p_las;
+        liblas::Point p_laz;
+
+        std::size_t count = 0;
+        while (reader_las.ReadNextPoints(buffer_las, 100))
+        {
+            ensure_equals(reader_laz.ReadNextPoints(buffer_laz, 100), buffer_las.size());
+            for (std::size_t i = 0; i < buffer_las.size(); ++i)
+            {
+                buffer_las.GetPoint(i, p_las);
+                buffer_laz.GetPoint(i, p_laz);
+                ensure_equals(p_las, p_laz);
+            }
+            count += buffer_las.size();
+        }
+        ensure_equals(reader_laz.ReadNextPoints(buffer_laz, 100), 0u);
+        ensure_equals(count, static_cast<std::size_t>(reader_las.GetHeader().GetPointRecordsCount()));
+    }
+
+    // Test decoding chunks on several threads gives the same points
+    template<>
+    template<>
+    void to::test<6>()
+    {
+        std::ifstream ifs_las;
+        ifs_las.open(file_las.c_str(), std::ios::in | std::ios::binary);
+        std::ifstream ifs_laz;
+        ifs_laz.open(file_laz.c_str(), std::ios::in | std::ios::binary);
+
+        liblas::ReaderFactory factory;
+        liblas::Reader reader_las = factory.CreateWithStream(ifs_las);
+        liblas::Reader reader_laz = factory.CreateWithStream(ifs_laz, 4);
+
+        liblas::PointBuffer buffer_las;
+        liblas::PointBuffer buffer_laz;
+        reader_las.ReadNextPoints(buffer_las, 100000);
+        ensure_equals(reader_laz.ReadNextPoints(buffer_laz, 100000), buffer_las.size());
+        ensure("records differ", std::equal(buffer_las.GetRecord(0), 
+                                            buffer_las.GetRecord(0) + buffer_las.size() * buffer_las.GetRecordLength(), 
+                                            buffer_laz.GetRecord(0)));
+
+        // Seeking restarts the decoder in the middle of a chunk
+        std::size_t const n = buffer_las.size() / 2 + 1;
+        reader_laz.Seek(n);
+        ensure("point read", reader_laz.ReadNextPoint());
+        ensure("record differs", std::equal(reader_laz.GetPoint().GetData().begin(), 
+                                            reader_laz.GetPoint().GetData().end(), 
+                                            buffer_las.GetRecord(n)));
+
+        reader_laz.Reset();
+        std::size_t count = 0;
+        while (reader_laz.ReadNextPoint())
+            ++count;
+        ensure_equals(count, buffer_las.size());
+    }
 }
 
 #endif // HAVE_LASZIP
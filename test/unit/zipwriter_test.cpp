@@ -12,7 +12,10 @@
 #include <cstdio>
 #include <bitset>
 #include <fstream>
+#include <iterator>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include "liblas_test.hpp"
 #include "common.hpp"
 
@@ -504,6 +507,189 @@ namespace tut
 
         }
     }
+
+    // Test that compressing on several threads writes the same file
+    template<>
+    template<>
+    void to::test<4>()
+    {
+        std::string const serial(g_test_data_path + "//tmp-serial.laz");
+
+        liblas::Header header;
+        header.SetCompressed(true);
+
+        boost::uint32_t const count = 2500;
+        std::size_t const threads[] = { 1, 4 };
+        std::string const files[] = { serial, file_laz };
+        for (std::size_t t = 0; t < 2; ++t)
+        {
+            std::ofstream ofs;
+            ofs.open(files[t].c_str(), std::ios::out | std::ios::binary);
+
+            liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ofs, header, threads[t]);
+            liblas::Writer writer(w);
+            writer.SetHeader(header);
+            writer.WriteHeader();
+
+            liblas::Point point(&writer.GetHeader());
+            for (boost::uint32_t i = 0; i < count; ++i)
+            {
+                point.SetCoordinates(i, 2.0 * i, 3.0 * i);
+                point.SetIntensity(static_cast<boost::uint16_t>(i));
+                writer.WritePoint(point);
+            }
+        }
+
+        std::ifstream a(serial.c_str(), std::ios::in | std::ios::binary);
+        std::ifstream b(file_laz.c_str(), std::ios::in | std::ios::binary);
+        std::string const bytes_a((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+        std::string const bytes_b((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+        ensure("parallel output differs", bytes_a == bytes_b);
+
+        std::ifstream ifs(file_laz.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader reader = factory.CreateWithStream(ifs);
+        ensure_equals(reader.GetHeader().GetPointRecordsCount(), count);
+
+        boost::uint32_t i = 0;
+        while (reader.ReadNextPoint())
+        {
+            ensure_distance(reader.GetPoint().GetY(), 2.0 * i, 0.1);
+            ensure_equals(reader.GetPoint().GetIntensity(), static_cast<boost::uint16_t>(i));
+            ++i;
+        }
+        ensure_equals(i, count);
+
+        cleanup(serial);
+    }
+
+    // Test that a file written with chunk summaries reads the same 
+    // through filters that skip chunks
+    template<>
+    template<>
+    void to::test<5>()
+    {
+        liblas::Header header;
+        header.SetCompressed(true);
+
+        boost::uint32_t const count = 2500;
+        {
+            std::ofstream ofs;
+            ofs.open(file_laz.c_str(), std::ios::out | std::ios::binary);
+
+            liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ofs, header, 1, true);
+            liblas::Writer writer(w);
+            writer.SetHeader(header);
+            writer.WriteHeader();
+
+            liblas::Point point(&writer.GetHeader());
+            for (boost::uint32_t i = 0; i < count; ++i)
+            {
+                point.SetCoordinates(i, 2.0 * i, 3.0 * i);
+                point.SetClassification(liblas::Classification(i / 1000 + 1));
+                writer.WritePoint(point);
+            }
+        }
+
+        std::vector<liblas::Classification> classes;
+        classes.push_back(liblas::Classification(2));
+
+        std::vector<liblas::FilterPtr> filters;
+        filters.push_back(liblas::FilterPtr(new liblas::BoundsFilter(900, 1800, 1100, 2200)));
+        filters.push_back(liblas::FilterPtr(new liblas::ClassificationFilter(classes)));
+
+        std::ifstream ifs(file_laz.c_str(), std::ios::in | std::ios::binary);
+        liblas::ReaderFactory factory;
+        liblas::Reader reader = factory.CreateWithStream(ifs);
+        reader.SetFilters(filters);
+
+        boost::uint32_t i = 1000;
+        while (reader.ReadNextPoint())
+        {
+            ensure_distance(reader.GetPoint().GetX(), double(i), 0.1);
+            ++i;
+        }
+        ensure_equals(i, boost::uint32_t(1101));
+    }
+
+    // Test that a point shorter than the records of the header is 
+    // rejected instead of being read past its end
+    template<>
+    template<>
+    void to::test<6>()
+    {
+        liblas::Header header;
+        header.SetCompressed(true);
+
+        std::ofstream ofs;
+        ofs.open(file_laz.c_str(), std::ios::out | std::ios::binary);
+
+        liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ofs, header);
+        liblas::Writer writer(w);
+        writer.SetHeader(header);
+        writer.WriteHeader();
+
+        liblas::Point point(&writer.GetHeader());
+        point.SetData(std::vector<boost::uint8_t>(header.GetDataRecordLength() - 1, 0));
+
+        try
+        {
+            writer.WritePoint(point);
+            ensure("std::invalid_argument not thrown", false);
+        }
+        catch (std::invalid_argument const& e)
+        {
+            ensure(e.what(), true);
+        }
+    }
+
+    // Test that a point longer than the records of the header is 
+    // written with its extra bytes left out
+    template<>
+    template<>
+    void to::test<7>()
+    {
+        liblas::Header header;
+        header.SetCompressed(true);
+
+        boost::uint32_t const count = 10;
+        std::size_t const threads[] = { 1, 4 };
+        for (std::size_t t = 0; t < 2; ++t)
+        {
+            {
+                std::ofstream ofs;
+                ofs.open(file_laz.c_str(), std::ios::out | std::ios::binary);
+
+                liblas::WriterIPtr w = liblas::WriterFactory::CreateWithStream(ofs, header, threads[t]);
+                liblas::Writer writer(w);
+                writer.SetHeader(header);
+                writer.WriteHeader();
+
+                liblas::Point point(&writer.GetHeader());
+                for (boost::uint32_t i = 0; i < count; ++i)
+                {
+                    point.SetCoordinates(i, 2.0 * i, 3.0 * i);
+                    std::vector<boost::uint8_t> data(point.GetData().begin(), point.GetData().end());
+                    data.resize(header.GetDataRecordLength() + 4, 0xFF);
+                    point.SetData(data);
+                    writer.WritePoint(point);
+                }
+            }
+
+            std::ifstream ifs(file_laz.c_str(), std::ios::in | std::ios::binary);
+            liblas::ReaderFactory factory;
+            liblas::Reader reader = factory.CreateWithStream(ifs);
+            ensure_equals(reader.GetHeader().GetPointRecordsCount(), count);
+
+            boost::uint32_t i = 0;
+            while (reader.ReadNextPoint())
+            {
+                ensure_distance(reader.GetPoint().GetY(), 2.0 * i, 0.1);
+                ++i;
+            }
+            ensure_equals(i, count);
+        }
+    }
 }
 
 #endif // HAVE_LASZIP